@@ -0,0 +1,842 @@
+/**
+ * ---------------------------------------------------------------
+ * Released under the 2-Clause BSD License 
+ * (a.k.a. Simplified BSD License or FreeBSD License)
+ * @note [link https://opensource.org/license/bsd-2-clause/ BSD-2-Clause]
+ * ---------------------------------------------------------------
+ * 
+ * @copyright (c) 2023 Sebastián AMG (@sebastianamg)
+ * 
+ * Redistribution and use in source and binary forms, with or 
+ * without modification, are permitted provided 
+ * that the following conditions are met:
+ *  1.  Redistributions of source code must retain the above 
+ *      copyright notice, this list of conditions and the 
+ *      following disclaimer.
+ * 
+ *  2.  Redistributions in binary form must reproduce the 
+ *      above copyright notice, this list of conditions and
+ *      the following disclaimer in the documentation and/or 
+ *      other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+ * CONTRIBUTORS “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN 
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+ * THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#pragma once
+
+#include <codecs/gr-codec.hpp>
+#include <codecs/qmx.hpp> // NOTE: QMX requires SSE4.1 (e.g., `-msse4.1`).
+
+namespace samg {
+    namespace grcodec {
+        namespace selector {
+            /**
+             * @brief Codecs a `CodecSelector` chooses from; the choice is recorded in the container header.
+             * 
+             */
+            enum CodecType {
+                RICE_CODEC,         // Rice codes of order k, as written by `rice::writer::OfflineRCodecWriter`.
+                RICE_RUNS_CODEC,    // Rice-runs tokens in Rice codes of order k, as written by `runlength::writer::OfflineRiceRunsWriter`.
+                QMX_CODEC           // SIMD packing of `QMX::Codec`; 32-bit values only.
+            };
+
+            /**
+             * @brief Decode-time model and size/speed trade-off used to rank codecs. Times are in nanoseconds per decoded item; the defaults were measured on x86-64 with -O2, block by block through `ContainerReader::decode_block_at`.
+             * 
+             */
+            struct CostModel {
+                std::double_t   rice_ns_per_value = 1.5,
+                                rice_ns_per_bit = 0.5,
+                                rice_runs_ns_per_token = 8.0, // On top of the Rice cost of the token.
+                                rice_runs_ns_per_value = 1.0,
+                                qmx_ns_per_value = 2.5, // Including the widening to 64 bits and the prefix sum.
+                                bits_per_ns = 1.0; // Bits per value that 1 ns per value of decoding is worth; 0 selects the smallest encoding.
+            };
+
+            /**
+             * @brief Estimated cost of encoding a sequence with a codec and parameter.
+             * 
+             */
+            struct Choice {
+                CodecType codec;
+                std::size_t parameter; // Rice order k; 0 for QMX.
+                std::double_t   bits_per_value,
+                                ns_per_value,
+                                score; // bits_per_value + bits_per_ns * ns_per_value; lower is better.
+            };
+
+            /**
+             * @brief Outcome of simulating the QMX selector: how many 128/256-bit payloads each bit width takes, and the bytes they add up to (keys included).
+             * 
+             */
+            struct QMXEstimate {
+                std::array<std::size_t,33> histogram;
+                std::size_t bytes;
+            };
+
+            /**
+             * @brief Chooses between Rice, Rice-runs and QMX for a sequence of unsigned integers from a sample, without encoding it. Rice is costed with the exact minimum found by `optimal_rice_parameter` over the gaps, Rice-runs with the same on the run tokens, and QMX with a simulation of its selector over the bit widths of the gaps.
+             * @note Non-decreasing sequences (e.g., sorted z-values) are costed as gaps from `base`; any other sequence as-is. Rice-runs takes the values themselves, since it computes its own differences.
+             * 
+             */
+            class CodecSelector {
+                private:
+                    using Rice = samg::grcodec::toolkits::GolombRiceCommon<std::uint64_t>;
+                    using Runs = samg::grcodec::toolkits::RunLengthCommon<std::uint64_t>;
+
+                    static constexpr std::size_t SAMPLE_CHUNKS = 16ZU; // Contiguous chunks a long sequence is sampled from, so that gaps and runs survive sampling.
+
+                    CostModel model;
+                    std::size_t sample_length;
+
+                    struct TokenSink {
+                        std::vector<std::uint64_t>& tokens;
+                        void add( const std::uint64_t t ) {
+                            this->tokens.push_back( t );
+                        }
+                    };
+
+                    Choice _rank_( const CodecType codec, const std::size_t parameter, const std::double_t bits_per_value, const std::double_t ns_per_value ) const {
+                        return Choice{ codec, parameter, bits_per_value, ns_per_value, bits_per_value + this->model.bits_per_ns * ns_per_value };
+                    }
+
+                public:
+                    /**
+                     * @brief Construct a new Codec Selector object
+                     * 
+                     * @param model 
+                     * @param sample_length is the maximum number of values estimates are computed on.
+                     */
+                    CodecSelector( const CostModel model = CostModel(), const std::size_t sample_length = 1ZU << 16 ) :
+                        model ( model ),
+                        sample_length ( std::max( sample_length, CodecSelector::SAMPLE_CHUNKS ) ) {}
+
+                    /**
+                     * @brief Simulates the QMX selector on `n` values: values are grouped in stripes of 4 sharing the largest bit width, and each payload is promoted to the next width until all its stripes fit.
+                     * 
+                     * @param values 
+                     * @param n 
+                     * @return QMXEstimate 
+                     */
+                    static QMXEstimate estimate_qmx( const std::uint32_t* values, const std::size_t n ) {
+                        QMXEstimate ans;
+                        ans.histogram.fill( 0ZU );
+                        ans.bytes = 0ZU;
+                        const std::size_t stripes = ( n + 3ZU ) / 4ZU;
+                        std::vector<std::uint8_t> widths( stripes, 0 );
+                        for( std::size_t i = 0; i < n; ++i ) {
+                            widths[i / 4ZU] = std::max( widths[i / 4ZU], ::QMX::bits_needed_for( values[i] ) );
+                        }
+                        std::size_t i = 0,
+                                    previous = 33ZU,
+                                    run = 0ZU;
+                        while( i < stripes ) {
+                            std::size_t w = widths[i],
+                                        span;
+                            for(;;) {
+                                span = ::QMX::table[w].integers / 4ZU;
+                                const std::size_t last = std::min( i + span, stripes );
+                                const std::size_t largest = *std::max_element( widths.begin() + i, widths.begin() + last );
+                                if( largest <= w ) {
+                                    break;
+                                }
+                                do { ++w; } while( ::QMX::table[w].integers == 0 ); // Next width with a selector.
+                            }
+                            ++(ans.histogram[w]);
+                            ans.bytes += ( w == 0ZU ) ? 0ZU : ( w == 7ZU || w == 9ZU || w == 21ZU ) ? 32ZU : 16ZU;
+                            // One key byte per run of up to 16 payloads of the same width:
+                            if( w != previous || run == 16ZU ) {
+                                ++(ans.bytes);
+                                run = 0ZU;
+                            }
+                            ++run;
+                            previous = w;
+                            i += span;
+                        }
+                        return ans;
+                    }
+
+                    /**
+                     * @brief Estimates every codec on a sample of `values`, which continue a sequence whose last value is `base`.
+                     * 
+                     * @param values 
+                     * @param n 
+                     * @param base is the value preceding `values[0]` (0 at the beginning of a sequence).
+                     * @param is_delta tells whether `values` are costed as gaps (they must be non-decreasing and not lower than `base`).
+                     * @return std::vector<Choice> has one entry per codec; QMX is left out when a gap exceeds 32 bits.
+                     */
+                    std::vector<Choice> estimate( const std::uint64_t* values, const std::size_t n, const std::uint64_t base, const bool is_delta ) const {
+                        std::vector<Choice> ans;
+                        if( n == 0ZU ) {
+                            ans.push_back( this->_rank_( CodecType::RICE_CODEC, 0ZU, 0.0, 0.0 ) );
+                            return ans;
+                        }
+                        // Sample contiguous chunks evenly spread over `values`:
+                        const std::size_t chunks = ( n <= this->sample_length ) ? 1ZU : CodecSelector::SAMPLE_CHUNKS,
+                                          chunk_length = ( chunks == 1ZU ) ? n : this->sample_length / chunks;
+                        std::vector<std::uint64_t> gaps, tokens, shifted;
+                        std::vector<std::uint32_t> narrow_gaps;
+                        bool is_narrow = true;
+                        TokenSink sink { tokens };
+                        for( std::size_t c = 0; c < chunks; ++c ) {
+                            const std::size_t start = ( chunks == 1ZU ) ? 0ZU : c * ( n - chunk_length ) / ( chunks - 1ZU );
+                            const std::uint64_t previous = ( start == 0ZU ) ? base : values[start - 1ZU];
+                            shifted.clear();
+                            for( std::size_t i = start; i < start + chunk_length; ++i ) {
+                                const std::uint64_t g = is_delta ? values[i] - ( ( i == start ) ? previous : values[i - 1ZU] ) : values[i];
+                                gaps.push_back( g );
+                                is_narrow = is_narrow && g <= std::numeric_limits<std::uint32_t>::max();
+                                if( is_narrow ) {
+                                    narrow_gaps.push_back( (std::uint32_t) g );
+                                }
+                                shifted.push_back( values[i] - previous ); // Runs of chunks past the first one start from their predecessor, not from 0.
+                            }
+                            Runs::encode_tokens( sink, shifted.data(), shifted.size() );
+                        }
+                        const std::double_t m = (std::double_t) gaps.size();
+                        // Rice:
+                        const std::pair<std::size_t,std::size_t> rice = Rice::optimal_rice_parameter( gaps.data(), gaps.size() );
+                        const std::double_t rice_bits = rice.second / m;
+                        ans.push_back( this->_rank_( CodecType::RICE_CODEC, rice.first, rice_bits, this->model.rice_ns_per_value + this->model.rice_ns_per_bit * rice_bits ) );
+                        // Rice-runs:
+                        const std::pair<std::size_t,std::size_t> runs = Rice::optimal_rice_parameter( tokens.data(), tokens.size() );
+                        const std::double_t token_count = (std::double_t) tokens.size(),
+                                            runs_ns = token_count * ( this->model.rice_ns_per_value + this->model.rice_runs_ns_per_token ) + this->model.rice_ns_per_bit * runs.second;
+                        ans.push_back( this->_rank_( CodecType::RICE_RUNS_CODEC, runs.first, runs.second / m, runs_ns / m + this->model.rice_runs_ns_per_value ) );
+                        // QMX:
+                        if( is_narrow ) {
+                            const QMXEstimate qmx = CodecSelector::estimate_qmx( narrow_gaps.data(), narrow_gaps.size() );
+                            ans.push_back( this->_rank_( CodecType::QMX_CODEC, 0ZU, ( qmx.bytes * 8.0 ) / m, this->model.qmx_ns_per_value ) );
+                        }
+                        return ans;
+                    }
+
+                    /**
+                     * @brief Estimates every codec on a sample of a whole sequence; it is costed as gaps if it is non-decreasing.
+                     * 
+                     * @param values 
+                     * @param n 
+                     * @return std::vector<Choice> 
+                     */
+                    std::vector<Choice> estimate( const std::uint64_t* values, const std::size_t n ) const {
+                        return this->estimate( values, n, 0ULL, std::is_sorted( values, values + n ) );
+                    }
+
+                    /**
+                     * @brief Returns the estimate with the lowest score.
+                     * 
+                     * @param values 
+                     * @param n 
+                     * @param base 
+                     * @param is_delta 
+                     * @return Choice 
+                     */
+                    Choice select( const std::uint64_t* values, const std::size_t n, const std::uint64_t base, const bool is_delta ) const {
+                        const std::vector<Choice> choices = this->estimate( values, n, base, is_delta );
+                        return *std::min_element( choices.begin(), choices.end(), []( const Choice& a, const Choice& b ) { return a.score < b.score; } );
+                    }
+
+                    Choice select( const std::uint64_t* values, const std::size_t n ) const {
+                        return this->select( values, n, 0ULL, std::is_sorted( values, values + n ) );
+                    }
+
+                    /**
+                     * @brief Selects a codec for the z-values of `reader` from its first `sample_length` entries.
+                     * @note It consumes those entries from `reader`.
+                     * 
+                     * @param reader 
+                     * @return Choice 
+                     */
+                    Choice select( samg::matutx::reader::Reader& reader ) const {
+                        std::vector<std::uint64_t> sample;
+                        sample.reserve( this->sample_length );
+                        while( sample.size() < this->sample_length && reader.has_next() ) {
+                            sample.push_back( reader.next_zvalue() );
+                        }
+                        return this->select( sample.data(), sample.size() );
+                    }
+
+                    /**
+                     * @brief Selects a codec per block of `block_values` values, as `ContainerWriter` does.
+                     * 
+                     * @param values 
+                     * @param n 
+                     * @param block_values 
+                     * @return std::vector<Choice> 
+                     */
+                    std::vector<Choice> select_blocks( const std::uint64_t* values, const std::size_t n, const std::size_t block_values ) const {
+                        if( block_values == 0ZU ) {
+                            throw std::invalid_argument("CodecSelector/select_blocks> block_values must be positive.");
+                        }
+                        std::vector<Choice> ans;
+                        std::uint64_t last = 0ULL;
+                        for( std::size_t start = 0; start < n; start += block_values ) {
+                            const std::size_t length = std::min( block_values, n - start );
+                            const bool is_delta = values[start] >= last && std::is_sorted( values + start, values + start + length );
+                            ans.push_back( this->select( values + start, length, is_delta ? last : 0ULL, is_delta ) );
+                            last = values[start + length - 1ZU];
+                        }
+                        return ans;
+                    }
+
+                    const CostModel& get_cost_model() const {
+                        return this->model;
+                    }
+
+                    const std::size_t get_sample_length() const {
+                        return this->sample_length;
+                    }
+            };
+
+            /**
+             * @brief Header entry of a container block.
+             * 
+             */
+            struct BlockEntry {
+                std::size_t codec, // CodecType.
+                            parameter, // Rice order k; 0 for QMX.
+                            is_delta, // 1 if the block is coded as gaps from `base`.
+                            base, // Last value of the previous block (or 0); Rice-runs blocks also start from it.
+                            byte_offset, // Relative to the first payload.
+                            byte_length;
+            };
+
+            /**
+             * @brief Encodes and decodes the payload of a container block in memory.
+             * 
+             */
+            class BlockCodec {
+                private:
+                    using Rice = samg::grcodec::toolkits::GolombRiceCommon<std::uint64_t>;
+                    using Runs = samg::grcodec::toolkits::RunLengthCommon<std::uint64_t>;
+                    using Writer = samg::grcodec::toolkits::BitWriter<samg::grcodec::toolkits::ByteVectorWriter>;
+                    using Buffer = samg::grcodec::toolkits::BitBuffer<samg::grcodec::toolkits::ByteArrayReader>;
+
+                    static constexpr std::size_t    QMX_OVERRUN = 4096ZU, // Slack for the integers QMX decodes past the end of a block.
+                                                    MAX_QUOTIENT_BITS = 16ZU; // Bound on the unary part of a Rice code; a sample may miss the outliers of a block.
+
+                    /**
+                     * @brief Collects the tokens of `RunLengthCommon::encode_tokens`.
+                     * 
+                     */
+                    struct TokenSink {
+                        std::vector<std::uint64_t>& tokens;
+                        void add( const std::uint64_t t ) {
+                            this->tokens.push_back( t );
+                        }
+                    };
+
+                    /**
+                     * @brief Writes `symbols` in Rice codes of order `k`, raised (and returned) so that no quotient exceeds 2^MAX_QUOTIENT_BITS.
+                     * 
+                     * @param symbols 
+                     * @param k 
+                     * @param bytes 
+                     * @return std::size_t is the order actually used.
+                     */
+                    static std::size_t _put_rice_( const std::vector<std::uint64_t>& symbols, std::size_t k, std::vector<std::uint8_t>& bytes ) {
+                        std::uint64_t max = 0ULL;
+                        for( const std::uint64_t v : symbols ) {
+                            max = std::max( max, v );
+                        }
+                        const std::size_t width = (std::size_t) std::bit_width( max );
+                        if( width > k + BlockCodec::MAX_QUOTIENT_BITS ) {
+                            k = width - BlockCodec::MAX_QUOTIENT_BITS;
+                        }
+                        samg::grcodec::toolkits::ByteVectorWriter sink( bytes );
+                        Writer bits;
+                        bits.reset( &sink );
+                        for( const std::uint64_t v : symbols ) {
+                            bits.put_rice( v, k );
+                        }
+                        bits.flush( sizeof(std::uint64_t) );
+                        return k;
+                    }
+
+                    /**
+                     * @brief Adapts a `BitBuffer` to the `has_more()`/`next()` interface of `RunLengthCommon::decode_tokens`.
+                     * 
+                     */
+                    struct TokenReader {
+                        Buffer& bits;
+                        const std::size_t k,
+                                          bit_limit;
+                        bool has_more() const {
+                            return this->bits.tell() < this->bit_limit;
+                        }
+                        std::uint64_t next() {
+                            return this->bits.template read_rice<std::uint64_t>( this->k );
+                        }
+                    };
+
+                    ::QMX::Codec qmx;
+                    std::vector<std::uint32_t> narrow; // QMX input/output.
+                    std::vector<std::uint64_t>  shifted,
+                                                symbols; // Rice input: gaps, values or Rice-runs tokens.
+                    std::array<std::unique_ptr<samg::grcodec::toolkits::RiceTable<>>, samg::grcodec::toolkits::RiceTable<>::MAX_K + 1ZU> tables; // Built on first use.
+
+                public:
+                    /**
+                     * @brief Appends the payload of `values` coded as `entry` says to `bytes`, padded to 8 bytes, and sets `entry.byte_length` (which excludes the padding).
+                     * @note Rice and Rice-runs raise `entry.parameter` when needed to keep every unary part under 2^MAX_QUOTIENT_BITS bits.
+                     * 
+                     * @param entry 
+                     * @param values 
+                     * @param n 
+                     * @param bytes 
+                     * @return true on success; false if QMX cannot hold the gaps (wider than 32 bits), in which case `bytes` is left untouched.
+                     */
+                    bool encode( BlockEntry& entry, const std::uint64_t* values, const std::size_t n, std::vector<std::uint8_t>& bytes ) {
+                        const std::size_t begin = bytes.size();
+                        switch( entry.codec ) {
+                            case CodecType::RICE_CODEC: {
+                                this->symbols.resize( n );
+                                std::uint64_t previous = entry.base;
+                                for( std::size_t i = 0; i < n; ++i ) {
+                                    this->symbols[i] = entry.is_delta ? values[i] - previous : values[i];
+                                    previous = values[i];
+                                }
+                                entry.parameter = BlockCodec::_put_rice_( this->symbols, entry.parameter, bytes );
+                                break;
+                            }
+                            case CodecType::RICE_RUNS_CODEC: {
+                                this->shifted.resize( n );
+                                for( std::size_t i = 0; i < n; ++i ) {
+                                    this->shifted[i] = values[i] - entry.base;
+                                }
+                                this->symbols.clear();
+                                TokenSink tokens { this->symbols };
+                                Runs::encode_tokens( tokens, this->shifted.data(), n );
+                                entry.parameter = BlockCodec::_put_rice_( this->symbols, entry.parameter, bytes );
+                                break;
+                            }
+                            case CodecType::QMX_CODEC: {
+                                this->narrow.resize( n );
+                                std::uint64_t previous = entry.base;
+                                for( std::size_t i = 0; i < n; ++i ) {
+                                    const std::uint64_t g = entry.is_delta ? values[i] - previous : values[i];
+                                    if( g > std::numeric_limits<std::uint32_t>::max() ) {
+                                        return false;
+                                    }
+                                    this->narrow[i] = (std::uint32_t) g;
+                                    previous = values[i];
+                                }
+                                const std::size_t capacity = n * sizeof(std::uint32_t) + n / 4ZU + BlockCodec::QMX_OVERRUN;
+                                bytes.resize( begin + capacity );
+                                const std::size_t length = ( n == 0ZU ) ? 0ZU : this->qmx.encode( bytes.data() + begin, capacity, this->narrow.data(), n );
+                                if( n > 0ZU && length == 0ZU ) {
+                                    bytes.resize( begin );
+                                    return false;
+                                }
+                                bytes.resize( begin + length );
+                                entry.byte_length = length; // QMX keeps its selectors at the end of the payload, so the padding must not be part of it.
+                                while( bytes.size() % sizeof(std::uint64_t) != 0ZU ) {
+                                    bytes.push_back( 0 );
+                                }
+                                return true;
+                            }
+                            default:
+                                throw std::invalid_argument("BlockCodec/encode> Unknown codec "+std::to_string(entry.codec)+".");
+                        }
+                        entry.byte_length = bytes.size() - begin;
+                        return true;
+                    }
+
+                    /**
+                     * @brief Decodes the `n` values of a block from its payload.
+                     * @note `bytes` must be followed by at least 16 readable bytes (QMX reads past the payload).
+                     * 
+                     * @param entry 
+                     * @param bytes 
+                     * @param out 
+                     * @param n 
+                     */
+                    void decode( const BlockEntry& entry, const std::uint8_t* bytes, std::uint64_t* out, const std::size_t n ) {
+                        switch( entry.codec ) {
+                            case CodecType::RICE_CODEC: {
+                                samg::grcodec::toolkits::ByteArrayReader source( bytes, entry.byte_length );
+                                Buffer bits;
+                                bits.reset( &source, 0ZU );
+                                const samg::grcodec::toolkits::RiceTable<>* table = nullptr;
+                                if( entry.parameter <= samg::grcodec::toolkits::RiceTable<>::MAX_K ) {
+                                    if( !this->tables[entry.parameter] ) {
+                                        this->tables[entry.parameter] = std::make_unique<samg::grcodec::toolkits::RiceTable<>>( entry.parameter );
+                                    }
+                                    table = this->tables[entry.parameter].get();
+                                }
+                                const std::size_t decoded = bits.template read_rice_block<std::uint64_t>( out, n, entry.parameter, entry.byte_length * samg::constants::BITS_PER_BYTE, table );
+                                if( decoded != n ) {
+                                    throw std::runtime_error("BlockCodec/decode> Rice block holds "+std::to_string(decoded)+" of "+std::to_string(n)+" values.");
+                                }
+                                break;
+                            }
+                            case CodecType::RICE_RUNS_CODEC: {
+                                samg::grcodec::toolkits::ByteArrayReader source( bytes, entry.byte_length );
+                                Buffer bits;
+                                bits.reset( &source, 0ZU );
+                                TokenReader tokens { bits, entry.parameter, entry.byte_length * samg::constants::BITS_PER_BYTE };
+                                samg::grcodec::adapter::RingBuffer<std::uint64_t> overflow;
+                                std::uint64_t last = entry.base;
+                                const std::size_t decoded = Runs::decode_tokens( tokens, out, n, last, overflow );
+                                if( decoded != n || !overflow.empty() ) {
+                                    throw std::runtime_error("BlockCodec/decode> Rice-runs block holds "+std::to_string(decoded + overflow.size())+" values instead of "+std::to_string(n)+".");
+                                }
+                                return; // Rice-runs values are absolute already.
+                            }
+                            case CodecType::QMX_CODEC: {
+                                this->narrow.resize( n + BlockCodec::QMX_OVERRUN );
+                                if( n > 0ZU ) {
+                                    this->qmx.full_decode( this->narrow.data(), n, bytes, entry.byte_length );
+                                }
+                                for( std::size_t i = 0; i < n; ++i ) {
+                                    out[i] = this->narrow[i];
+                                }
+                                break;
+                            }
+                            default:
+                                throw std::runtime_error("BlockCodec/decode> Unknown codec "+std::to_string(entry.codec)+".");
+                        }
+                        if( entry.is_delta ) {
+                            std::uint64_t previous = entry.base;
+                            for( std::size_t i = 0; i < n; ++i ) {
+                                previous += out[i];
+                                out[i] = previous;
+                            }
+                        }
+                    }
+            };
+
+            /**
+             * @brief Writes unsigned integers into a container that records, for each block, the codec and parameter chosen by a `CodecSelector`.
+             * @note Layout, in std::size_t words: `MAGIC, VERSION`, the block payloads, each padded to 8 bytes, and a tail with `metadata..., (codec, parameter, is_delta, base, byte_offset, byte_length)` per block, `value_count, block_values, blocks, metadata_count`. `byte_offset` is relative to the first payload; `byte_length` excludes the padding.
+             * @note Blocks are selected, encoded and written as they fill, so that only the current block and the block table stay in memory.
+             * @note With `block_values = 0`, a single codec is selected for the whole file, from its first `FILE_BLOCK_VALUES` values, and the file is written in blocks of that many values coded with it.
+             * 
+             */
+            class ContainerWriter : public samg::grcodec::base::writer::CodecFileWriter<std::uint64_t>, public samg::grcodec::base::MetadataSaver {
+                private:
+                    const CodecSelector selector;
+                    const std::size_t block_values;
+                    const bool is_per_file;
+                    std::vector<std::uint64_t> block;
+                    std::vector<BlockEntry> entries;
+                    std::vector<Choice> choices;
+                    std::vector<std::uint8_t> payload; // Payload of the current block.
+                    BlockCodec codec;
+                    std::unique_ptr<samg::serialization::OfflineWordWriter<std::uint64_t>> serializer;
+                    std::size_t value_count,
+                                payload_bytes; // Bytes written after the header so far.
+                    std::uint64_t last; // Last value of the previous block.
+                    bool is_open;
+
+                    void _flush_block_() {
+                        const std::size_t n = this->block.size();
+                        if( n == 0ZU ) {
+                            return;
+                        }
+                        const bool is_delta = this->block[0] >= this->last && std::is_sorted( this->block.begin(), this->block.end() );
+                        const std::uint64_t base = is_delta ? this->last : 0ULL;
+                        Choice choice = ( this->is_per_file && !this->choices.empty() ) ? this->choices.front() : this->selector.select( this->block.data(), n, base, is_delta );
+                        BlockEntry entry { (std::size_t) choice.codec, choice.parameter, (std::size_t) is_delta, base, this->payload_bytes, 0ZU };
+                        this->payload.clear();
+                        if( !this->codec.encode( entry, this->block.data(), n, this->payload ) ) {
+                            // The sample missed a gap wider than 32 bits; fall back to the best Rice code:
+                            const std::vector<Choice> estimates = this->selector.estimate( this->block.data(), n, base, is_delta );
+                            choice = estimates[0];
+                            entry.codec = (std::size_t) choice.codec;
+                            entry.parameter = choice.parameter;
+                            this->codec.encode( entry, this->block.data(), n, this->payload );
+                        }
+                        LOG("ContainerWriter/_flush_block_> block = %zu; codec = %zu; parameter = %zu; bytes = %zu", this->entries.size(), entry.codec, entry.parameter, entry.byte_length);
+                        if( !this->payload.empty() ) {
+                            this->serializer->add_bytes( this->payload.data(), this->payload.size() );
+                        }
+                        this->payload_bytes += this->payload.size();
+                        this->entries.push_back( entry );
+                        this->choices.push_back( choice );
+                        this->value_count += n;
+                        this->last = this->block.back();
+                        this->block.clear();
+                    }
+
+                public:
+                    static constexpr std::size_t    MAGIC = 0x4c455343474d4153ULL, // "SAMGCSEL"
+                                                    VERSION = 2ZU,
+                                                    ENTRY_LENGTH = 6ZU, // Tail words per block.
+                                                    HEADER_LENGTH = 2ZU, // Words before the first payload.
+                                                    TRAILER_LENGTH = 4ZU, // Words after the block table.
+                                                    FILE_BLOCK_VALUES = 1ZU << 16; // Block length when `block_values = 0`.
+
+                    /**
+                     * @brief Construct a new Container Writer object
+                     * 
+                     * @param file_name 
+                     * @param block_values is the number of values per block; 0 selects a single codec for the whole file.
+                     * @param selector 
+                     */
+                    ContainerWriter( const std::string file_name, const std::size_t block_values = 1ZU << 16, const CodecSelector selector = CodecSelector() ) :
+                        samg::grcodec::base::writer::CodecFileWriter<std::uint64_t>::CodecFileWriter( file_name ),
+                        selector ( selector ),
+                        block_values ( ( block_values == 0ZU ) ? ContainerWriter::FILE_BLOCK_VALUES : block_values ),
+                        is_per_file ( block_values == 0ZU ),
+                        value_count ( 0ZU ),
+                        payload_bytes ( 0ZU ),
+                        last ( 0ULL ),
+                        is_open ( true ) {
+                        this->block.reserve( this->block_values );
+                        this->serializer = std::make_unique<samg::serialization::OfflineWordWriter<std::uint64_t>>( file_name );
+                        this->serializer->template add_value<std::size_t>( ContainerWriter::MAGIC );
+                        this->serializer->template add_value<std::size_t>( ContainerWriter::VERSION );
+                    }
+
+                    const bool add( const std::uint64_t n ) override final {
+                        this->block.push_back( n );
+                        if( this->block.size() == this->block_values ) {
+                            this->_flush_block_();
+                        }
+                        return true; // To fulfill inheritance requirements.
+                    }
+
+                    /**
+                     * @brief Returns the choices made for the blocks flushed so far (all of them after `close()`).
+                     * 
+                     * @return const std::vector<Choice>& 
+                     */
+                    const std::vector<Choice>& get_choices() const {
+                        return this->choices;
+                    }
+
+                    const std::vector<std::size_t> get_metadata() const override {
+                        return this->metadata;
+                    }
+
+                    void close() override {
+                        if( !this->is_open ) {
+                            return;
+                        }
+                        this->_flush_block_();
+                        for( const std::size_t v : this->metadata ) {
+                            this->serializer->template add_value<std::size_t>( v );
+                        }
+                        for( const BlockEntry& e : this->entries ) {
+                            for( const std::size_t v : { e.codec, e.parameter, e.is_delta, e.base, e.byte_offset, e.byte_length } ) {
+                                this->serializer->template add_value<std::size_t>( v );
+                            }
+                        }
+                        this->serializer->template add_value<std::size_t>( this->value_count );
+                        this->serializer->template add_value<std::size_t>( this->block_values );
+                        this->serializer->template add_value<std::size_t>( this->entries.size() );
+                        this->serializer->template add_value<std::size_t>( this->metadata.size() );
+                        this->serializer->close();
+                        this->serializer.reset();
+                        this->payload.clear();
+                        this->payload.shrink_to_fit();
+                        this->is_open = false;
+                    }
+            };
+
+            /**
+             * @brief Reads a container written by `ContainerWriter`, sequentially or one block at a time.
+             * 
+             */
+            class ContainerReader : public samg::grcodec::base::reader::CodecFileReader<std::uint64_t>, public samg::grcodec::base::MetadataSaver {
+                private:
+                    static constexpr std::size_t PADDING_BYTES = 16ZU; // QMX reads past the end of a payload.
+
+                    std::unique_ptr<samg::serialization::OfflineWordReader<std::uint64_t>> serializer;
+                    std::vector<BlockEntry> entries;
+                    std::size_t value_count,
+                                block_values,
+                                payload_offset, // Byte offset of the first payload.
+                                block_counter, // Next block to decode sequentially.
+                                buffer_position;
+                    std::vector<std::uint64_t> buffer;
+                    std::vector<std::uint8_t> bytes;
+                    BlockCodec codec;
+
+                    void _retrieve_header_() {
+                        constexpr std::size_t WORD_BYTES = sizeof(std::size_t),
+                                              FIXED_WORDS = ContainerWriter::HEADER_LENGTH + ContainerWriter::TRAILER_LENGTH;
+                        const std::size_t nbytes = this->serializer->size();
+                        if( nbytes % WORD_BYTES != 0ZU || nbytes < FIXED_WORDS * WORD_BYTES ) {
+                            throw std::runtime_error("ContainerReader> "+this->get_file_name()+" is truncated ("+std::to_string(nbytes)+" bytes).");
+                        }
+                        this->serializer->seek( 0, std::ios::beg );
+                        if( this->serializer->template next<std::size_t>() != ContainerWriter::MAGIC ) {
+                            throw std::runtime_error("ContainerReader> "+this->get_file_name()+" is not a codec container.");
+                        }
+                        const std::size_t version = this->serializer->template next<std::size_t>();
+                        if( version != ContainerWriter::VERSION ) {
+                            throw std::runtime_error("ContainerReader> Unsupported container version "+std::to_string(version)+".");
+                        }
+                        this->serializer->seek( nbytes - ContainerWriter::TRAILER_LENGTH * WORD_BYTES, std::ios::beg );
+                        this->value_count = this->serializer->template next<std::size_t>();
+                        this->block_values = this->serializer->template next<std::size_t>();
+                        const std::size_t blocks = this->serializer->template next<std::size_t>(),
+                                          metadata_count = this->serializer->template next<std::size_t>();
+                        // Every count is checked against the words left, so that none of the sizes below can overflow:
+                        const std::size_t available = nbytes / WORD_BYTES - FIXED_WORDS;
+                        if( blocks > available / ContainerWriter::ENTRY_LENGTH || metadata_count > available - blocks * ContainerWriter::ENTRY_LENGTH ) {
+                            throw std::runtime_error("ContainerReader> "+this->get_file_name()+" has a block table larger than the file.");
+                        }
+                        const std::size_t expected_blocks = ( this->value_count == 0ZU || this->block_values == 0ZU ) ? 0ZU : ( this->value_count - 1ZU ) / this->block_values + 1ZU;
+                        if( blocks != expected_blocks || ( this->value_count > 0ZU && this->block_values == 0ZU ) ) {
+                            throw std::runtime_error("ContainerReader> "+this->get_file_name()+" holds "+std::to_string(blocks)+" blocks instead of "+std::to_string(expected_blocks)+".");
+                        }
+                        const std::size_t payload_bytes = ( available - blocks * ContainerWriter::ENTRY_LENGTH - metadata_count ) * WORD_BYTES;
+                        this->serializer->seek( ( ContainerWriter::HEADER_LENGTH * WORD_BYTES ) + payload_bytes, std::ios::beg );
+                        this->metadata.clear();
+                        for( std::size_t i = 0; i < metadata_count; ++i ) {
+                            this->add_metadata( this->serializer->template next<std::size_t>() );
+                        }
+                        this->entries.resize( blocks );
+                        for( BlockEntry& e : this->entries ) {
+                            e.codec = this->serializer->template next<std::size_t>();
+                            e.parameter = this->serializer->template next<std::size_t>();
+                            e.is_delta = this->serializer->template next<std::size_t>();
+                            e.base = this->serializer->template next<std::size_t>();
+                            e.byte_offset = this->serializer->template next<std::size_t>();
+                            e.byte_length = this->serializer->template next<std::size_t>();
+                            if( e.byte_offset > payload_bytes || e.byte_length > payload_bytes - e.byte_offset ) {
+                                throw std::runtime_error("ContainerReader> "+this->get_file_name()+" has a block past the end of its payloads.");
+                            }
+                        }
+                        this->payload_offset = ContainerWriter::HEADER_LENGTH * WORD_BYTES;
+                    }
+
+                public:
+                    ContainerReader( const std::string file_name ) :
+                        samg::grcodec::base::reader::CodecFileReader<std::uint64_t>::CodecFileReader( file_name ) {
+                        this->serializer = std::make_unique<samg::serialization::OfflineWordReader<std::uint64_t>>( file_name );
+                        this->_retrieve_header_();
+                        this->restart();
+                    }
+
+                    const std::size_t get_value_count() const {
+                        return this->value_count;
+                    }
+
+                    const std::size_t get_block_values() const {
+                        return this->block_values;
+                    }
+
+                    const std::size_t get_number_of_blocks() const {
+                        return this->entries.size();
+                    }
+
+                    /**
+                     * @brief Returns the number of values in block `i`.
+                     * 
+                     * @param i 
+                     * @return const std::size_t 
+                     */
+                    const std::size_t get_block_length( const std::size_t i ) const {
+                        return std::min( this->block_values, this->value_count - i * this->block_values );
+                    }
+
+                    /**
+                     * @brief Returns the header entry of block `i`, i.e., the codec and parameter it was encoded with.
+                     * 
+                     * @param i 
+                     * @return const BlockEntry& 
+                     */
+                    const BlockEntry& get_block_entry( const std::size_t i ) const {
+                        return this->entries.at( i );
+                    }
+
+                    /**
+                     * @brief Decodes block `i` into `out`, which must hold `get_block_length(i)` values.
+                     * 
+                     * @param i 
+                     * @param out 
+                     * @return std::size_t is the number of decoded values.
+                     */
+                    std::size_t decode_block_at( const std::size_t i, std::uint64_t* out ) {
+                        const BlockEntry& entry = this->entries.at( i );
+                        const std::size_t n = this->get_block_length( i );
+                        this->bytes.resize( entry.byte_length + ContainerReader::PADDING_BYTES );
+                        std::fill( this->bytes.end() - ContainerReader::PADDING_BYTES, this->bytes.end(), 0 );
+                        this->serializer->seek( this->payload_offset + entry.byte_offset, std::ios::beg );
+                        if( this->serializer->read_bytes( this->bytes.data(), entry.byte_length ) != entry.byte_length ) {
+                            throw std::runtime_error("ContainerReader/decode_block_at> Truncated block "+std::to_string(i)+".");
+                        }
+                        this->codec.decode( entry, this->bytes.data(), out, n );
+                        return n;
+                    }
+
+                    /**
+                     * @brief Decodes the whole container.
+                     * 
+                     * @return std::vector<std::uint64_t> 
+                     */
+                    std::vector<std::uint64_t> decode_all() {
+                        std::vector<std::uint64_t> ans( this->value_count );
+                        for( std::size_t i = 0; i < this->entries.size(); ++i ) {
+                            this->decode_block_at( i, ans.data() + i * this->block_values );
+                        }
+                        return ans;
+                    }
+
+                    const std::uint64_t next() override final {
+                        if( this->buffer_position == this->buffer.size() ) {
+                            if( this->block_counter == this->entries.size() ) {
+                                throw std::runtime_error("ContainerReader/next> No more values.");
+                            }
+                            this->buffer.resize( this->get_block_length( this->block_counter ) );
+                            this->decode_block_at( this->block_counter++, this->buffer.data() );
+                            this->buffer_position = 0ZU;
+                        }
+                        return this->buffer[ this->buffer_position++ ];
+                    }
+
+                    const bool has_more() const override final {
+                        return this->buffer_position < this->buffer.size() || this->block_counter < this->entries.size();
+                    }
+
+                    std::size_t decode_block( std::uint64_t* out, const std::size_t n ) override {
+                        std::size_t i = 0;
+                        while( i < n && this->has_more() ) {
+                            if( this->buffer_position == this->buffer.size() ) {
+                                this->buffer.resize( this->get_block_length( this->block_counter ) );
+                                this->decode_block_at( this->block_counter++, this->buffer.data() );
+                                this->buffer_position = 0ZU;
+                            }
+                            const std::size_t m = std::min( n - i, this->buffer.size() - this->buffer_position );
+                            std::copy( this->buffer.begin() + this->buffer_position, this->buffer.begin() + this->buffer_position + m, out + i );
+                            this->buffer_position += m;
+                            i += m;
+                        }
+                        return i;
+                    }
+
+                    void restart() override {
+                        this->block_counter = 0ZU;
+                        this->buffer_position = 0ZU;
+                        this->buffer.clear();
+                    }
+
+                    const std::vector<std::size_t> get_metadata() const override {
+                        return this->metadata;
+                    }
+
+                    void close() override {
+                        if( this->serializer ) {
+                            this->serializer->close();
+                            this->serializer.reset();
+                        }
+                    }
+            };
+        }
+    }
+}
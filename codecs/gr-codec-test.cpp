@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
 #include <codecs/gr-codec.hpp>
+#include <codecs/codec-selector.hpp>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
 #include <random>
 
-// To compile: g++-11 -ggdb -g3 -Wno-register -I ~/include/ -L ~/lib/ gr-codec-test.cpp -o gr-codec-test -lsdsl -lgtest
+// To compile: g++-11 -std=c++2b -ggdb -g3 -msse4.1 -Wno-register -I ~/include/ -I .. -L ~/lib/ gr-codec-test.cpp -o gr-codec-test -lsdsl -lgtest -pthread
 namespace grcodec {
     namespace test {
 
@@ -12,7 +16,8 @@ namespace grcodec {
                 static const std::size_t    N_ENTRIES = 110,
                                             DIMENSIONS = 3;
                 using Word = std::uint32_t;
-                using Length = std::uint64_t;
+                using Writer = samg::grcodec::runlength::writer::OfflineRiceRunsWriter<Word>;
+                using Reader = samg::grcodec::runlength::reader::OfflineRiceRunsReader<Word>;
 
                 std::array<std::queue<Word>,DIMENSIONS> s1,s2,s3;
 
@@ -53,6 +58,26 @@ namespace grcodec {
                     // }
                 }
                 void TearDown() override {}
+                static std::string temp_file( const std::string name ) {
+                    return ( std::filesystem::temp_directory_path() / ( "gr-codec-test-" + name + ".rrn" ) ).string();
+                }
+                static void encode( std::queue<Word> s, const std::size_t k, const std::string file_name ) {
+                    Writer writer( std::make_shared<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>>( file_name, k ) );
+                    while( !s.empty() ) {
+                        writer.add( s.front() );
+                        s.pop();
+                    }
+                    writer.close();
+                }
+                static std::queue<Word> decode( const std::string file_name ) {
+                    std::queue<Word> ans;
+                    Reader reader( std::make_shared<samg::grcodec::rice::reader::OfflineRCodecReader<Word>>( file_name ) );
+                    while( reader.has_more() ) {
+                        ans.push( reader.next() );
+                    }
+                    reader.close();
+                    return ans;
+                }
                 static bool are_equal( std::queue<Word> &v1, std::queue<Word> &v2 ) {
                     bool ans = v1.size() == v2.size();
                     while( ans && !v1.empty() && !v2.empty() ) {
@@ -68,24 +93,27 @@ namespace grcodec {
         // k = 2
         TEST_F(N3SequencesDataSet,Asc_k2) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RCodec<Word,Length>::BinarySequence bv = samg::grcodec::RiceRuns<Word>::encode(s1[i],K[0]);
-                std::queue<Word> ans = samg::grcodec::RiceRuns<Word>::decode(bv);
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s1[i], K[0], file_name );
+                std::queue<Word> ans = decode( file_name );
                 EXPECT_TRUE(are_equal(ans,s1[i]));
             }
         }
 
         TEST_F(N3SequencesDataSet,Desc_k2) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RCodec<Word,Length>::BinarySequence bv = samg::grcodec::RiceRuns<Word>::encode(s2[i],K[0]);
-                std::queue<Word> ans = samg::grcodec::RiceRuns<Word>::decode(bv);;
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s2[i], K[0], file_name );
+                std::queue<Word> ans = decode( file_name );
                 EXPECT_TRUE(are_equal(ans,s2[i]));
             }
         }
 
         TEST_F(N3SequencesDataSet,Rand_k2) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RCodec<Word,Length>::BinarySequence bv = samg::grcodec::RiceRuns<Word>::encode(s3[i],K[0]);
-                std::queue<Word> ans = samg::grcodec::RiceRuns<Word>::decode(bv);;
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s3[i], K[0], file_name );
+                std::queue<Word> ans = decode( file_name );
                 EXPECT_TRUE(are_equal(ans,s3[i]));
             }
         }
@@ -94,24 +122,27 @@ namespace grcodec {
         // k = 3
         TEST_F(N3SequencesDataSet,Asc_k3) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RCodec<Word,Length>::BinarySequence bv = samg::grcodec::RiceRuns<Word>::encode(s1[i],K[1]);
-                std::queue<Word> ans = samg::grcodec::RiceRuns<Word>::decode(bv);;
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s1[i], K[1], file_name );
+                std::queue<Word> ans = decode( file_name );
                 EXPECT_TRUE(are_equal(ans,s1[i]));
             }
         }
 
         TEST_F(N3SequencesDataSet,Desc_k3) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RCodec<Word,Length>::BinarySequence bv = samg::grcodec::RiceRuns<Word>::encode(s2[i],K[1]);
-                std::queue<Word> ans = samg::grcodec::RiceRuns<Word>::decode(bv);;
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s2[i], K[1], file_name );
+                std::queue<Word> ans = decode( file_name );
                 EXPECT_TRUE(are_equal(ans,s2[i]));
             }
         }
 
         TEST_F(N3SequencesDataSet,Rand_k3) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RCodec<Word,Length>::BinarySequence bv = samg::grcodec::RiceRuns<Word>::encode(s3[i],K[1]);
-                std::queue<Word> ans = samg::grcodec::RiceRuns<Word>::decode(bv);;
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s3[i], K[1], file_name );
+                std::queue<Word> ans = decode( file_name );
                 EXPECT_TRUE(are_equal(ans,s3[i]));
             }
         }
@@ -120,24 +151,27 @@ namespace grcodec {
         // k = 4
         TEST_F(N3SequencesDataSet,Asc_k4) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RCodec<Word,Length>::BinarySequence bv = samg::grcodec::RiceRuns<Word>::encode(s1[i],K[2]);
-                std::queue<Word> ans = samg::grcodec::RiceRuns<Word>::decode(bv);;
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s1[i], K[2], file_name );
+                std::queue<Word> ans = decode( file_name );
                 EXPECT_TRUE(are_equal(ans,s1[i]));
             }
         }
 
         TEST_F(N3SequencesDataSet,Desc_k4) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RCodec<Word,Length>::BinarySequence bv = samg::grcodec::RiceRuns<Word>::encode(s2[i],K[2]);
-                std::queue<Word> ans = samg::grcodec::RiceRuns<Word>::decode(bv);;
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s2[i], K[2], file_name );
+                std::queue<Word> ans = decode( file_name );
                 EXPECT_TRUE(are_equal(ans,s2[i]));
             }
         }
 
         TEST_F(N3SequencesDataSet,Rand_k4) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RCodec<Word,Length>::BinarySequence bv = samg::grcodec::RiceRuns<Word>::encode(s3[i],K[2]);
-                std::queue<Word> ans = samg::grcodec::RiceRuns<Word>::decode(bv);;
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s3[i], K[2], file_name );
+                std::queue<Word> ans = decode( file_name );
                 EXPECT_TRUE(are_equal(ans,s3[i]));
             }
         }
@@ -146,24 +180,27 @@ namespace grcodec {
         // k = 5
         TEST_F(N3SequencesDataSet,Asc_k5) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RCodec<Word,Length>::BinarySequence bv = samg::grcodec::RiceRuns<Word>::encode(s1[i],K[3]);
-                std::queue<Word> ans = samg::grcodec::RiceRuns<Word>::decode(bv);;
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s1[i], K[3], file_name );
+                std::queue<Word> ans = decode( file_name );
                 EXPECT_TRUE(are_equal(ans,s1[i]));
             }
         }
 
         TEST_F(N3SequencesDataSet,Desc_k5) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RCodec<Word,Length>::BinarySequence bv = samg::grcodec::RiceRuns<Word>::encode(s2[i],K[3]);
-                std::queue<Word> ans = samg::grcodec::RiceRuns<Word>::decode(bv);;
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s2[i], K[3], file_name );
+                std::queue<Word> ans = decode( file_name );
                 EXPECT_TRUE(are_equal(ans,s2[i]));
             }
         }
 
         TEST_F(N3SequencesDataSet,Rand_k5) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RCodec<Word,Length>::BinarySequence bv = samg::grcodec::RiceRuns<Word>::encode(s3[i],K[3]);
-                std::queue<Word> ans = samg::grcodec::RiceRuns<Word>::decode(bv);;
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s3[i], K[3], file_name );
+                std::queue<Word> ans = decode( file_name );
                 EXPECT_TRUE(are_equal(ans,s3[i]));
             }
         }
@@ -171,9 +208,9 @@ namespace grcodec {
         // k = 3 with `next` function:
         TEST_F(N3SequencesDataSet,Asc_k3_wnext) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RiceRuns<Word> codec(
-                    samg::grcodec::RiceRuns<Word>::encode(s1[i],K[1])
-                );
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s1[i], K[1], file_name );
+                Reader codec( std::make_shared<samg::grcodec::rice::reader::OfflineRCodecReader<Word>>( file_name ) );
                 while( !s1[i].empty() && codec.has_more() ) {
                     // std::cout << "1";
                     EXPECT_EQ(s1[i].front(), codec.next());
@@ -185,9 +222,9 @@ namespace grcodec {
 
         TEST_F(N3SequencesDataSet,Desc_k3_wnext) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RiceRuns<Word> codec(
-                    samg::grcodec::RiceRuns<Word>::encode(s2[i],K[1])
-                );
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s2[i], K[1], file_name );
+                Reader codec( std::make_shared<samg::grcodec::rice::reader::OfflineRCodecReader<Word>>( file_name ) );
                 while( !s2[i].empty() && codec.has_more() ) {
                     // std::cout << "2";
                     EXPECT_EQ(s2[i].front(), codec.next());
@@ -199,9 +236,9 @@ namespace grcodec {
 
         TEST_F(N3SequencesDataSet,Rand_k3_wnext) {
             for (std::size_t i = 0; i < DIMENSIONS; ++i) {
-                samg::grcodec::RiceRuns<Word> codec(
-                    samg::grcodec::RiceRuns<Word>::encode(s3[i],K[1])
-                );
+                const std::string file_name = temp_file( ::testing::UnitTest::GetInstance()->current_test_info()->name() );
+                encode( s3[i], K[1], file_name );
+                Reader codec( std::make_shared<samg::grcodec::rice::reader::OfflineRCodecReader<Word>>( file_name ) );
                 while( !s3[i].empty() && codec.has_more() ) {
                     // std::cout << "3";
                     EXPECT_EQ(s3[i].front(), codec.next());
@@ -211,6 +248,1263 @@ namespace grcodec {
             }
         }
 
+        static std::string temp_file( const std::string name ) {
+            return ( std::filesystem::temp_directory_path() / ( "gr-codec-test-" + name + ".bin" ) ).string();
+        }
+
+        template<typename Writer, typename Word, typename... Args> void write_values( const std::string file_name, const std::vector<Word>& values, Args... args ) {
+            Writer writer( file_name, args... );
+            for( const Word v : values ) {
+                writer.add( v );
+            }
+            writer.close();
+        }
+
+        template<typename Reader> auto read_values( Reader& reader ) {
+            std::vector<std::remove_cv_t<decltype( reader.next() )>> ans;
+            while( reader.has_more() ) {
+                ans.push_back( reader.next() );
+            }
+            return ans;
+        }
+
+        /**
+         * @brief Values whose differences span more than half of the Word range, i.e., those that overflow a signed 64-bit difference.
+         * 
+         * @tparam Word 
+         * @return std::vector<Word> 
+         */
+        template<typename Word> std::vector<Word> wide_sequence() {
+            constexpr Word MAX = std::numeric_limits<Word>::max(),
+                           HALF = (Word) ( MAX / 2 + 1 );
+            std::vector<Word> ans = { MAX, 0, MAX - 1, HALF, HALF - 1, 2, MAX, MAX, MAX, MAX, 5, (Word) ( HALF + 5 ), 5, (Word) ( HALF + 5 ), HALF, 0, HALF };
+            Word x = 0;
+            for( std::size_t i = 0; i < 10; ++i ) { // Runs of a constant difference of 2^(W-1) + 7, and of its opposite.
+                ans.push_back( x += (Word) ( HALF + 7 ) );
+            }
+            for( std::size_t i = 0; i < 10; ++i ) {
+                ans.push_back( x -= (Word) ( HALF + 7 ) );
+            }
+            std::mt19937_64 gen( 7 );
+            for( std::size_t i = 0; i < 1000; ++i ) {
+                ans.push_back( (Word) ( gen() | ( ( i & 1ZU ) ? HALF : 0 ) ) );
+            }
+            return ans;
+        }
+
+        template<typename Word> void expect_wide_round_trip() {
+            const std::vector<Word> values = wide_sequence<Word>();
+            const std::string file_name = ( std::filesystem::temp_directory_path() / "gr-codec-test-wide.rrn" ).string();
+            {
+                samg::grcodec::runlength::writer::OfflineRiceRunsWriter<Word> writer( std::make_shared<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>>( file_name, 8ZU * sizeof(Word) - 4ZU ) ); // Keeps the unary quotients short.
+                for( const Word v : values ) {
+                    writer.add( v );
+                }
+                writer.close();
+            }
+            {
+                samg::grcodec::runlength::reader::OfflineRiceRunsReader<Word> reader( std::make_shared<samg::grcodec::rice::reader::OfflineRCodecReader<Word>>( file_name ) );
+                std::vector<Word> ans;
+                while( reader.has_more() ) {
+                    ans.push_back( reader.next() );
+                }
+                EXPECT_EQ( ans, values );
+                reader.restart();
+                std::vector<Word> block( values.size() + 1 );
+                EXPECT_EQ( reader.decode_block( block.data(), block.size() ), values.size() );
+                block.pop_back();
+                EXPECT_EQ( block, values );
+                reader.close();
+            }
+            {
+                samg::grcodec::runlength::reader::OnlineRiceRunsReader<Word> reader( std::make_shared<samg::grcodec::rice::reader::OnlineRCodecReader<Word>>( file_name ) );
+                std::vector<Word> ans;
+                while( reader.has_more() ) {
+                    ans.push_back( reader.next() );
+                }
+                EXPECT_EQ( ans, values );
+                reader.close();
+            }
+            // Blocked writer, which relativizes values through `RunLengthCommon::encode_tokens`:
+            {
+                samg::grcodec::runlength::writer::OfflineBlockedRiceRunsWriter<Word> writer( file_name, 64, 2 );
+                for( const Word v : values ) {
+                    writer.add( v );
+                }
+                writer.close();
+            }
+            samg::grcodec::runlength::reader::OfflineBlockedRiceRunsReader<Word> reader( file_name );
+            EXPECT_EQ( reader.decode_all( 2 ), values );
+            std::vector<Word> ans;
+            while( reader.has_more() ) {
+                ans.push_back( reader.next() );
+            }
+            EXPECT_EQ( ans, values );
+            reader.close();
+            std::filesystem::remove( file_name );
+        }
+
+        TEST(RiceRunsWideDifferences,Word64) {
+            expect_wide_round_trip<std::uint64_t>();
+        }
+
+        TEST(RiceRunsWideDifferences,Word32) {
+            expect_wide_round_trip<std::uint32_t>();
+        }
+
+        TEST(RiceRunsWideDifferences,Word16) {
+            expect_wide_round_trip<std::uint16_t>();
+        }
+
+        TEST(BlockedRiceRuns,ManyBatchesShareThePool) {
+            using Word = std::uint32_t;
+            const std::string file_name = ( std::filesystem::temp_directory_path() / "gr-codec-test-blocked.rrn" ).string();
+            std::mt19937_64 gen( 11 );
+            std::vector<Word> values;
+            Word x = 0;
+            for( std::size_t i = 0; i < 50000; ++i ) { // 50000 / (97 * 3) batches, the last one partial.
+                values.push_back( x += (Word) ( gen() % 4 == 0 ? gen() % 1000 : 1 ) );
+            }
+            {
+                samg::grcodec::runlength::writer::OfflineBlockedRiceRunsWriter<Word> writer( file_name, 97, 3 );
+                for( const Word v : values ) {
+                    writer.add( v );
+                }
+                writer.close();
+            }
+            samg::grcodec::runlength::reader::OfflineBlockedRiceRunsReader<Word> reader( file_name );
+            EXPECT_EQ( reader.get_number_of_blocks(), ( values.size() + 96 ) / 97 );
+            EXPECT_EQ( reader.decode_all( 3 ), values );
+            reader.close();
+            std::filesystem::remove( file_name );
+        }
+
+        template<typename Reader> class RiceSkipIndex : public ::testing::Test {
+            protected:
+                using Word = std::uint32_t;
+                static constexpr std::size_t N = 5000,
+                                             SAMPLE_RATE = 64;
+
+                std::vector<Word> values;
+                std::vector<std::size_t> sums; // sums[i] is the sum of values[0..i].
+                std::string file_name;
+
+                void SetUp() override {
+                    std::mt19937_64 gen( 3 );
+                    std::geometric_distribution<Word> dist( 0.05 );
+                    std::size_t sum = 0;
+                    for( std::size_t i = 0; i < N; ++i ) {
+                        this->values.push_back( dist( gen ) );
+                        this->sums.push_back( sum += this->values.back() );
+                    }
+                    this->file_name = ( std::filesystem::temp_directory_path() / "gr-codec-test-skip.rrn" ).string();
+                    samg::grcodec::rice::writer::OfflineRCodecWriter<Word> writer( this->file_name, 4, SAMPLE_RATE );
+                    writer.add_metadata( 77 );
+                    for( const Word v : this->values ) {
+                        writer.add( v );
+                    }
+                    writer.close();
+                }
+                void TearDown() override {
+                    std::filesystem::remove( this->file_name );
+                }
+        };
+
+        using RiceReaders = ::testing::Types<samg::grcodec::rice::reader::OfflineRCodecReader<std::uint32_t>, samg::grcodec::rice::reader::OnlineRCodecReader<std::uint32_t>>;
+        TYPED_TEST_SUITE(RiceSkipIndex, RiceReaders);
+
+        TYPED_TEST(RiceSkipIndex,SeekToValue) {
+            TypeParam reader( this->file_name );
+            EXPECT_EQ( reader.get_metadata(), std::vector<std::size_t>( { 77 } ) );
+            EXPECT_EQ( reader.get_skip_index().size(), ( this->N - 1 ) / this->SAMPLE_RATE );
+            for( const std::size_t i : { 4000ZU, 0ZU, 63ZU, 64ZU, 65ZU, 2500ZU, 2499ZU, this->N - 1ZU } ) { // Backwards and forwards, on and around samples.
+                reader.seek_to_value( i );
+                EXPECT_EQ( reader.get_value_counter(), i );
+                EXPECT_EQ( reader.get_running_sum(), ( i == 0ZU ) ? 0ZU : this->sums[i - 1] );
+                ASSERT_TRUE( reader.has_more() );
+                EXPECT_EQ( reader.next(), this->values[i] );
+            }
+            // At and past the end:
+            reader.seek_to_value( this->N );
+            EXPECT_EQ( reader.get_value_counter(), this->N );
+            EXPECT_FALSE( reader.has_more() );
+            reader.seek_to_value( this->N + 10ZU );
+            EXPECT_EQ( reader.get_value_counter(), this->N );
+            EXPECT_EQ( reader.get_running_sum(), this->sums.back() );
+            EXPECT_FALSE( reader.has_more() );
+            reader.seek_to_value( 10ZU ); // Back from the end.
+            EXPECT_EQ( reader.next(), this->values[10] );
+            reader.close();
+        }
+
+        TYPED_TEST(RiceSkipIndex,NextGeq) {
+            TypeParam reader( this->file_name );
+            for( std::size_t x = 0; x <= this->sums.back(); x += 97ZU ) {
+                const std::size_t expected = *std::lower_bound( this->sums.begin(), this->sums.end(), x );
+                EXPECT_EQ( reader.next_geq( x ), expected );
+                EXPECT_EQ( reader.next_geq( x ), expected ); // Already reached: no decoding.
+            }
+            EXPECT_EQ( reader.next_geq( this->sums.back() ), this->sums.back() ); // The last absolute value.
+            reader.restart();
+            EXPECT_EQ( reader.next_geq( this->sums.back() ), this->sums.back() ); // Through the skip index from the start.
+            EXPECT_EQ( reader.get_value_counter(), (std::size_t) ( std::lower_bound( this->sums.begin(), this->sums.end(), this->sums.back() ) - this->sums.begin() ) + 1ZU );
+            EXPECT_EQ( reader.next_geq( this->sums.back() + 1ZU ), std::numeric_limits<std::size_t>::max() ); // Past the end.
+            EXPECT_FALSE( reader.has_more() );
+            reader.restart();
+            EXPECT_EQ( reader.next_geq( this->sums.back() + 1000ZU ), std::numeric_limits<std::size_t>::max() );
+            reader.close();
+        }
+
+        TYPED_TEST(RiceSkipIndex,ShortSequences) {
+            const std::string file_name = temp_file( "skip-short" );
+            for( const std::size_t sample_rate : { 0ZU, 1ZU, 64ZU } ) { // Without index, sampling every value, and with fewer values than the rate.
+                write_values<samg::grcodec::rice::writer::OfflineRCodecWriter<std::uint32_t>>( file_name, std::vector<std::uint32_t>(), 2ZU, sample_rate );
+                {
+                    TypeParam reader( file_name );
+                    EXPECT_TRUE( reader.get_skip_index().empty() );
+                    reader.seek_to_value( 0ZU );
+                    reader.seek_to_value( 5ZU );
+                    EXPECT_EQ( reader.get_value_counter(), 0ZU );
+                    EXPECT_FALSE( reader.has_more() );
+                    EXPECT_EQ( reader.next_geq( 0ZU ), std::numeric_limits<std::size_t>::max() );
+                    reader.close();
+                }
+                const std::vector<std::uint32_t> values = { 9, 0, 4 };
+                write_values<samg::grcodec::rice::writer::OfflineRCodecWriter<std::uint32_t>>( file_name, values, 2ZU, sample_rate );
+                TypeParam reader( file_name );
+                for( const std::size_t i : { 2ZU, 0ZU, 1ZU } ) {
+                    reader.seek_to_value( i );
+                    EXPECT_EQ( reader.next(), values[i] );
+                }
+                reader.seek_to_value( 3ZU );
+                EXPECT_FALSE( reader.has_more() );
+                EXPECT_EQ( reader.get_running_sum(), 13ZU );
+                reader.restart();
+                EXPECT_EQ( reader.next_geq( 0ZU ), 9ZU );
+                EXPECT_EQ( reader.next_geq( 10ZU ), 13ZU );
+                EXPECT_EQ( reader.next_geq( 14ZU ), std::numeric_limits<std::size_t>::max() );
+                reader.close();
+            }
+            std::filesystem::remove( file_name );
+        }
+
+        template<template<typename> class Encoder, template<typename> class Decoder> void expect_universal_rice_runs_round_trip( const std::size_t k ) {
+            using Word = std::uint32_t;
+            const std::string file_name = ( std::filesystem::temp_directory_path() / "gr-codec-test-universal-runs.rrn" ).string();
+            std::mt19937_64 gen( 5 );
+            std::vector<Word> values;
+            Word x = 1000;
+            for( std::size_t i = 0; i < 20000; ++i ) { // Runs of +1 and -2, and random jumps.
+                const std::size_t c = gen() % 8;
+                x = ( c < 5 ) ? x + 1 : ( c < 7 ) ? x - 2 : (Word) gen();
+                values.push_back( x );
+            }
+            {
+                samg::grcodec::runlength::writer::OfflineRiceRunsWriter<Word, samg::grcodec::adapter::RingBuffer, Encoder<Word>> writer( std::make_shared<Encoder<Word>>( file_name, k ) );
+                for( const Word v : values ) {
+                    writer.add( v );
+                }
+                writer.close();
+            }
+            {
+                samg::grcodec::runlength::reader::OfflineRiceRunsReader<Word, samg::grcodec::adapter::RingBuffer, Decoder<Word>> reader( std::make_shared<Decoder<Word>>( file_name ) );
+                std::vector<Word> ans;
+                while( reader.has_more() ) {
+                    ans.push_back( reader.next() );
+                }
+                EXPECT_EQ( ans, values );
+                reader.close();
+            }
+            samg::grcodec::runlength::reader::OnlineRiceRunsReader<Word, samg::grcodec::adapter::RingBuffer, Decoder<Word>> reader( std::make_shared<Decoder<Word>>( file_name ) );
+            std::vector<Word> ans( values.size() );
+            EXPECT_EQ( reader.decode_block( ans.data(), ans.size() ), values.size() );
+            EXPECT_EQ( ans, values );
+            EXPECT_FALSE( reader.has_more() );
+            reader.close();
+            std::filesystem::remove( file_name );
+        }
+
+        TEST(UniversalRiceRuns,ExpGolomb) {
+            expect_universal_rice_runs_round_trip<samg::grcodec::universal::writer::OfflineExpGolombCodecWriter, samg::grcodec::universal::reader::OfflineExpGolombCodecReader>( 2 );
+        }
+
+        TEST(UniversalRiceRuns,EliasGamma) {
+            expect_universal_rice_runs_round_trip<samg::grcodec::universal::writer::OfflineEliasGammaCodecWriter, samg::grcodec::universal::reader::OfflineEliasGammaCodecReader>( 0 );
+        }
+
+        TEST(UniversalRiceRuns,EliasDelta) {
+            expect_universal_rice_runs_round_trip<samg::grcodec::universal::writer::OfflineEliasDeltaCodecWriter, samg::grcodec::universal::reader::OfflineEliasDeltaCodecReader>( 0 );
+        }
+
+        template<typename Word> void expect_rice_round_trip( const std::vector<Word>& values, const std::size_t k ) {
+            const std::string file_name = temp_file( "rice" );
+            write_values<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>>( file_name, values, k );
+            {
+                samg::grcodec::rice::reader::OfflineRCodecReader<Word> reader( file_name );
+                EXPECT_EQ( reader.get_k(), k );
+                EXPECT_EQ( read_values( reader ), values );
+                reader.close();
+            }
+            samg::grcodec::rice::reader::OnlineRCodecReader<Word> reader( file_name );
+            EXPECT_EQ( read_values( reader ), values );
+            reader.close();
+            std::filesystem::remove( file_name );
+        }
+
+        TEST(Rice,OrderSweep) {
+            std::mt19937_64 gen( 13 );
+            std::geometric_distribution<std::uint32_t> dist( 0.02 );
+            std::vector<std::uint32_t> values( 3000 );
+            for( auto& v : values ) {
+                v = dist( gen );
+            }
+            for( std::size_t k = 0; k <= 12; ++k ) {
+                expect_rice_round_trip( values, k );
+            }
+        }
+
+        TEST(Rice,QuotientsCrossingWords) {
+            // With k = 0 every value is a unary run as long as itself, so runs of 64 bits or more span several words.
+            std::vector<std::uint32_t> values = { 63, 64, 65, 1, 127, 128, 0, 200, 3, 1000, 57, 56, 58 };
+            for( std::uint32_t v = 0; v < 300; v += 7 ) {
+                values.push_back( v );
+            }
+            expect_rice_round_trip( values, 0 );
+            expect_rice_round_trip( values, 1 );
+        }
+
+        /**
+         * @brief Decodes the whole sequence alternating `next()` with `decode_block()` calls of several sizes (including 0 and larger than what is left), and checks it against `values`.
+         * 
+         */
+        template<typename Reader, typename Word> void expect_mixed_decoding( Reader& reader, const std::vector<Word>& values ) {
+            const std::size_t sizes[] = { 1, 0, 7, 64, 3, 200, 1 };
+            std::vector<Word> ans, block( 256 );
+            for( std::size_t s = 0; reader.has_more(); ++s ) {
+                ans.push_back( reader.next() );
+                const std::size_t n = sizes[ s % std::size( sizes ) ],
+                                  m = reader.decode_block( block.data(), n );
+                EXPECT_LE( m, n );
+                ans.insert( ans.end(), block.begin(), block.begin() + m );
+            }
+            EXPECT_EQ( ans, values );
+            EXPECT_EQ( reader.decode_block( block.data(), block.size() ), 0ZU );
+            reader.restart();
+            std::vector<Word> all( values.size() + 10 );
+            EXPECT_EQ( reader.decode_block( all.data(), all.size() ), values.size() );
+            all.resize( values.size() );
+            EXPECT_EQ( all, values );
+            EXPECT_FALSE( reader.has_more() );
+        }
+
+        TEST(DecodeBlock,RiceMixedWithNext) {
+            using Word = std::uint32_t;
+            std::mt19937_64 gen( 19 );
+            std::geometric_distribution<Word> dist( 0.1 );
+            std::vector<Word> values( 2000 );
+            for( auto& v : values ) {
+                v = dist( gen );
+            }
+            const std::string file_name = temp_file( "block" );
+            for( const std::size_t k : { 0ZU, 2ZU, 3ZU, 7ZU } ) {
+                write_values<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>>( file_name, values, k );
+                samg::grcodec::rice::reader::OfflineRCodecReader<Word> offline( file_name );
+                expect_mixed_decoding( offline, values );
+                offline.close();
+                samg::grcodec::rice::reader::OnlineRCodecReader<Word> online( file_name );
+                expect_mixed_decoding( online, values );
+                online.close();
+            }
+            std::filesystem::remove( file_name );
+        }
+
+        TEST(DecodeBlock,RiceRunsMixedWithNext) {
+            using Word = std::uint32_t;
+            std::mt19937_64 gen( 23 );
+            std::vector<Word> values;
+            Word x = 500;
+            for( std::size_t i = 0; i < 5000; ++i ) { // Long runs of equal differences, broken by random jumps.
+                x = ( gen() % 16 == 0 ) ? (Word) ( gen() % 100000 ) : x + 3;
+                values.push_back( x );
+            }
+            const std::string file_name = temp_file( "block-runs" );
+            {
+                samg::grcodec::runlength::writer::OfflineRiceRunsWriter<Word> writer( std::make_shared<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>>( file_name, 3 ) );
+                for( const Word v : values ) {
+                    writer.add( v );
+                }
+                writer.close();
+            }
+            samg::grcodec::runlength::reader::OfflineRiceRunsReader<Word> offline( std::make_shared<samg::grcodec::rice::reader::OfflineRCodecReader<Word>>( file_name ) );
+            expect_mixed_decoding( offline, values );
+            offline.close();
+            samg::grcodec::runlength::reader::OnlineRiceRunsReader<Word> online( std::make_shared<samg::grcodec::rice::reader::OnlineRCodecReader<Word>>( file_name ) );
+            expect_mixed_decoding( online, values );
+            online.close();
+            std::filesystem::remove( file_name );
+        }
+
+        TEST(RiceTable,WindowsMatchTheBitReader) {
+            using Table = samg::grcodec::toolkits::RiceTable<12>;
+            for( std::size_t k = 0; k <= Table::MAX_K; ++k ) {
+                const Table table( k );
+                EXPECT_EQ( table.get_max_codes(), 12ZU / ( k + 1ZU ) );
+                for( std::uint64_t w = 0; w <= Table::WINDOW_MASK; ++w ) {
+                    const std::uint64_t bytes = w | ( 0xFULL << 12 ); // Ones past the window, so a codeword cut by it cannot end early.
+                    samg::grcodec::toolkits::ByteArrayReader source( reinterpret_cast<const std::uint8_t*>( &bytes ), sizeof(bytes) );
+                    samg::grcodec::toolkits::BitBuffer<samg::grcodec::toolkits::ByteArrayReader> bits;
+                    bits.reset( &source, 0ZU );
+                    ASSERT_LE( table.count( w ), table.get_max_codes() );
+                    for( std::size_t j = 0; j < table.count( w ); ++j ) {
+                        ASSERT_EQ( table.codes( w )[j], bits.read_rice<std::uint32_t>( k ) ) << "k = " << k << ", w = " << w;
+                    }
+                    EXPECT_EQ( table.bits( w ), bits.tell() );
+                    if( bits.tell() + k < 12ZU ) { // What is left of the window is not a whole codeword.
+                        bits.read_rice<std::uint32_t>( k );
+                        EXPECT_GT( bits.tell(), 12ZU );
+                    }
+                }
+            }
+            EXPECT_THROW( Table( Table::MAX_K + 1ZU ), std::invalid_argument );
+        }
+
+        TEST(RiceTable,SmallOrdersDecodeBlock) {
+            using Word = std::uint32_t;
+            std::mt19937_64 gen( 29 );
+            std::vector<Word> values;
+            for( std::size_t i = 0; i < 4000; ++i ) { // Mostly short codewords, with some longer than the 12-bit window.
+                values.push_back( ( gen() % 10 == 0 ) ? (Word) ( gen() % 300 ) : (Word) ( gen() % 8 ) );
+            }
+            values.push_back( 0 ); // Short codewords right before the end of the bitmap.
+            values.push_back( 1 );
+            const std::string file_name = temp_file( "table" );
+            for( std::size_t k = 0; k <= samg::grcodec::toolkits::RiceTable<12>::MAX_K; ++k ) {
+                write_values<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>>( file_name, values, k );
+                samg::grcodec::rice::reader::OfflineRCodecReader<Word> reader( file_name );
+                std::vector<Word> ans( values.size() + 5 );
+                EXPECT_EQ( reader.decode_block( ans.data(), ans.size() ), values.size() ) << "k = " << k;
+                ans.resize( values.size() );
+                EXPECT_EQ( ans, values ) << "k = " << k;
+                reader.restart();
+                EXPECT_EQ( read_values( reader ), values ) << "k = " << k;
+                reader.close();
+            }
+            std::filesystem::remove( file_name );
+        }
+
+        TEST(BitWriter,FieldsAndRiceCodesRoundTrip) {
+            struct Field {
+                std::uint64_t bits;
+                std::size_t len; // 0 stands for a Rice codeword of order `bits >> 58` holding `bits & 0xFFFF`.
+            };
+            std::mt19937_64 gen( 31 );
+            std::vector<Field> fields;
+            for( std::size_t i = 0; i < 40000; ++i ) { // Over 64 KiB of output, so the writer block spills more than once.
+                const std::size_t len = gen() % 65;
+                fields.push_back( { len == 0 ? gen() & ( ( 0x3FULL << 58 ) | 0xFFFFULL ) : gen() >> ( 64 - len ), len } );
+            }
+            fields.push_back( { ~0ULL, 64 } );
+            fields.push_back( { 0ULL, 64 } );
+            fields.push_back( { 1ULL, 1 } );
+            fields.push_back( { 200ULL, 0 } ); // k = 0: a 201-bit unary run.
+            std::vector<std::uint8_t> bytes;
+            samg::grcodec::toolkits::ByteVectorWriter sink( bytes );
+            samg::grcodec::toolkits::BitWriter<samg::grcodec::toolkits::ByteVectorWriter> writer;
+            writer.reset( &sink );
+            std::size_t length = 0;
+            for( const Field& f : fields ) {
+                if( f.len == 0 ) {
+                    length += writer.put_rice( f.bits & 0xFFFFULL, f.bits >> 58 );
+                } else {
+                    writer.put( f.bits, f.len );
+                    length += f.len;
+                }
+            }
+            writer.flush( sizeof(std::uint64_t) );
+            EXPECT_EQ( bytes.size(), ( length + 63ZU ) / 64ZU * sizeof(std::uint64_t) );
+
+            samg::grcodec::toolkits::ByteArrayReader source( bytes.data(), bytes.size() );
+            samg::grcodec::toolkits::BitBuffer<samg::grcodec::toolkits::ByteArrayReader> reader;
+            reader.reset( &source, 0ZU );
+            for( const Field& f : fields ) {
+                if( f.len == 0 ) {
+                    ASSERT_EQ( reader.read_rice<std::uint64_t>( f.bits >> 58 ), f.bits & 0xFFFFULL );
+                } else {
+                    ASSERT_EQ( reader.read( f.len ), f.bits );
+                }
+            }
+            EXPECT_EQ( reader.tell(), length );
+        }
+
+        TEST(BitWriter,FlushAlignment) {
+            for( const std::size_t alignment : { 1ZU, 4ZU, 8ZU } ) {
+                for( const std::size_t nbits : { 0ZU, 1ZU, 8ZU, 9ZU, 63ZU, 64ZU, 65ZU, 130ZU } ) {
+                    std::vector<std::uint8_t> bytes;
+                    samg::grcodec::toolkits::ByteVectorWriter sink( bytes );
+                    samg::grcodec::toolkits::BitWriter<samg::grcodec::toolkits::ByteVectorWriter> writer;
+                    writer.reset( &sink );
+                    for( std::size_t i = 0; i < nbits; ++i ) {
+                        writer.put( 1ULL, 1ZU );
+                    }
+                    writer.flush( alignment );
+                    const std::size_t expected = ( ( nbits + 7ZU ) / 8ZU + alignment - 1ZU ) / alignment * alignment;
+                    ASSERT_EQ( bytes.size(), expected ) << "alignment = " << alignment << ", nbits = " << nbits;
+                    for( std::size_t i = 0; i < expected * 8ZU; ++i ) {
+                        ASSERT_EQ( ( bytes[i / 8ZU] >> ( i % 8ZU ) ) & 1U, i < nbits ? 1U : 0U ); // Zero padding.
+                    }
+                    writer.put( 5ULL, 3ZU ); // The writer starts afresh after a flush.
+                    writer.flush( 1ZU );
+                    ASSERT_EQ( bytes.size(), expected + 1ZU );
+                    EXPECT_EQ( bytes.back(), 5U );
+                }
+            }
+        }
+
+        TEST(BitBuffer,JumpWithinTheBufferedBlock) {
+            std::vector<std::uint8_t> bytes( 100 );
+            for( std::size_t i = 0; i < bytes.size(); ++i ) {
+                bytes[i] = (std::uint8_t) i;
+            }
+            samg::grcodec::toolkits::ByteArrayReader source( bytes.data(), bytes.size() );
+            samg::grcodec::toolkits::BitBuffer<samg::grcodec::toolkits::ByteArrayReader> reader;
+            reader.reset( &source, 0ZU );
+            EXPECT_EQ( reader.read( 8 ), 0ULL );
+            ASSERT_TRUE( reader.jump( 8ZU * 70ZU + 3ZU ) );
+            EXPECT_EQ( reader.read( 5 ), 70ULL >> 3 );
+            EXPECT_EQ( reader.read( 64 ), 0x4E4D4C4B4A494847ULL ); // Bytes 71..78 in a single read that crosses a word.
+            EXPECT_EQ( reader.tell(), 8ZU * 79ZU );
+            EXPECT_FALSE( reader.jump( 8ZU * 1000ZU ) );
+        }
+
+        template<typename Word> void expect_interleaved_round_trip( const std::vector<Word>& values, const std::size_t k ) {
+            const std::string file_name = temp_file( "interleaved" );
+            for( const std::size_t lanes : { 4ZU, 8ZU, 16ZU } ) {
+                for( const std::size_t segment_values : { 1ZU, 5ZU, 4096ZU } ) { // Segments of one row, of a few rows, and larger than the input.
+                    write_values<samg::grcodec::rice::writer::OfflineInterleavedRCodecWriter<Word>>( file_name, values, k, lanes, segment_values );
+                    samg::grcodec::rice::reader::OfflineInterleavedRCodecReader<Word> reader( file_name );
+                    EXPECT_EQ( reader.get_k(), k );
+                    EXPECT_EQ( reader.get_lanes(), lanes );
+                    EXPECT_EQ( read_values( reader ), values ) << "lanes = " << lanes << ", segment_values = " << segment_values;
+                    reader.restart();
+                    expect_mixed_decoding( reader, values );
+                    reader.close();
+                }
+            }
+            std::filesystem::remove( file_name );
+        }
+
+        TEST(InterleavedRice,PartialRowsAndSegments) {
+            std::mt19937_64 gen( 37 );
+            std::geometric_distribution<std::uint32_t> dist( 0.05 );
+            std::vector<std::uint32_t> values;
+            for( std::size_t i = 0; i < 1237; ++i ) { // Not a multiple of any lane count; some codewords longer than a 32-bit window.
+                values.push_back( ( i % 101 == 0 ) ? 5000 + (std::uint32_t) i : dist( gen ) );
+            }
+            for( const std::size_t k : { 0ZU, 3ZU, 24ZU, 25ZU } ) { // 25 and beyond fall back to the scalar decoder.
+                expect_interleaved_round_trip( values, k );
+            }
+        }
+
+        TEST(AdaptiveRice,OptimalParameterIsTheMinimum) {
+            using Common = samg::grcodec::toolkits::GolombRiceCommon<std::uint64_t>;
+            std::mt19937_64 gen( 43 );
+            for( std::size_t t = 0; t < 200; ++t ) {
+                const std::size_t n = 1 + gen() % 50,
+                                  shift = gen() % 64;
+                std::vector<std::uint64_t> values( n );
+                for( auto& v : values ) {
+                    v = gen() >> shift;
+                }
+                const auto [k, cost] = Common::optimal_rice_parameter( values.data(), n );
+                EXPECT_EQ( cost, Common::rice_cost( values.data(), n, k ) );
+                for( std::size_t j = 0; j < 64; ++j ) {
+                    ASSERT_LE( cost, Common::rice_cost( values.data(), n, j ) ) << "k = " << k << ", j = " << j;
+                }
+            }
+            EXPECT_EQ( Common::optimal_rice_parameter( nullptr, 0 ), std::make_pair( 0ZU, 0ZU ) );
+        }
+
+        template<typename Word> void expect_adaptive_round_trip( const std::vector<Word>& values ) {
+            const std::string file_name = temp_file( "adaptive" );
+            for( const std::size_t block_values : { 1ZU, 64ZU, 128ZU, 1000ZU } ) {
+                write_values<samg::grcodec::rice::writer::OfflineAdaptiveRCodecWriter<Word>>( file_name, values, block_values );
+                samg::grcodec::rice::reader::OfflineAdaptiveRCodecReader<Word> reader( file_name );
+                EXPECT_EQ( read_values( reader ), values ) << "block_values = " << block_values;
+                reader.restart();
+                expect_mixed_decoding( reader, values );
+                reader.close();
+            }
+            std::filesystem::remove( file_name );
+        }
+
+        TEST(AdaptiveRice,MixedDistributions) {
+            std::mt19937_64 gen( 47 );
+            std::vector<std::uint32_t> values;
+            for( std::size_t i = 0; i < 1280; ++i ) { // Exactly 10 blocks of 128: zeros, small gaps and wide values, each switching at block boundaries.
+                const std::size_t block = i / 128;
+                values.push_back( block % 3 == 0 ? 0U : block % 3 == 1 ? (std::uint32_t) ( gen() % 16 ) : (std::uint32_t) gen() );
+            }
+            values.push_back( 3 ); // A partial last block.
+            expect_adaptive_round_trip( values );
+        }
+
+        /**
+         * @brief Round-trips `values` through the FSM-based Rice-runs writer and both Rice-runs readers.
+         * 
+         */
+        template<typename Word> void expect_rice_runs_round_trip( const std::vector<Word>& values, const std::size_t k ) {
+            const std::string file_name = temp_file( "runs" );
+            {
+                samg::grcodec::runlength::writer::OfflineRiceRunsWriter<Word> writer( std::make_shared<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>>( file_name, k ) );
+                for( const Word v : values ) {
+                    writer.add( v );
+                }
+                writer.close();
+            }
+            {
+                samg::grcodec::runlength::reader::OfflineRiceRunsReader<Word> reader( std::make_shared<samg::grcodec::rice::reader::OfflineRCodecReader<Word>>( file_name ) );
+                EXPECT_EQ( read_values( reader ), values );
+                reader.close();
+            }
+            samg::grcodec::runlength::reader::OnlineRiceRunsReader<Word> reader( std::make_shared<samg::grcodec::rice::reader::OnlineRCodecReader<Word>>( file_name ) );
+            std::vector<Word> ans( values.size() + 1 );
+            EXPECT_EQ( reader.decode_block( ans.data(), ans.size() ), values.size() );
+            ans.pop_back();
+            EXPECT_EQ( ans, values );
+            reader.close();
+            std::filesystem::remove( file_name );
+        }
+
+        TEST(RiceRunsFSM,EmptyAndSingleValue) {
+            expect_rice_runs_round_trip<std::uint32_t>( {}, 2 );
+            expect_rice_runs_round_trip<std::uint32_t>( { 0 }, 2 );
+            expect_rice_runs_round_trip<std::uint32_t>( { 42 }, 2 );
+            expect_rice_runs_round_trip<std::uint64_t>( { std::numeric_limits<std::uint64_t>::max() }, 60 );
+        }
+
+        TEST(RiceRunsFSM,RunsAroundTheThreshold) {
+            constexpr std::size_t T = samg::grcodec::toolkits::RunLengthCommon<std::uint32_t>::RLE_THRESHOLD;
+            for( const std::size_t r : { T - 1ZU, T, T + 1ZU, 2ZU * T } ) {
+                for( const std::int32_t d : { 0, 1, 5, -1, -5 } ) { // Runs of zero, positive and negative differences.
+                    std::vector<std::uint32_t> values = { 1000 };
+                    for( std::size_t i = 0; i < r; ++i ) {
+                        values.push_back( values.back() + d );
+                    }
+                    values.push_back( 7 ); // A run broken right after the threshold...
+                    for( std::size_t i = 0; i < r; ++i ) { // ...and one closed by the end of the sequence.
+                        values.push_back( values.back() + d );
+                    }
+                    expect_rice_runs_round_trip( values, 2 );
+                    expect_rice_runs_round_trip( values, 0 );
+                }
+            }
+        }
+
+        TEST(RiceRunsFSM,AlternatingSignsAndNegativeStart) {
+            std::mt19937_64 gen( 59 );
+            std::vector<std::uint32_t> values = { 0, 0, 0, 0 }; // First differences of 0.
+            for( std::size_t i = 0; i < 3000; ++i ) {
+                const std::uint32_t step = (std::uint32_t) ( gen() % 4 );
+                const std::size_t repeat = gen() % 6;
+                for( std::size_t j = 0; j < repeat; ++j ) {
+                    values.push_back( ( i & 1ZU ) ? values.back() - step : values.back() + step );
+                }
+            }
+            expect_rice_runs_round_trip( values, 1 );
+            values.insert( values.begin(), std::numeric_limits<std::uint32_t>::max() ); // A first value that reads as a negative difference.
+            expect_rice_runs_round_trip( values, 3 );
+        }
+
+        template<typename Word> void expect_blocked_round_trip( const std::vector<Word>& values, const std::size_t block_values, const std::size_t nthreads ) {
+            using Reader = samg::grcodec::runlength::reader::OfflineBlockedRiceRunsReader<Word>;
+            const std::string file_name = temp_file( "blocked" );
+            write_values<samg::grcodec::runlength::writer::OfflineBlockedRiceRunsWriter<Word>>( file_name, values, block_values, nthreads );
+            Reader reader( file_name );
+            const std::size_t blocks = ( values.size() + block_values - 1ZU ) / block_values;
+            EXPECT_EQ( reader.get_value_count(), values.size() );
+            EXPECT_EQ( reader.get_block_values(), block_values );
+            ASSERT_EQ( reader.get_number_of_blocks(), blocks );
+            EXPECT_EQ( reader.decode_all( nthreads ), values );
+            expect_mixed_decoding( reader, values );
+            for( std::size_t first = 0; first <= blocks; first += 3ZU ) { // Sub-ranges, including empty ones.
+                const std::size_t last = std::min( first + 2ZU, blocks );
+                std::vector<Word> out( ( last - first ) * block_values );
+                reader.decode_blocks( first, last, out.data(), nthreads );
+                const std::size_t begin = std::min( values.size(), first * block_values ),
+                                  end = std::min( values.size(), last * block_values );
+                out.resize( end - begin );
+                EXPECT_EQ( out, std::vector<Word>( values.begin() + begin, values.begin() + end ) );
+                if( first < blocks ) {
+                    EXPECT_EQ( reader.get_block_length( first ), std::min( block_values, values.size() - first * block_values ) );
+                }
+            }
+            EXPECT_THROW( reader.decode_blocks( 1ZU, 0ZU, nullptr, nthreads ), std::invalid_argument );
+            EXPECT_THROW( reader.decode_blocks( 0ZU, blocks + 1ZU, nullptr, nthreads ), std::invalid_argument );
+            reader.close();
+            std::filesystem::remove( file_name );
+        }
+
+        TEST(BlockedRiceRuns,EmptyAndSingleValue) {
+            expect_blocked_round_trip<std::uint32_t>( {}, 16, 2 );
+            expect_blocked_round_trip<std::uint32_t>( { 9 }, 16, 2 );
+            expect_blocked_round_trip<std::uint64_t>( { std::numeric_limits<std::uint64_t>::max() }, 1, 1 );
+        }
+
+        TEST(BlockedRiceRuns,ExactAndPartialBlocks) {
+            std::mt19937_64 gen( 61 );
+            std::vector<std::uint32_t> values;
+            std::uint32_t x = 0;
+            for( std::size_t i = 0; i < 64 * 20; ++i ) {
+                values.push_back( x += ( gen() % 3 == 0 ) ? (std::uint32_t) ( gen() % 500 ) : 2U );
+            }
+            for( const std::size_t nthreads : { 1ZU, 3ZU } ) {
+                expect_blocked_round_trip( values, 64, nthreads ); // An exact multiple of the block size...
+                expect_blocked_round_trip( values, 1, nthreads );
+                values.push_back( 5 ); // ...and one value over it.
+                expect_blocked_round_trip( values, 64, nthreads );
+                values.pop_back();
+            }
+        }
+
+        TEST(RingBuffer,WrapAndGrowthMatchStdQueue) {
+            samg::grcodec::adapter::RingBuffer<std::int64_t> ring( 3 );
+            EXPECT_EQ( ring.capacity(), 4ZU ); // Rounded up to a power of two.
+            std::queue<std::int64_t> expected;
+            std::mt19937_64 gen( 67 );
+            std::int64_t x = 0;
+            for( std::size_t i = 0; i < 20000; ++i ) {
+                if( expected.empty() || gen() % 5 < 3 ) { // Pushes outnumber pops, so the ring wraps around while it grows.
+                    ring.push( --x );
+                    expected.push( x );
+                    ASSERT_EQ( ring.back(), x );
+                } else {
+                    ASSERT_EQ( ring.front(), expected.front() );
+                    ring.pop();
+                    expected.pop();
+                }
+                ASSERT_EQ( ring.size(), expected.size() );
+                ASSERT_EQ( ring.empty(), expected.empty() );
+                ASSERT_GE( ring.capacity(), ring.size() );
+            }
+            while( !expected.empty() ) {
+                ASSERT_EQ( ring.front(), expected.front() );
+                ring.pop();
+                expected.pop();
+            }
+            EXPECT_TRUE( ring.empty() );
+            ring.push( 5 );
+            ring.clear();
+            EXPECT_TRUE( ring.empty() );
+        }
+
+        TEST(RingBuffer,RiceRunsQueueTypesAgree) {
+            using Word = std::uint32_t;
+            std::mt19937_64 gen( 71 );
+            std::vector<Word> values;
+            Word x = 0;
+            for( std::size_t i = 0; i < 5000; ++i ) {
+                values.push_back( x += ( gen() % 4 == 0 ) ? (Word) ( gen() % 50 ) : 1U );
+            }
+            const std::string ring_file = temp_file( "ring" ),
+                              queue_file = temp_file( "queue" );
+            {
+                samg::grcodec::runlength::writer::OfflineRiceRunsWriter<Word> writer( std::make_shared<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>>( ring_file, 2 ) );
+                for( const Word v : values ) {
+                    writer.add( v );
+                }
+                writer.close();
+            }
+            {
+                samg::grcodec::runlength::writer::OfflineRiceRunsWriter<Word, std::queue> writer( std::make_shared<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>>( queue_file, 2 ) );
+                for( const Word v : values ) {
+                    writer.add( v );
+                }
+                writer.close();
+            }
+            std::ifstream a( ring_file, std::ios::binary ), b( queue_file, std::ios::binary );
+            EXPECT_TRUE( std::equal( std::istreambuf_iterator<char>( a ), std::istreambuf_iterator<char>(), std::istreambuf_iterator<char>( b ), std::istreambuf_iterator<char>() ) ); // Same bytes whatever the queue.
+            samg::grcodec::runlength::reader::OfflineRiceRunsReader<Word, std::queue> reader( std::make_shared<samg::grcodec::rice::reader::OfflineRCodecReader<Word>>( ring_file ) );
+            EXPECT_EQ( read_values( reader ), values );
+            reader.close();
+            std::filesystem::remove( ring_file );
+            std::filesystem::remove( queue_file );
+        }
+
+        TEST(SPSCQueue,ProducerConsumerCloseAndDrain) {
+            constexpr std::size_t N = 200000;
+            samg::grcodec::adapter::SPSCQueueAdapter<std::uint64_t> queue( 100 ); // A small ring, so both sides wait on each other.
+            EXPECT_EQ( queue.capacity(), 128ZU );
+            std::thread producer( [&queue]() {
+                std::uint64_t batch[37];
+                std::uint64_t v = 0;
+                while( v < N ) {
+                    if( v % 3 == 0 ) {
+                        const std::size_t n = std::min<std::size_t>( 37, N - v );
+                        for( std::size_t i = 0; i < n; ++i ) {
+                            batch[i] = v++;
+                        }
+                        queue.push_batch( batch, n );
+                    } else {
+                        if( !queue.try_push( v ) ) {
+                            queue.push( v );
+                        }
+                        ++v;
+                    }
+                }
+                queue.close();
+            } );
+            std::vector<std::uint64_t> out( 50 );
+            std::uint64_t expected = 0;
+            std::size_t n;
+            while( ( n = queue.pop_batch( out.data(), ( expected % 2 == 0 ) ? out.size() : 1ZU ) ) > 0ZU ) {
+                for( std::size_t i = 0; i < n; ++i ) {
+                    ASSERT_EQ( out[i], expected++ );
+                }
+            }
+            producer.join();
+            EXPECT_EQ( expected, N );
+            EXPECT_TRUE( queue.is_drained() );
+            EXPECT_EQ( queue.pop_batch( out.data(), out.size() ), 0ZU ); // Stays drained.
+            EXPECT_THROW( queue.front(), std::runtime_error );
+            EXPECT_THROW( queue.pop(), std::runtime_error );
+        }
+
+        TEST(SPSCQueue,CloseBeforeConsuming) {
+            samg::grcodec::adapter::SPSCQueueAdapter<std::uint32_t> queue( 8 );
+            EXPECT_EQ( queue.pop_batch( nullptr, 0ZU ), 0ZU );
+            for( std::uint32_t v = 0; v < 5; ++v ) {
+                EXPECT_TRUE( queue.try_push( v ) );
+            }
+            EXPECT_EQ( queue.back(), 4U );
+            queue.close();
+            EXPECT_TRUE( queue.is_closed() );
+            EXPECT_FALSE( queue.is_drained() ); // Elements pushed before closing are still delivered.
+            EXPECT_EQ( queue.front(), 0U );
+            queue.pop();
+            std::uint32_t out[8];
+            EXPECT_EQ( queue.pop_batch( out, 8 ), 4ZU );
+            EXPECT_EQ( out[3], 4U );
+            EXPECT_TRUE( queue.is_drained() );
+            EXPECT_EQ( queue.pop_batch( out, 8 ), 0ZU );
+        }
+
+        TEST(SPSCQueue,PipelinedEncode) {
+            using Word = std::uint32_t;
+            std::mt19937_64 gen( 73 );
+            std::geometric_distribution<Word> dist( 0.1 );
+            std::vector<Word> values( 30000 );
+            for( auto& v : values ) {
+                v = dist( gen );
+            }
+            const std::string file_name = temp_file( "pipelined" );
+            for( const std::size_t count : { 0ZU, 1ZU, values.size() } ) {
+                samg::grcodec::adapter::SPSCQueueAdapter<Word> queue( 256 );
+                samg::grcodec::rice::writer::OfflineRCodecWriter<Word> writer( file_name, 3 );
+                std::thread producer( [&queue, &values, count]() {
+                    for( std::size_t i = 0; i < count; ++i ) {
+                        queue.push( values[i] );
+                    }
+                    queue.close();
+                } );
+                samg::grcodec::toolkits::Batch<Word>::pipelined_encode( writer, queue, 100 );
+                producer.join();
+                writer.close();
+                samg::grcodec::rice::reader::OfflineRCodecReader<Word> reader( file_name );
+                EXPECT_EQ( read_values( reader ), std::vector<Word>( values.begin(), values.begin() + count ) );
+                reader.close();
+            }
+            std::filesystem::remove( file_name );
+        }
+
+        template<typename Type> void expect_grcodec_round_trip( const std::vector<Type>& values, const std::size_t m, const typename samg::grcodec::golomb::GRCodec<Type>::GRCodecType type ) {
+            using Codec = samg::grcodec::golomb::GRCodec<Type>;
+            Codec codec( m, type );
+            for( std::size_t i = 0; i < values.size(); ++i ) { // Single and bulk appends.
+                if( i % 3 == 0 && i + 5 <= values.size() ) {
+                    codec.append( values.data() + i, 5 );
+                    i += 4;
+                } else {
+                    codec.append( values[i] );
+                }
+            }
+            EXPECT_EQ( codec.get_words().size(), ( codec.length() + 63ZU ) / 64ZU );
+            std::vector<Type> ans;
+            while( codec.has_more() ) {
+                ans.push_back( codec.next() );
+            }
+            EXPECT_EQ( ans, values ) << "m = " << m;
+            codec.restart();
+            std::vector<Type> block( values.size() + 3 );
+            EXPECT_EQ( codec.decode_block( block.data(), block.size() ), values.size() );
+            block.resize( values.size() );
+            EXPECT_EQ( block, values );
+            Codec copy( codec.get_bit_vector(), m, type );
+            EXPECT_EQ( copy.length(), codec.length() );
+            ans.clear();
+            while( copy.has_more() ) {
+                ans.push_back( copy.next() );
+            }
+            EXPECT_EQ( ans, values );
+            std::vector<std::uint64_t> words;
+            std::size_t bit_length = 0, position = 0;
+            Codec::encode( values.data(), values.size(), m, words, bit_length, type );
+            EXPECT_EQ( words, codec.get_words() );
+            EXPECT_EQ( bit_length, codec.length() );
+            block.assign( values.size(), 0 );
+            EXPECT_EQ( Codec::decode( words.data(), bit_length, m, block.data(), block.size(), position, type ), values.size() );
+            EXPECT_EQ( block, values );
+            EXPECT_EQ( position, bit_length );
+        }
+
+        TEST(GRCodec,EmptyCodecAndSingleCodewords) {
+            using Codec = samg::grcodec::golomb::GRCodec<std::uint32_t>;
+            for( const auto type : { Codec::GOLOMB_RICE, Codec::EXPONENTIAL_GOLOMB } ) {
+                Codec codec( 5, type );
+                EXPECT_FALSE( codec.has_more() );
+                std::uint32_t out[2];
+                EXPECT_EQ( codec.decode_block( out, 2 ), 0ZU );
+                EXPECT_EQ( Codec::decode( Codec::encode( 77, 6, type ), 6, type ), 77U );
+            }
+        }
+
+        TEST(GRCodec,NonPowerOfTwoParameters) {
+            using Codec = samg::grcodec::golomb::GRCodec<std::uint32_t>;
+            std::mt19937_64 gen( 79 );
+            std::geometric_distribution<std::uint32_t> dist( 0.01 );
+            std::vector<std::uint32_t> values( 2000 );
+            for( auto& v : values ) {
+                v = dist( gen );
+            }
+            for( const std::size_t m : { 1ZU, 2ZU, 3ZU, 5ZU, 6ZU, 7ZU, 8ZU, 10ZU, 100ZU, 255ZU, 1000ZU } ) {
+                expect_grcodec_round_trip( values, m, Codec::GOLOMB_RICE );
+                expect_grcodec_round_trip( values, m, Codec::EXPONENTIAL_GOLOMB );
+            }
+            EXPECT_THROW( Codec( std::vector<std::uint64_t>( 3 ), 64, 5 ), std::invalid_argument ); // 64 bits take one word, not three.
+        }
+
+        TEST(GRCodec,SameBitsAsTheBitWriter) {
+            using Codec = samg::grcodec::golomb::GRCodec<std::uint64_t>;
+            std::mt19937_64 gen( 83 );
+            std::vector<std::uint64_t> values( 3000 );
+            for( auto& v : values ) {
+                v = gen() >> ( 40 + gen() % 24 );
+            }
+            for( const std::size_t k : { 0ZU, 3ZU, 9ZU } ) { // m = 2^k: Rice and Exp-Golomb codewords of order k.
+                std::vector<std::uint8_t> rice, exp_golomb;
+                samg::grcodec::toolkits::ByteVectorWriter rice_sink( rice ), exp_golomb_sink( exp_golomb );
+                samg::grcodec::toolkits::BitWriter<samg::grcodec::toolkits::ByteVectorWriter> rice_writer, exp_golomb_writer;
+                rice_writer.reset( &rice_sink );
+                exp_golomb_writer.reset( &exp_golomb_sink );
+                Codec rice_codec( 1ZU << k ), exp_golomb_codec( 1ZU << k, Codec::EXPONENTIAL_GOLOMB );
+                for( const std::uint64_t v : values ) {
+                    rice_writer.put_rice( v, k );
+                    exp_golomb_writer.put_exp_golomb( v, k );
+                    rice_codec.append( v );
+                    exp_golomb_codec.append( v );
+                }
+                rice_writer.flush( sizeof(std::uint64_t) );
+                exp_golomb_writer.flush( sizeof(std::uint64_t) );
+                EXPECT_EQ( std::memcmp( rice.data(), rice_codec.get_words().data(), rice.size() ), 0 );
+                EXPECT_EQ( rice.size(), rice_codec.get_words().size() * sizeof(std::uint64_t) );
+                EXPECT_EQ( std::memcmp( exp_golomb.data(), exp_golomb_codec.get_words().data(), exp_golomb.size() ), 0 );
+                EXPECT_EQ( exp_golomb.size(), exp_golomb_codec.get_words().size() * sizeof(std::uint64_t) );
+            }
+        }
+
+        TEST(GRCodec,CodewordsCrossingWords) {
+            using Codec = samg::grcodec::golomb::GRCodec<std::uint16_t>;
+            std::vector<std::uint16_t> values;
+            for( std::uint16_t v = 0; v < 400; v += 3 ) { // With m = 3, quotients grow past 64 bits.
+                values.push_back( v );
+                values.push_back( (std::uint16_t) ( 400 - v ) );
+            }
+            expect_grcodec_round_trip( values, 3, Codec::GOLOMB_RICE );
+            expect_grcodec_round_trip( values, 1, Codec::GOLOMB_RICE );
+            expect_grcodec_round_trip( values, 1, Codec::EXPONENTIAL_GOLOMB );
+        }
+
+        template<typename Word, typename Code> void expect_universal_round_trip( const std::vector<Word>& values, const std::size_t k ) {
+            const std::string file_name = temp_file( "universal" );
+            write_values<samg::grcodec::universal::writer::OfflineUniversalCodecWriter<Word, Code>>( file_name, values, k );
+            samg::grcodec::universal::reader::OfflineUniversalCodecReader<Word, Code> reader( file_name );
+            EXPECT_EQ( reader.get_k(), k );
+            EXPECT_EQ( reader.get_value_count(), values.size() );
+            EXPECT_EQ( read_values( reader ), values ) << "k = " << k;
+            reader.restart();
+            expect_mixed_decoding( reader, values );
+            reader.close();
+            std::filesystem::remove( file_name );
+        }
+
+        template<typename Code> void expect_universal_codes( const std::vector<std::size_t> orders ) {
+            constexpr std::uint64_t MAX = std::numeric_limits<std::uint64_t>::max();
+            std::vector<std::uint64_t> wide = { MAX, 0, MAX - 1, 1ULL << 63, ( 1ULL << 63 ) - 1, 1 },
+                                       mixed;
+            std::mt19937_64 gen( 97 );
+            for( std::size_t i = 0; i < 3000; ++i ) { // Every width, so codewords of every length cross words.
+                mixed.push_back( gen() >> ( gen() % 64 ) );
+            }
+            wide.insert( wide.end(), mixed.begin(), mixed.begin() + 100 );
+            std::vector<std::uint32_t> narrow( 3000 );
+            for( auto& v : narrow ) {
+                v = (std::uint32_t) ( gen() >> ( 32 + gen() % 32 ) );
+            }
+            narrow.push_back( std::numeric_limits<std::uint32_t>::max() );
+            for( const std::size_t k : orders ) {
+                expect_universal_round_trip<std::uint32_t, Code>( {}, k );
+                expect_universal_round_trip<std::uint32_t, Code>( { 0 }, k );
+                expect_universal_round_trip<std::uint64_t, Code>( { MAX }, k );
+                expect_universal_round_trip<std::uint64_t, Code>( wide, k );
+                expect_universal_round_trip<std::uint64_t, Code>( mixed, k );
+                expect_universal_round_trip<std::uint32_t, Code>( narrow, k );
+            }
+        }
+
+        TEST(UniversalCodes,ExpGolomb) {
+            expect_universal_codes<samg::grcodec::toolkits::ExpGolombCode>( { 0, 1, 5, 63 } );
+        }
+
+        TEST(UniversalCodes,EliasGamma) {
+            expect_universal_codes<samg::grcodec::toolkits::EliasGammaCode>( { 0 } );
+        }
+
+        TEST(UniversalCodes,EliasDelta) {
+            expect_universal_codes<samg::grcodec::toolkits::EliasDeltaCode>( { 0 } );
+        }
+
+        TEST(UniversalCodes,MismatchedFilesAreRejected) {
+            const std::string file_name = temp_file( "universal-mismatch" );
+            write_values<samg::grcodec::universal::writer::OfflineEliasGammaCodecWriter<std::uint32_t>>( file_name, std::vector<std::uint32_t>( { 1, 2, 3 } ) );
+            EXPECT_THROW( samg::grcodec::universal::reader::OfflineEliasDeltaCodecReader<std::uint32_t>{ file_name }, std::runtime_error );
+            EXPECT_THROW( samg::grcodec::universal::reader::OfflineExpGolombCodecReader<std::uint32_t>{ file_name }, std::runtime_error );
+            EXPECT_THROW( ( samg::grcodec::universal::writer::OfflineEliasGammaCodecWriter<std::uint32_t>( file_name, 2 ) ), std::invalid_argument );
+            std::filesystem::remove( file_name );
+        }
+
+        /**
+         * @brief Round-trips `values` through a codec container and returns the number of blocks encoded with each codec.
+         * 
+         */
+        std::array<std::size_t,3> expect_container_round_trip( const std::vector<std::uint64_t>& values, const std::size_t block_values, const samg::grcodec::selector::CostModel model = samg::grcodec::selector::CostModel() ) {
+            using namespace samg::grcodec::selector;
+            const std::string file_name = temp_file( "container" );
+            std::vector<Choice> choices;
+            {
+                ContainerWriter writer( file_name, block_values, CodecSelector( model ) );
+                writer.add_metadata( 7 );
+                writer.add_metadata( 42 );
+                for( const std::uint64_t v : values ) {
+                    writer.add( v );
+                }
+                writer.close();
+                choices = writer.get_choices();
+            }
+            ContainerReader reader( file_name );
+            std::array<std::size_t,3> counts = { 0, 0, 0 };
+            EXPECT_EQ( reader.get_value_count(), values.size() );
+            EXPECT_EQ( reader.get_metadata(), std::vector<std::size_t>( { 7, 42 } ) );
+            EXPECT_EQ( reader.get_number_of_blocks(), choices.size() );
+            for( std::size_t i = 0; i < reader.get_number_of_blocks(); ++i ) {
+                EXPECT_EQ( reader.get_block_entry( i ).codec, (std::size_t) choices[i].codec );
+                ++counts[ reader.get_block_entry( i ).codec ];
+            }
+            EXPECT_EQ( read_values( reader ), values );
+            EXPECT_THROW( reader.next(), std::runtime_error );
+            reader.restart();
+            expect_mixed_decoding( reader, values );
+            EXPECT_EQ( reader.decode_all(), values );
+            for( std::size_t i = reader.get_number_of_blocks(); i-- > 0; ) { // Random access, backwards.
+                std::vector<std::uint64_t> block( reader.get_block_length( i ) );
+                EXPECT_EQ( reader.decode_block_at( i, block.data() ), block.size() );
+                EXPECT_TRUE( std::equal( block.begin(), block.end(), values.begin() + i * reader.get_block_values() ) );
+            }
+            reader.close();
+            std::filesystem::remove( file_name );
+            return counts;
+        }
+
+        TEST(CodecContainer,RoundTrips) {
+            using namespace samg::grcodec::selector;
+            constexpr std::uint64_t MAX = std::numeric_limits<std::uint64_t>::max();
+            std::mt19937_64 gen( 101 );
+            std::vector<std::uint64_t> gaps, runs, wide, random;
+            std::geometric_distribution<std::uint64_t> dist( 0.1 );
+            std::uint64_t x = 0, y = 0;
+            for( std::size_t i = 0; i < 20000; ++i ) {
+                gaps.push_back( x += dist( gen ) ); // Sorted, small gaps.
+                runs.push_back( y += ( ( i / 500 ) % 2 ) ? 3 : 1000 ); // Long runs of equal gaps.
+                wide.push_back( ( i < 10000 ) ? gaps.back() : gaps.back() + ( 1ULL << 40 ) ); // A gap wider than 32 bits in the middle.
+                random.push_back( gen() | ( ( i & 1ZU ) ? 1ULL << 63 : 0ULL ) ); // Unsorted, near 2^64.
+            }
+            random.push_back( MAX );
+            random.push_back( 0 );
+            random.push_back( MAX );
+            CostModel smallest, fastest;
+            smallest.bits_per_ns = 0.0;
+            fastest.bits_per_ns = 1e9;
+            std::array<std::size_t,3> counts = { 0, 0, 0 };
+            for( const std::size_t block_values : { 0ZU, 1000ZU, 4096ZU } ) { // One block, an exact multiple of it, and a partial last block.
+                for( const CostModel& model : { CostModel(), smallest, fastest } ) {
+                    for( const auto* values : { &gaps, &runs, &wide, &random } ) {
+                        const std::array<std::size_t,3> c = expect_container_round_trip( *values, block_values, model );
+                        for( std::size_t j = 0; j < 3; ++j ) {
+                            counts[j] += c[j];
+                        }
+                    }
+                }
+            }
+            EXPECT_GT( counts[RICE_CODEC], 0ZU ); // Every codec was exercised.
+            EXPECT_GT( counts[RICE_RUNS_CODEC], 0ZU );
+            EXPECT_GT( counts[QMX_CODEC], 0ZU );
+        }
+
+        TEST(CodecContainer,CorruptedHeadersAreRejected) {
+            using namespace samg::grcodec::selector;
+            const std::string file_name = temp_file( "container-corrupted" );
+            std::vector<std::uint64_t> values( 3000 );
+            std::iota( values.begin(), values.end(), 100 );
+            {
+                ContainerWriter writer( file_name, 1000 );
+                for( const std::uint64_t v : values ) {
+                    writer.add( v );
+                }
+                writer.close();
+            }
+            const auto patch = [&file_name]( const std::size_t position, const std::uint64_t word ) {
+                std::fstream file( file_name, std::ios::in | std::ios::out | std::ios::binary );
+                file.seekp( position );
+                file.write( reinterpret_cast<const char*>( &word ), sizeof(word) );
+            };
+            patch( 0, 0x4c455343474d4154ULL ); // "TAMGCSEL"
+            EXPECT_THROW( ContainerReader{ file_name }, std::runtime_error );
+            patch( 0, ContainerWriter::MAGIC );
+            patch( sizeof(std::uint64_t), ContainerWriter::VERSION + 1ZU );
+            EXPECT_THROW( ContainerReader{ file_name }, std::runtime_error );
+            patch( sizeof(std::uint64_t), ContainerWriter::VERSION );
+            {
+                ContainerReader reader( file_name );
+                EXPECT_EQ( reader.decode_all(), values ); // Intact again.
+                reader.close();
+            }
+            const std::size_t nbytes = std::filesystem::file_size( file_name ),
+                              tail = nbytes - ContainerWriter::TRAILER_LENGTH * sizeof(std::uint64_t);
+            patch( tail + 2ZU * sizeof(std::uint64_t), 4 ); // Block count that disagrees with the value count.
+            EXPECT_THROW( ContainerReader{ file_name }, std::runtime_error );
+            patch( tail + 2ZU * sizeof(std::uint64_t), 3 );
+            patch( tail + 3ZU * sizeof(std::uint64_t), std::numeric_limits<std::uint64_t>::max() ); // Metadata larger than the file.
+            EXPECT_THROW( ContainerReader{ file_name }, std::runtime_error );
+            patch( tail + 3ZU * sizeof(std::uint64_t), 0 );
+            patch( tail - sizeof(std::uint64_t), nbytes ); // Last block past the payloads.
+            EXPECT_THROW( ContainerReader{ file_name }, std::runtime_error );
+            std::filesystem::resize_file( file_name, nbytes - 1ZU ); // Truncated tail.
+            EXPECT_THROW( ContainerReader{ file_name }, std::runtime_error );
+            std::filesystem::resize_file( file_name, nbytes - sizeof(std::uint64_t) );
+            EXPECT_THROW( ContainerReader{ file_name }, std::runtime_error );
+            std::filesystem::remove( file_name );
+        }
+
+        TEST(CodecContainer,PayloadsAreWrittenAsBlocksFill) {
+            using namespace samg::grcodec::selector;
+            const std::string file_name = temp_file( "container-streamed" );
+            std::mt19937_64 gen( 103 );
+            std::vector<std::uint64_t> values( 100000 );
+            for( std::uint64_t& v : values ) {
+                v = gen();
+            }
+            for( const std::size_t block_values : { 0ZU, 1000ZU } ) {
+                ContainerWriter writer( file_name, block_values );
+                for( const std::uint64_t v : values ) {
+                    writer.add( v );
+                }
+                EXPECT_GT( std::filesystem::file_size( file_name ), values.size() * sizeof(std::uint64_t) / 2ZU ); // Most payloads are on disk before close().
+                writer.close();
+                ContainerReader reader( file_name );
+                EXPECT_EQ( reader.decode_all(), values );
+                reader.close();
+            }
+            std::filesystem::remove( file_name );
+        }
+
+        /**
+         * @brief Edge cases shared by every codec. Each type parameter names a `Word` and provides `expect_round_trip(values)`, which round-trips `values` through one codec under each of its configurations.
+         * @note Parameters are chosen for values up to the top of `Word`, so that quotients stay short.
+         * 
+         */
+        template<typename Codec> class CodecEdgeCases : public ::testing::Test {};
+
+        template<typename W> struct RiceCodec {
+            using Word = W;
+            static void expect_round_trip( const std::vector<Word>& values ) {
+                for( const std::size_t k : { 8ZU * sizeof(Word) - 4ZU, 8ZU * sizeof(Word) - 1ZU } ) { // Quotients of at most 15 bits.
+                    expect_rice_round_trip( values, k );
+                }
+            }
+        };
+
+        template<typename W> struct InterleavedRiceCodec {
+            using Word = W;
+            static void expect_round_trip( const std::vector<Word>& values ) {
+                for( const std::size_t k : { 8ZU * sizeof(Word) - 4ZU, 8ZU * sizeof(Word) - 1ZU } ) {
+                    expect_interleaved_round_trip( values, k );
+                }
+            }
+        };
+
+        template<typename W> struct AdaptiveRiceCodec {
+            using Word = W;
+            static void expect_round_trip( const std::vector<Word>& values ) {
+                expect_adaptive_round_trip( values ); // Picks its own parameters.
+            }
+        };
+
+        template<typename W> struct GolombCodec {
+            using Word = W;
+            static void expect_round_trip( const std::vector<Word>& values ) {
+                using Codec = samg::grcodec::golomb::GRCodec<Word>;
+                constexpr std::size_t BITS = 8ZU * sizeof(Word);
+                expect_grcodec_round_trip( values, 3ZU << ( BITS - 3ZU ), Codec::GOLOMB_RICE ); // Quotients of at most 2.
+                expect_grcodec_round_trip( values, ( 1ZU << ( BITS - 2ZU ) ) + 1ZU, Codec::GOLOMB_RICE );
+                expect_grcodec_round_trip( values, 1ZU, Codec::EXPONENTIAL_GOLOMB ); // Codewords of up to 2 * BITS + 1 bits.
+                expect_grcodec_round_trip( values, 1ZU << ( BITS - 24ZU ), Codec::EXPONENTIAL_GOLOMB );
+            }
+        };
+
+        struct ContainerCodec {
+            using Word = std::uint64_t;
+            static void expect_round_trip( const std::vector<Word>& values ) {
+                for( const std::size_t block_values : { 0ZU, 1ZU, 3ZU } ) { // Per-file selection, and blocks of one and of a few values.
+                    expect_container_round_trip( values, block_values );
+                }
+            }
+        };
+
+        using EdgeCaseCodecs = ::testing::Types<RiceCodec<std::uint32_t>, RiceCodec<std::uint64_t>,
+                                                InterleavedRiceCodec<std::uint32_t>, InterleavedRiceCodec<std::uint64_t>,
+                                                AdaptiveRiceCodec<std::uint32_t>, AdaptiveRiceCodec<std::uint64_t>,
+                                                GolombCodec<std::uint32_t>, GolombCodec<std::uint64_t>,
+                                                ContainerCodec>;
+        TYPED_TEST_SUITE(CodecEdgeCases, EdgeCaseCodecs);
+
+        TYPED_TEST(CodecEdgeCases,EmptyAndSingleValue) {
+            using Word = typename TypeParam::Word;
+            constexpr Word MAX = std::numeric_limits<Word>::max();
+            for( const std::vector<Word>& values : { std::vector<Word>(), std::vector<Word>( { 0 } ), std::vector<Word>( { 77 } ), std::vector<Word>( { MAX } ), std::vector<Word>( { MAX, 0, 1 } ) } ) {
+                TypeParam::expect_round_trip( values );
+            }
+        }
+
+        TYPED_TEST(CodecEdgeCases,ValuesNearTheWordLimit) {
+            using Word = typename TypeParam::Word;
+            constexpr Word MAX = std::numeric_limits<Word>::max(),
+                           HALF = (Word) ( MAX / 2 + 1 );
+            std::vector<Word> values = { MAX, 0, MAX - 1, HALF, (Word) ( HALF - 1 ), 1 };
+            std::mt19937_64 gen( 17 );
+            for( std::size_t i = 0; i < 300; ++i ) {
+                values.push_back( (Word) ( gen() | HALF ) );
+            }
+            TypeParam::expect_round_trip( values );
+        }
+
     }
 }
 int main(int argc, char **argv) {
@@ -52,6 +52,19 @@
 #include <cassert>
 #include <utility>
 #include <unordered_map>
+#include <bit>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 #include <sdsl/bit_vectors.hpp>
 #include <samg/commons.hpp>
 #include <samg/matutx.hpp>
@@ -72,7 +85,8 @@ namespace samg {
                 Q_QUEUEADAPTER,
                 // QUINT_QUEUEADAPTER,
                 // QINT_QUEUEADAPTER,
-                ITERATOR_QUEUEADAPTER
+                ITERATOR_QUEUEADAPTER,
+                SPSC_QUEUEADAPTER
             };
             template<typename Type> class QueueAdapter {
                 protected:
@@ -86,8 +100,8 @@ namespace samg {
                     virtual Type front() = 0;
                     virtual Type back() = 0;
                     virtual void push( Type v ) = 0;
-                    virtual bool empty() = 0;
-                    virtual std::size_t size() = 0;
+                    virtual bool empty() const = 0;
+                    virtual std::size_t size() const = 0;
                     virtual void pop() = 0;
                     static void swap( QueueAdapter<Type>& a, QueueAdapter<Type>& b ) {
                         a._swap_( b );
@@ -174,7 +188,7 @@ namespace samg {
                         this->_empty_ = tmp_empty;
                     }
 
-                    const bool _is_full_() {
+                    const bool _is_full_() const {
                         return !this->_empty_ && this->size() == this->queue.size();
                     } 
 
@@ -211,8 +225,9 @@ namespace samg {
                             // }
                             // this->_swap_( *tmp_q );
                             std::size_t size = this->j = this->queue.size();
+                            std::rotate( this->queue.begin(), this->queue.begin() + this->i, this->queue.end() ); // Unwrap, so the new slots follow the last element.
+                            this->i = 0ZU;
                             this->queue.resize( size + ( (std::size_t) ( size / 2ZU ) ) );
-                            std::cout << "*** " << size << " / " << this->queue.size() << std::endl;
                             // std::vector<Type> tmp = this->queue;
                             // this->queue = std::vector<Type>( tmp.size() + ( (std::size_t) ( tmp.size() / 2ZU ) ) );
                             // while( !this->empty() ) {
@@ -227,11 +242,11 @@ namespace samg {
                         this->_empty_ = false;
                     }
 
-                    bool empty() override {
+                    bool empty() const override {
                         return this->_empty_;
                     }
 
-                    std::size_t size() override {
+                    std::size_t size() const override {
                         if( this->_empty_ ) {
                             return 0ZU;
                         }else if( this->j > this->i ) {
@@ -288,11 +303,11 @@ namespace samg {
                         throw std::runtime_error("IteratorQueueAdapter> Non-implemented method!");
                     }
 
-                    bool empty() override {
+                    bool empty() const override {
                         return this->begin == this->end;
                     }
 
-                    std::size_t size() override {
+                    std::size_t size() const override {
                         return this->end - this->begin;
                     }
 
@@ -301,6 +316,309 @@ namespace samg {
                     }
             };
 
+            /**
+             * @brief Lock-free single-producer/single-consumer queue over a fixed power-of-two ring. It lets a parsing thread feed an encoding thread: the producer calls `push`/`push_batch` and finally `close`, and the consumer calls `front`/`pop`/`pop_batch`.
+             * @note The consumer-side index (`head`) and the producer-side index (`tail`) live on separate cache lines, each next to the owner's cached copy of the other index, so that the two threads only share a line when the cached view runs out.
+             * @note A full ring makes the producer wait and an empty one makes the consumer wait (yielding), until `close()` is called.
+             * 
+             * @tparam Type 
+             */
+            template<typename Type> class SPSCQueueAdapter : public QueueAdapter<Type> {
+                private:
+                    static constexpr std::size_t CACHE_LINE_BYTES = 64ZU;
+                    std::vector<Type> ring;
+                    const std::size_t mask; // ring.size() - 1.
+                    alignas(CACHE_LINE_BYTES) std::atomic<std::size_t> head; // Next position to read; written by the consumer only.
+                    std::size_t cached_tail; // Consumer's last view of `tail`.
+                    alignas(CACHE_LINE_BYTES) std::atomic<std::size_t> tail; // Next position to write; written by the producer only.
+                    std::size_t cached_head; // Producer's last view of `head`.
+                    alignas(CACHE_LINE_BYTES) std::atomic<bool> closed;
+
+                    void _swap_( [[maybe_unused]] QueueAdapter<Type>& other ) override {
+                        throw std::runtime_error("SPSCQueueAdapter> Non-implemented method!");
+                    }
+
+                    /**
+                     * @brief Producer side: returns the number of free slots.
+                     * 
+                     * @return std::size_t 
+                     */
+                    inline std::size_t _free_slots_() {
+                        const std::size_t t = this->tail.load( std::memory_order_relaxed );
+                        if( t - this->cached_head == this->ring.size() ) {
+                            this->cached_head = this->head.load( std::memory_order_acquire );
+                        }
+                        return this->ring.size() - ( t - this->cached_head );
+                    }
+
+                    /**
+                     * @brief Consumer side: returns the number of readable elements.
+                     * 
+                     * @return std::size_t 
+                     */
+                    inline std::size_t _available_() {
+                        const std::size_t h = this->head.load( std::memory_order_relaxed );
+                        if( this->cached_tail == h ) {
+                            this->cached_tail = this->tail.load( std::memory_order_acquire );
+                        }
+                        return this->cached_tail - h;
+                    }
+
+                    /**
+                     * @brief Consumer side: waits until an element is readable or the queue is closed and drained.
+                     * 
+                     * @return std::size_t is the number of readable elements; 0 only at the end of the stream.
+                     */
+                    std::size_t _wait_available_() {
+                        std::size_t n;
+                        while( ( n = this->_available_() ) == 0ZU ) {
+                            if( this->closed.load( std::memory_order_acquire ) ) {
+                                return this->_available_(); // Elements pushed right before closing.
+                            }
+                            std::this_thread::yield();
+                        }
+                        return n;
+                    }
+
+                public:
+                    /**
+                     * @brief Construct a new SPSC Queue Adapter object
+                     * 
+                     * @param capacity is rounded up to a power of two.
+                     */
+                    SPSCQueueAdapter( const std::size_t capacity = 1ZU << 16 ) :
+                        ring ( std::bit_ceil( std::max<std::size_t>( capacity, 2ZU ) ) ),
+                        mask ( ring.size() - 1ZU ),
+                        head ( 0ZU ),
+                        cached_tail ( 0ZU ),
+                        tail ( 0ZU ),
+                        cached_head ( 0ZU ),
+                        closed ( false ) {}
+
+                    /**
+                     * @brief Consumer side: returns the next element, waiting for it if necessary.
+                     * 
+                     * @return Type 
+                     */
+                    Type front() override {
+                        if( this->_wait_available_() == 0ZU ) {
+                            throw std::runtime_error("SPSCQueueAdapter/front> No more elements in the queue!");
+                        }
+                        return this->ring[ this->head.load( std::memory_order_relaxed ) & this->mask ];
+                    }
+
+                    /**
+                     * @brief Producer side: returns the last pushed element.
+                     * 
+                     * @return Type 
+                     */
+                    Type back() override {
+                        const std::size_t t = this->tail.load( std::memory_order_relaxed );
+                        if( t == this->head.load( std::memory_order_acquire ) ) {
+                            throw std::runtime_error("SPSCQueueAdapter/back> No more elements in the queue!");
+                        }
+                        return this->ring[ ( t - 1ZU ) & this->mask ];
+                    }
+
+                    /**
+                     * @brief Producer side: pushes `v` if there is room.
+                     * 
+                     * @param v 
+                     * @return true if `v` was pushed.
+                     */
+                    inline bool try_push( const Type v ) {
+                        if( this->_free_slots_() == 0ZU ) {
+                            return false;
+                        }
+                        const std::size_t t = this->tail.load( std::memory_order_relaxed );
+                        this->ring[ t & this->mask ] = v;
+                        this->tail.store( t + 1ZU, std::memory_order_release );
+                        return true;
+                    }
+
+                    /**
+                     * @brief Producer side: pushes `v`, waiting for room if necessary.
+                     * 
+                     * @param v 
+                     */
+                    void push( Type v ) override {
+                        while( !this->try_push( v ) ) {
+                            std::this_thread::yield();
+                        }
+                    }
+
+                    /**
+                     * @brief Producer side: pushes `n` elements, publishing them in as few index updates as the free room allows.
+                     * 
+                     * @param v 
+                     * @param n 
+                     */
+                    void push_batch( const Type* v, const std::size_t n ) {
+                        std::size_t i = 0;
+                        while( i < n ) {
+                            const std::size_t m = std::min( this->_free_slots_(), n - i );
+                            if( m == 0ZU ) {
+                                std::this_thread::yield();
+                                continue;
+                            }
+                            const std::size_t t = this->tail.load( std::memory_order_relaxed );
+                            for( std::size_t x = 0; x < m; ++x ) {
+                                this->ring[ ( t + x ) & this->mask ] = v[i + x];
+                            }
+                            this->tail.store( t + m, std::memory_order_release );
+                            i += m;
+                        }
+                    }
+
+                    /**
+                     * @brief Consumer side: pops up to `n` elements into `out`, waiting until at least one is available.
+                     * 
+                     * @param out 
+                     * @param n 
+                     * @return std::size_t is the number of popped elements; 0 only when the queue is closed and drained (or `n` is 0).
+                     */
+                    std::size_t pop_batch( Type* out, const std::size_t n ) {
+                        if( n == 0ZU ) {
+                            return 0ZU;
+                        }
+                        const std::size_t m = std::min( this->_wait_available_(), n ),
+                                          h = this->head.load( std::memory_order_relaxed );
+                        for( std::size_t x = 0; x < m; ++x ) {
+                            out[x] = this->ring[ ( h + x ) & this->mask ];
+                        }
+                        this->head.store( h + m, std::memory_order_release );
+                        return m;
+                    }
+
+                    /**
+                     * @brief Returns whether the queue is currently empty; from the consumer side, more elements may still come until `is_closed()`.
+                     * 
+                     * @return true 
+                     * @return false 
+                     */
+                    bool empty() const override {
+                        return this->head.load( std::memory_order_acquire ) == this->tail.load( std::memory_order_acquire );
+                    }
+
+                    std::size_t size() const override {
+                        const std::size_t h = this->head.load( std::memory_order_acquire );
+                        return this->tail.load( std::memory_order_acquire ) - h;
+                    }
+
+                    /**
+                     * @brief Consumer side: discards the front element.
+                     * 
+                     */
+                    void pop() override {
+                        if( this->_available_() == 0ZU ) {
+                            throw std::runtime_error("SPSCQueueAdapter/pop> No more elements in the queue!");
+                        }
+                        this->head.store( this->head.load( std::memory_order_relaxed ) + 1ZU, std::memory_order_release );
+                    }
+
+                    std::size_t capacity() const {
+                        return this->ring.size();
+                    }
+
+                    /**
+                     * @brief Producer side: signals the end of the stream.
+                     * 
+                     */
+                    void close() {
+                        this->closed.store( true, std::memory_order_release );
+                    }
+
+                    bool is_closed() const {
+                        return this->closed.load( std::memory_order_acquire );
+                    }
+
+                    /**
+                     * @brief Returns whether the producer closed the queue and the consumer read everything.
+                     * 
+                     * @return true 
+                     * @return false 
+                     */
+                    bool is_drained() const {
+                        return this->is_closed() && this->empty();
+                    }
+            };
+
+            /**
+             * @brief Non-virtual FIFO queue over a power-of-two ring indexed with a mask. It offers the operations of `QueueAdapter` without dynamic dispatch, so codecs can hold it by value on their hot paths. The capacity doubles when a push finds it full.
+             * @note `front`, `back` and `pop` on an empty buffer are undefined; check `empty()` first.
+             * 
+             * @tparam Type 
+             */
+            template<typename Type> class RingBuffer {
+                private:
+                    std::vector<Type> ring;
+                    std::size_t mask, // ring.size() - 1.
+                                head, // Position of the front element; wrapped with `mask` on access.
+                                tail; // One past the position of the back element.
+
+                    void _grow_() {
+                        const std::size_t n = this->size();
+                        std::vector<Type> larger( this->ring.size() * 2ZU );
+                        for( std::size_t x = 0; x < n; ++x ) {
+                            larger[x] = this->ring[ ( this->head + x ) & this->mask ];
+                        }
+                        this->ring.swap( larger );
+                        this->mask = this->ring.size() - 1ZU;
+                        this->head = 0ZU;
+                        this->tail = n;
+                    }
+
+                public:
+                    /**
+                     * @brief Construct a new Ring Buffer object
+                     * 
+                     * @param capacity is rounded up to a power of two.
+                     */
+                    RingBuffer( const std::size_t capacity = 1024ZU ) :
+                        ring ( std::bit_ceil( std::max<std::size_t>( capacity, 2ZU ) ) ),
+                        mask ( ring.size() - 1ZU ),
+                        head ( 0ZU ),
+                        tail ( 0ZU ) {}
+
+                    inline Type front() const {
+                        assert( !this->empty() );
+                        return this->ring[ this->head & this->mask ];
+                    }
+
+                    inline Type back() const {
+                        assert( !this->empty() );
+                        return this->ring[ ( this->tail - 1ZU ) & this->mask ];
+                    }
+
+                    inline void push( const Type v ) {
+                        if( this->tail - this->head == this->ring.size() ) {
+                            this->_grow_();
+                        }
+                        this->ring[ ( this->tail++ ) & this->mask ] = v;
+                    }
+
+                    inline void pop() {
+                        assert( !this->empty() );
+                        ++(this->head);
+                    }
+
+                    inline bool empty() const {
+                        return this->head == this->tail;
+                    }
+
+                    inline std::size_t size() const {
+                        return this->tail - this->head;
+                    }
+
+                    inline std::size_t capacity() const {
+                        return this->ring.size();
+                    }
+
+                    inline void clear() {
+                        this->head = this->tail = 0ZU;
+                    }
+            };
+
             /**
              * @brief Creates an instance of `QueueAdapter`.
              * 
@@ -320,6 +638,8 @@ namespace samg {
                         return std::make_shared<QQueueAdapter<Type>>();
                     case QueueAdapterType::ITERATOR_QUEUEADAPTER:
                         return std::make_shared<IteratorQueueAdapter<Type>>(begin, end, rbegin);
+                    case QueueAdapterType::SPSC_QUEUEADAPTER:
+                        return std::make_shared<SPSCQueueAdapter<Type>>();
                     default:
                         throw std::runtime_error("adapter/get_instance> Non-implemented QueueAdapter!");
                 }
@@ -554,6 +874,36 @@ namespace samg {
                     return(v /*+ OFFSET_LOWEST_VALUE*/);   //1 was encoded as 0 ... v as v-1 ... !!
                 }
 
+                /**
+                 * @brief Accumulates the exact floor of the mean of a sequence as a quotient and a remainder, so that the sum never overflows.
+                 * 
+                 */
+                struct MeanAccumulator {
+                    const std::size_t n;
+                    std::uint64_t whole = 0ULL, // Sum of v / n.
+                                  rest = 0ULL; // Sum of v % n, kept below n.
+
+                    MeanAccumulator( const std::size_t n ) : n ( n ) {}
+
+                    inline void add( const std::uint64_t v ) {
+                        this->whole += v / this->n;
+                        this->rest += v % this->n;
+                        if( this->rest >= this->n ) {
+                            ++(this->whole);
+                            this->rest -= this->n;
+                        }
+                    }
+
+                    /**
+                     * @brief Returns floor(log2(mean)), or 0 if the mean is 0.
+                     * 
+                     * @return std::size_t 
+                     */
+                    std::size_t floorlog2() const {
+                        return ( this->whole == 0ULL ) ? 0ZU : (std::size_t) std::bit_width( this->whole ) - 1ZU;
+                    }
+                };
+
                 /**
                  * @brief Given a list of (n) integers (buff) [typically gap values from an inverted list], computes the optimal b parameter, that is, the number of bits that will be coded binary-wise from a given encoded value.
                  * @note $$ val = \lfloor (\log_2( \sum_{i=0}^{n-1} (diff[i])) / n )) \rfloor $$
@@ -561,381 +911,2249 @@ namespace samg {
                  * @param sequence 
                  * @return std::size_t 
                  */
-                static std::size_t compute_GR_parameter_for_list( std::vector<Word> sequence ) {
-                    Word total =0;
-                     std::size_t i;
-                    for ( i = 0; i < sequence.size(); i++ ) total += sequence[i];
-                    total /= sequence.size();
-                    std::size_t val;
-                    FLOORLOG_2(((uint)total),val);
-                    
-                    return val;
+                static std::size_t compute_GR_parameter_for_list( const std::vector<Word>& sequence ) {
+                    if( sequence.empty() ) {
+                        return 0ZU;
+                    }
+                    MeanAccumulator mean ( sequence.size() );
+                    for( const Word v : sequence ) {
+                        mean.add( v );
+                    }
+                    return mean.floorlog2();
                 }
 
                 /**
                  * @brief Given a list of (n) integers (buff) [typically gap values from an inverted list], computes the optimal b parameter, that is, the number of bits that will be coded binary-wise from a given encoded value.
                  * @note $$ val = \lfloor (\log_2( \sum_{i=0}^{n-1} (diff[i])) / n )) \rfloor $$
+                 * @note It empties `sequence`.
                  * 
                  * @param sequence 
                  * @return std::size_t 
                  */
                 static std::size_t compute_GR_parameter_for_list( adapter::QueueAdapter<Word>& sequence ) {
-                    Word total =0;
-                     std::size_t i;
+                    if( sequence.empty() ) {
+                        return 0ZU;
+                    }
+                    MeanAccumulator mean ( sequence.size() );
                     while( !(sequence.empty()) ) {
-                        total += sequence.front(); sequence.pop();
+                        mean.add( sequence.front() ); sequence.pop();
                     }
-                    total /= sequence.size();
-                    std::size_t val;
-                    FLOORLOG_2(((uint)total),val);
-                    
-                    return val;
+                    return mean.floorlog2();
                 }
-            };
-
-            template<typename Word> struct RunLengthCommon {
-                using rseq_t = std::int64_t; //typedef unsigned long long int rseq_t; // Data type internally used by the relative sequence. It can be changed here to reduce memory footprint in case numbers in a relative sequence are small enough to fit in fewer bits.  
-                
-                template<typename TypeInt = rseq_t> using RelativeSequence = std::shared_ptr<samg::grcodec::adapter::QueueAdapter<TypeInt>>;
-                
-                template<typename TypeUInt = Word> using AbsoluteSequence = std::shared_ptr<samg::grcodec::adapter::QueueAdapter<TypeUInt>>;
-                
-
-                static const std::size_t    RLE_THRESHOLD = 3,     // Minimum number of repetitions to be compressed.
-                                            ESCAPE_RANGE_SPAN = 2; // Range span to reserve integers as special symbols (e.g. negative flag, repetition mark).
-                
-                static const Word   NEGATIVE_FLAG = 0,
-                                    REPETITION_FLAG = 1;
 
-                static const bool   IS_NEGATIVE = true;
-                
                 /**
-                 * @brief This function allows generating a gap centered in 0. The result is a value that belongs to either (-inf,-RunLengthCommon<Word>::ESCAPE_RANGE_SPAN+1] or [RunLengthCommon<Word>::ESCAPE_RANGE_SPAN,inf). This transformation of v allows to release values in [-RunLengthCommon<Word>::ESCAPE_RANGE_SPAN,RunLengthCommon<Word>::ESCAPE_RANGE_SPAN-1] to be used as scape symbols during encoding/decoding of, for instance, negative values.
+                 * @brief Returns the number of bits taken by the Rice codes of order `k` of `values`.
                  * 
-                 * @param v 
-                 * @return rseq_t 
+                 * @param values 
+                 * @param n 
+                 * @param k 
+                 * @return std::size_t 
                  */
-                static rseq_t transform_rval( rseq_t v ) {
-                    return v >= 0 ? v + RunLengthCommon<Word>::ESCAPE_RANGE_SPAN : v - RunLengthCommon<Word>::ESCAPE_RANGE_SPAN; // Transform relative value. 
+                static std::size_t rice_cost( const Word* values, const std::size_t n, const std::size_t k ) {
+                    std::size_t cost = n * ( k + 1ZU );
+                    for( std::size_t i = 0; i < n; ++i ) {
+                        cost += (std::uint64_t) values[i] >> k;
+                    }
+                    return cost;
                 }
 
                 /**
-                 * @brief This function allows recovering an original value transformed by `transform_rval`.
+                 * @brief Returns the Rice order that minimizes the encoded size of `values`, together with that size in bits.
+                 * @note The cost is convex in k (its forward differences never decrease), so it walks from the mean-based estimate to the minimum.
                  * 
-                 * @param v 
-                 * @return rseq_t 
+                 * @param values 
+                 * @param n 
+                 * @return std::pair<std::size_t,std::size_t> 
                  */
-                static rseq_t recover_rval( rseq_t v ) {
-                    return v < 0 ? v + RunLengthCommon<Word>::ESCAPE_RANGE_SPAN : v - RunLengthCommon<Word>::ESCAPE_RANGE_SPAN; // Recover relative value.
+                static std::pair<std::size_t,std::size_t> optimal_rice_parameter( const Word* values, const std::size_t n ) {
+                    if( n == 0ZU ) {
+                        return std::make_pair( 0ZU, 0ZU );
+                    }
+                    MeanAccumulator mean ( n );
+                    for( std::size_t i = 0; i < n; ++i ) {
+                        mean.add( values[i] );
+                    }
+                    const std::size_t MAX_K = std::min( GolombRiceCommon::WORD_bits, 64ZU ) - 1ZU;
+                    std::size_t k = std::min( mean.floorlog2(), MAX_K ),
+                                cost = GolombRiceCommon::rice_cost( values, n, k );
+                    while( k > 0ZU ) {
+                        const std::size_t c = GolombRiceCommon::rice_cost( values, n, k - 1ZU );
+                        if( c >= cost ) {
+                            break;
+                        }
+                        cost = c;
+                        --k;
+                    }
+                    while( k < MAX_K ) {
+                        const std::size_t c = GolombRiceCommon::rice_cost( values, n, k + 1ZU );
+                        if( c >= cost ) {
+                            break;
+                        }
+                        cost = c;
+                        ++k;
+                    }
+                    return std::make_pair( k, cost );
                 }
+            };
 
-                /**
-                 * @brief This function allows converting a sequence of unsigned Word integers into a relative sequence of signed integers by computing their sequential differences. The resultant sequence is transformed in the process to prevent the number 0 that is used to represent negative integers when numbers are encoded with variable-length integers.  
-                 * 
-                 * @param sequence 
-                 * @return RelativeSequence 
-                 */
-                static RelativeSequence<> get_transformed_relative_sequence( AbsoluteSequence<> sequence ) {
-                    RelativeSequence<> ans = adapter::get_instance<rseq_t>( adapter::QueueAdapterType::Q_QUEUEADAPTER );
-                    // std::cout << sequence.size() << std::endl;
-                    // if( sequence.size() > 0 ) {
-                    if( !sequence.empty() ) {
-                        /* NOTE
-                            1 3 3 6  5  0 0 5
-                            1 2 0 3 -1 -5 0 5 <--- Original relative values.
-                            2 3 1 4 -1 -5 1 6 <--- transformed relative values.
-                        */
-                        Word    current,
-                                previous = sequence.front();
-                            
-                        sequence.pop();
+            /**
+             * @brief Lookup table that decodes every complete Rice codeword of order k found in a WINDOW_BITS-bit window with a single lookup. Each entry holds the number of complete codewords, their values, and the number of bits they span.
+             * @note Codewords longer than the window yield an empty entry, so callers fall back to the bitwise decoder for them.
+             * 
+             * @tparam WINDOW_BITS 
+             */
+            template<std::size_t WINDOW_BITS = 12ZU> class RiceTable {
+                static_assert( WINDOW_BITS >= 8ZU && WINDOW_BITS <= 16ZU, "WINDOW_BITS must be in [8,16]" );
+                public:
+                    static constexpr std::size_t    MAX_K = 4ZU, // Beyond this order a window rarely holds more than one codeword.
+                                                    WINDOW_MASK = ( 1ZU << WINDOW_BITS ) - 1ZU;
+                private:
+                    const std::size_t k,
+                                      max_codes; // Maximum number of codewords per window, i.e., WINDOW_BITS / (k+1).
+                    std::vector<std::uint8_t> counts,
+                                              consumed;
+                    std::vector<std::uint16_t> values; // `max_codes` slots per entry.
 
-                        ans->push( transform_rval( previous ));
-                        // ans.push_back( transform_rval( sequence[0] ) );
-                        while( !sequence->empty() ) {
-                            current = sequence.front(); sequence.pop();
-                            // std::cout << current << std::endl;
-                            // ans.push( transform_rval( ((rseq_t)(current)) - ((rseq_t)(previous)) ) );
-                            ans->push( RunLengthCommon<Word>::get_transformed_relative_sequence( current, previous ));
-                            previous = current;
+                public:
+                    RiceTable( const std::size_t k ) :
+                        k ( k ),
+                        max_codes ( WINDOW_BITS / ( k + 1ZU ) ),
+                        counts ( 1ZU << WINDOW_BITS, 0 ),
+                        consumed ( 1ZU << WINDOW_BITS, 0 ),
+                        values ( ( 1ZU << WINDOW_BITS ) * ( WINDOW_BITS / ( k + 1ZU ) ), 0 ) {
+                        if( k > RiceTable::MAX_K ) {
+                            throw std::invalid_argument("RiceTable> k = "+std::to_string(k)+" is larger than "+std::to_string(RiceTable::MAX_K)+".");
+                        }
+                        for( std::size_t w = 0; w <= RiceTable::WINDOW_MASK; ++w ) {
+                            std::size_t p = 0, c = 0;
+                            while( p + k < WINDOW_BITS ) {
+                                const std::size_t r = ( w >> p ) & ( ( 1ZU << k ) - 1ZU ),
+                                                  q = std::countr_one( (std::uint32_t) ( w >> ( p + k ) ) );
+                                if( p + k + q >= WINDOW_BITS ) {
+                                    break; // The terminating 0 lies beyond the window.
+                                }
+                                this->values[ w * this->max_codes + c++ ] = (std::uint16_t) ( r + ( q << k ) );
+                                p += k + q + 1ZU;
+                            }
+                            this->counts[w] = (std::uint8_t) c;
+                            this->consumed[w] = (std::uint8_t) p;
                         }
-                        // for (std::size_t i = 1; i < sequence.size(); ++i) {
-                        //     ans.push_back( transform_rval( ((rseq_t)(sequence[i])) - ((rseq_t)(sequence[i-1])) ) );
-                        // }
                     }
-                    return ans;
-                }
-                /**
-                 * @brief This function converts `current` into a relative value given `previous`.
-                 * 
-                 * @param previous 
-                 * @param current 
-                 * @return rseq_t 
-                 */
-                static rseq_t get_transformed_relative_sequence( rseq_t relativa_previous, rseq_t relativa_current ) {
-                    rseq_t ans = transform_rval( relativa_current - relativa_previous );
-                //  std::cout << "\t\tRiceRuns / get_transformed_relative_sequence> relativa_previous = " << relativa_previous << "; relativa_current = " << relativa_current << "; ans = " << ans << std::endl;
-                    return ans;
-                }
 
-                /**
-                 * @brief This function allows converting a relative sequence of sequential differences encoded as signed integers into an absolute sequence of unsigned Word integers. The resultant sequence is transformed in the process to revert previous transformation when relativization was applied by `get_transformed_relative_sequence` function.
-                 * 
-                 * @param relative_sequence 
-                 * @return AbsoluteSequence
-                 * 
-                 * @warning Side effects on input!
-                 */
-                static AbsoluteSequence<> get_transformed_absolute_sequence( RelativeSequence<>& sequence ) {
-                    AbsoluteSequence<> ans = adapter::get_instance<Word>( adapter::QueueAdapterType::Q_QUEUEADAPTER );
+                    inline std::size_t get_k() const {
+                        return this->k;
+                    }
 
-                    // if( relative_sequence.size() > 0 ) {
-                    if( !sequence->empty() ) {
-                        /* NOTE
-                            1 3 3 6  5  0 0 5 <--- Original absolute values.
-                            1 2 0 3 -1 -5 0 5 <--- Original relative values.
-                            2 3 1 4 -1 -5 1 6 <--- Transformed relative values.
-                            1 2 0 3 -1 -5 0 5 <--- Recovered relative values.
-                            1 3 3 6  5  0 0 5 <--- Recovered absolute values.
+                    inline std::size_t get_max_codes() const {
+                        return this->max_codes;
+                    }
 
-                        */
-                        ans->push( recover_rval( sequence->front() ));
-                        sequence->pop();
-                        // ans.push_back( recover_rval( relative_sequence[0] ) );
-                        // for (std::size_t i = 1; i < sequence.size(); ++i) {
-                        while( !sequence->empty() ){
-                            ans->push( ((rseq_t)ans->back()) + recover_rval( sequence->front() ) );
-                            sequence->pop();
-                        }
+                    inline std::size_t count( const std::uint64_t window ) const {
+                        return this->counts[ window & RiceTable::WINDOW_MASK ];
                     }
-                    return ans; //.release();
-                }
 
+                    inline std::size_t bits( const std::uint64_t window ) const {
+                        return this->consumed[ window & RiceTable::WINDOW_MASK ];
+                    }
+
+                    inline const std::uint16_t* codes( const std::uint64_t window ) const {
+                        return this->values.data() + ( window & RiceTable::WINDOW_MASK ) * this->max_codes;
+                    }
             };
-        
-            // template<typename Word> struct Batch {
-            //     /**
-            //      * @brief Encodes in a batch the content of a QueueAdapter.
-            //      * 
-            //      * @param codec 
-            //      * @param queue 
-            //      */
-            //     static void batch_encode( samg::grcodec::base::writer::CodecFileWriter<Word>& codec, samg::grcodec::adapter::QueueAdapter<Word>& queue ) {
-            //         while( !queue.empty() ) {
-            //             codec.add( queue.front() );
-            //             queue.pop();
-            //         }
-            //     }
-            // };
-        }
 
-        namespace base {
+            /**
+             * @brief Buffered bit reader for LSB-first bitmaps. It keeps a padded block of bytes refilled in bulk from a serializer, so that any position can be peeked as a 64-bit window with a single unaligned load. 
+             * @note Bit i of the bitmap is bit (i % 8) of byte (i / 8), which holds for any `Word` on little-endian machines.
+             * 
+             * @tparam Serializer provides `read_bytes(std::uint8_t*, std::size_t)` (e.g., `OfflineWordReader` or `OnlineWordReader`).
+             */
+            template<typename Serializer> class BitBuffer {
+                private:
+                    static constexpr std::size_t    BLOCK_BYTES = 1ZU << 15, // Bytes fetched per refill.
+                                                    PADDING_BYTES = 16ZU; // Zeroed slack after the valid bytes, so peeks never read out of bounds.
+                    Serializer* source;
+                    std::vector<std::uint8_t> block;
+                    std::size_t head, // Bit position within `block`.
+                                filled, // Valid bytes in `block`.
+                                base; // Absolute bit position of `block[0]`.
+                    bool exhausted;
+
+                    /**
+                     * @brief Slides the unread bytes to the front of the block and appends fresh ones from the source.
+                     * 
+                     */
+                    void _refill_() {
+                        const std::size_t from = std::min( this->head >> 3, this->filled ),
+                                          keep = this->filled - from;
+                        std::memmove( this->block.data(), this->block.data() + from, keep );
+                        this->base += from << 3;
+                        this->head -= from << 3;
+                        this->filled = keep;
+                        if( !this->exhausted ) {
+                            const std::size_t n = this->source->read_bytes( this->block.data() + this->filled, BitBuffer::BLOCK_BYTES - this->filled );
+                            this->filled += n;
+                            this->exhausted = this->filled < BitBuffer::BLOCK_BYTES;
+                        }
+                        std::memset( this->block.data() + this->filled, 0, BitBuffer::PADDING_BYTES );
+                    }
+
+                public:
+                    BitBuffer() :
+                        source ( nullptr ),
+                        block ( BitBuffer::BLOCK_BYTES + BitBuffer::PADDING_BYTES, 0 ),
+                        head ( 0ZU ),
+                        filled ( 0ZU ),
+                        base ( 0ZU ),
+                        exhausted ( true ) {}
+
+                    /**
+                     * @brief Starts reading from `source`, whose cursor must be at the byte that holds absolute bit `bit_position`.
+                     * 
+                     * @param source 
+                     * @param bit_position 
+                     */
+                    void reset( Serializer* source, const std::size_t bit_position ) {
+                        this->source = source;
+                        this->base = bit_position & ~7ZU;
+                        this->head = bit_position & 7ZU;
+                        this->filled = 0ZU;
+                        this->exhausted = false;
+                        std::memset( this->block.data(), 0, BitBuffer::PADDING_BYTES );
+                    }
+
+                    /**
+                     * @brief Returns the absolute bit position of the next unread bit.
+                     * 
+                     * @return std::size_t 
+                     */
+                    inline std::size_t tell() const {
+                        return this->base + this->head;
+                    }
+
+                    /**
+                     * @brief Moves to absolute bit `bit_position` if its byte is already buffered.
+                     * 
+                     * @param bit_position 
+                     * @return true if the position was reached without touching the source; otherwise, the caller must seek the source and `reset()`.
+                     */
+                    inline bool jump( const std::size_t bit_position ) {
+                        if( bit_position < this->base || ( ( bit_position - this->base ) >> 3 ) >= this->filled ) {
+                            return false;
+                        }
+                        this->head = bit_position - this->base;
+                        return true;
+                    }
+
+                    /**
+                     * @brief Guarantees that the next 64 bits can be peeked (bits past the end of the source read as 0).
+                     * 
+                     */
+                    inline void ensure() {
+                        if( ( this->head >> 3 ) + sizeof(std::uint64_t) > this->filled && !this->exhausted ) {
+                            this->_refill_();
+                        }
+                    }
+
+                    /**
+                     * @brief Returns the bits starting at the current position; only the lowest `64 - (tell() % 8)` bits are valid (at least 57), the rest are 0.
+                     * @note Call `ensure()` first.
+                     * 
+                     * @return std::uint64_t 
+                     */
+                    inline std::uint64_t peek() const {
+                        std::uint64_t x;
+                        std::memcpy( &x, this->block.data() + ( this->head >> 3 ), sizeof(x) );
+                        return x >> ( this->head & 7ZU );
+                    }
+
+                    inline void skip( const std::size_t nbits ) {
+                        this->head += nbits;
+                    }
+
+                    /**
+                     * @brief Reads `len` bits (len <= 64).
+                     * 
+                     * @param len 
+                     * @return std::uint64_t 
+                     */
+                    inline std::uint64_t read( const std::size_t len ) {
+                        this->ensure();
+                        if( len <= 56 ) {
+                            const std::uint64_t v = this->peek() & ( ( 1ULL << len ) - 1ULL );
+                            this->head += len;
+                            return v;
+                        }
+                        const std::uint64_t lo = this->peek() & 0xFFFFFFFFULL;
+                        this->head += 32;
+                        this->ensure();
+                        const std::uint64_t hi = this->peek() & ( ( 1ULL << ( len - 32 ) ) - 1ULL );
+                        this->head += len - 32;
+                        return lo | ( hi << 32 );
+                    }
+
+                    /**
+                     * @brief Reads a run of 1s terminated by a 0 and returns its length (the terminating 0 is consumed too). Each step resolves up to 57 bits with a single `countr_one`.
+                     * 
+                     * @return std::uint64_t 
+                     */
+                    inline std::uint64_t read_unary() {
+                        std::uint64_t q = 0ULL;
+                        for(;;) {
+                            this->ensure();
+                            const std::size_t valid = 64ZU - ( this->head & 7ZU );
+                            const std::size_t ones = std::countr_one( this->peek() );
+                            if( ones < valid ) {
+                                this->head += ones + 1;
+                                return q + ones;
+                            }
+                            q += valid;
+                            this->head += valid;
+                        }
+                    }
+
+                    /**
+                     * @brief Decodes a Rice codeword of order k: k remainder bits followed by the quotient in unary.
+                     * 
+                     * @tparam Word 
+                     * @param k 
+                     * @return Word 
+                     */
+                    template<typename Word> inline Word read_rice( const std::size_t k ) {
+                        this->ensure();
+                        const std::size_t valid = 64ZU - ( this->head & 7ZU );
+                        if( k < valid ) { // Fast path: the whole codeword lies within one peeked window.
+                            const std::uint64_t x = this->peek();
+                            const std::size_t ones = std::countr_one( x >> k );
+                            if( ones < valid - k ) {
+                                this->head += k + ones + 1;
+                                return (Word) ( ( x & ( ( 1ULL << k ) - 1ULL ) ) + ( ( (std::uint64_t) ones ) << k ) );
+                            }
+                        }
+                        const std::uint64_t r = ( k == 0 ) ? 0ULL : this->read( k );
+                        return (Word) ( r + ( this->read_unary() << k ) );
+                    }
+
+                    /**
+                     * @brief Reads a run of 0s terminated by a 1 and returns its length (the terminating 1 is consumed too). Each step resolves up to 57 bits with a single `countr_zero`.
+                     * @note Exp-Golomb and Elias codewords start with at most 64 zeros, so longer runs (a corrupted bitmap or a read past its end) throw.
+                     *
+                     * @return std::size_t
+                     */
+                    inline std::size_t read_zero_run() {
+                        std::size_t z = 0ZU;
+                        for(;;) {
+                            this->ensure();
+                            const std::size_t valid = 64ZU - ( this->head & 7ZU );
+                            const std::size_t zeros = std::countr_zero( this->peek() );
+                            if( zeros < valid ) {
+                                this->head += zeros + 1;
+                                return z + zeros;
+                            }
+                            z += valid;
+                            this->head += valid;
+                            if( z > 64ZU ) {
+                                throw std::runtime_error("BitBuffer/read_zero_run> More than 64 leading zeros; the bitmap is corrupted or exhausted.");
+                            }
+                        }
+                    }
+
+                    /**
+                     * @brief Decodes an Exp-Golomb codeword of order k (see `BitWriter::put_exp_golomb`).
+                     *
+                     * @tparam Word
+                     * @param k
+                     * @return Word
+                     */
+                    template<typename Word> inline Word read_exp_golomb( const std::size_t k ) {
+                        this->ensure();
+                        const std::size_t valid = 64ZU - ( this->head & 7ZU );
+                        const std::uint64_t x = this->peek();
+                        const std::size_t zeros = std::countr_zero( x );
+                        if( 2ZU * zeros + k + 1ZU <= valid ) { // Fast path: the whole codeword lies within one peeked window (so n < 64).
+                            const std::size_t n = zeros + k;
+                            this->head += zeros + 1ZU + n;
+                            return (Word) ( ( ( x >> ( zeros + 1ZU ) ) & ( ( 1ULL << n ) - 1ULL ) ) + ( 1ULL << n ) - ( 1ULL << k ) );
+                        }
+                        const std::size_t n = this->read_zero_run() + k;
+                        if( n > 64ZU ) {
+                            throw std::runtime_error("BitBuffer/read_exp_golomb> Codeword of "+std::to_string(n)+" value bits does not fit 64 bits.");
+                        }
+                        const std::uint64_t low = this->read( n );
+                        return (Word) ( low + ( ( n >= 64ZU ) ? 0ULL : 1ULL << n ) - ( 1ULL << k ) );
+                    }
+
+                    /**
+                     * @brief Decodes an Elias-gamma codeword (see `BitWriter::put_elias_gamma`).
+                     *
+                     * @tparam Word
+                     * @return Word
+                     */
+                    template<typename Word> inline Word read_elias_gamma() {
+                        return this->template read_exp_golomb<Word>( 0ZU );
+                    }
+
+                    /**
+                     * @brief Decodes an Elias-delta codeword (see `BitWriter::put_elias_delta`).
+                     *
+                     * @tparam Word
+                     * @return Word
+                     */
+                    template<typename Word> inline Word read_elias_delta() {
+                        this->ensure();
+                        const std::size_t valid = 64ZU - ( this->head & 7ZU );
+                        const std::uint64_t x = this->peek();
+                        const std::size_t zeros = std::countr_zero( x );
+                        if( 2ZU * zeros + 1ZU <= valid ) { // Fast path for the length prefix; zeros < 32.
+                            const std::size_t prefix = 2ZU * zeros + 1ZU,
+                                              n = (std::size_t) ( ( ( x >> ( zeros + 1ZU ) ) & ( ( 1ULL << zeros ) - 1ULL ) ) + ( 1ULL << zeros ) - 1ULL );
+                            if( prefix + n <= valid ) { // ... and for the value bits.
+                                this->head += prefix + n;
+                                return (Word) ( ( ( x >> prefix ) & ( ( 1ULL << n ) - 1ULL ) ) + ( 1ULL << n ) - 1ULL );
+                            }
+                        }
+                        const std::uint64_t n = this->template read_exp_golomb<std::uint64_t>( 0ZU );
+                        if( n > 64ULL ) {
+                            throw std::runtime_error("BitBuffer/read_elias_delta> Codeword of "+std::to_string(n)+" value bits does not fit 64 bits.");
+                        }
+                        const std::uint64_t low = this->read( n );
+                        return (Word) ( low + ( ( n >= 64ULL ) ? 0ULL : 1ULL << n ) - 1ULL );
+                    }
+
+                    /**
+                     * @brief Decodes Rice codewords of order k into `out` until `n` values are written or absolute bit `limit` is reached. When `table` is given, windows are decoded several codewords at a time.
+                     * 
+                     * @tparam Word 
+                     * @tparam Table is a `RiceTable` instance type.
+                     * @param out 
+                     * @param n 
+                     * @param k 
+                     * @param limit 
+                     * @param table may be null.
+                     * @return std::size_t is the number of decoded values.
+                     */
+                    template<typename Word, typename Table> std::size_t read_rice_block( Word* out, const std::size_t n, const std::size_t k, const std::size_t limit, const Table* table ) {
+                        std::size_t i = 0;
+                        if( table != nullptr ) {
+                            const std::size_t max_codes = table->get_max_codes();
+                            // The whole window must lie before `limit` (padding would decode as spurious zeros) and `out` must fit a full entry.
+                            while( i + max_codes <= n && this->tell() + Table::WINDOW_MASK + 1ZU <= limit ) {
+                                this->ensure();
+                                const std::uint64_t window = this->peek();
+                                const std::size_t c = table->count( window );
+                                if( c == 0 ) {
+                                    out[i++] = this->template read_rice<Word>( k );
+                                    continue;
+                                }
+                                const std::uint16_t* codes = table->codes( window );
+                                for( std::size_t j = 0; j < max_codes; ++j ) { // Fixed trip count; slots past `c` are scratch.
+                                    out[i + j] = (Word) codes[j];
+                                }
+                                i += c;
+                                this->head += table->bits( window );
+                            }
+                        }
+                        for(; i < n && this->tell() < limit; ++i ) {
+                            out[i] = this->template read_rice<Word>( k );
+                        }
+                        return i;
+                    }
+            };
 
             /**
-             * @brief Interface for classes that handle metadata.
+             * @brief Buffered bit writer for LSB-first bitmaps, the counterpart of `BitBuffer`. Bits are packed into a 64-bit accumulator that spills into a byte block, handed to the serializer with a single call when full.
              * 
+             * @tparam Serializer provides `add_bytes(const std::uint8_t*, std::size_t)` (e.g., `OfflineWordWriter`).
              */
-            class MetadataKeeper { 
+            template<typename Serializer> class BitWriter {
+                private:
+                    static constexpr std::size_t BLOCK_BYTES = 1ZU << 16; // Output block size; a multiple of 8 bytes so the accumulator always spills whole.
+                    Serializer* target;
+                    std::uint64_t accumulator; // Pending bits, LSB-first.
+                    std::size_t accumulator_bits, // Number of pending bits in `accumulator` (always < 64).
+                                block_fill; // Bytes used in `block`.
+                    std::vector<std::uint8_t> block;
+
                 public:
+                    BitWriter() :
+                        target ( nullptr ),
+                        accumulator ( 0ULL ),
+                        accumulator_bits ( 0ZU ),
+                        block_fill ( 0ZU ),
+                        block ( BitWriter::BLOCK_BYTES ) {}
+
+                    void reset( Serializer* target ) {
+                        this->target = target;
+                        this->accumulator = 0ULL;
+                        this->accumulator_bits = 0ZU;
+                        this->block_fill = 0ZU;
+                    }
+
                     /**
-                     * @brief Returnst the metadata.
+                     * @brief Appends the lowest `len` bits of `bits` (len <= 64; higher bits must be 0).
                      * 
-                     * @return const std::vector<std::size_t> 
+                     * @param bits 
+                     * @param len 
                      */
-                    virtual const std::vector<std::size_t> get_metadata() const = 0;
+                    inline void put( const std::uint64_t bits, const std::size_t len ) {
+                        this->accumulator |= bits << this->accumulator_bits;
+                        if( this->accumulator_bits + len < 64ZU ) {
+                            this->accumulator_bits += len;
+                            return;
+                        }
+                        // Spill the full accumulator into the block:
+                        std::memcpy( this->block.data() + this->block_fill, &(this->accumulator), sizeof(std::uint64_t) );
+                        this->block_fill += sizeof(std::uint64_t);
+                        if( this->block_fill == BitWriter::BLOCK_BYTES ) {
+                            this->target->add_bytes( this->block.data(), this->block_fill );
+                            this->block_fill = 0ZU;
+                        }
+                        const std::size_t used = 64ZU - this->accumulator_bits;
+                        this->accumulator = ( used < 64ZU ) ? bits >> used : 0ULL;
+                        this->accumulator_bits = this->accumulator_bits + len - 64ZU;
+                    }
 
                     /**
-                     * @brief Adds a new metadata at the end of the metadata list.
+                     * @brief Appends the Rice code of order `k` (k < 64) of `v`.
                      * 
                      * @param v 
+                     * @param k 
+                     * @return std::size_t is the codeword length in bits.
                      */
-                    virtual void add_metadata( std::size_t v ) = 0;
+                    inline std::size_t put_rice( const std::uint64_t v, const std::size_t k ) {
+                        const std::uint64_t r = v & ( ( 1ULL << k ) - 1ULL );
+                        std::uint64_t q = v >> k;
+                        const std::size_t len = k + q + 1ZU;
+                        if( k + q < 64ZU ) { // Common case: remainder, unary quotient and its terminating 0 in a single put.
+                            this->put( r | ( ( ( 1ULL << q ) - 1ULL ) << k ), len );
+                        } else {
+                            this->put( r, k );
+                            for(; q >= 64ZU; q -= 64ZU ) {
+                                this->put( ~0ULL, 64ZU );
+                            }
+                            this->put( ( 1ULL << q ) - 1ULL, q + 1ZU );
+                        }
+                        return len;
+                    }
 
                     /**
-                     * @brief Adds a new metadata at the beginning of the metadata list.
+                     * @brief Appends the Exp-Golomb code of order `k` (k < 64) of `v`: with x = v + 2^k and n = floor(log2(x)), n - k zeros, a 1, and the low n bits of x.
+                     * @note The zero run comes first so that `BitBuffer::read_exp_golomb` resolves the length with a single `countr_zero`. x = 2^64 (n = 64) is handled for the largest values.
+                     *
+                     * @param v
+                     * @param k
+                     * @return std::size_t is the codeword length in bits.
+                     */
+                    inline std::size_t put_exp_golomb( const std::uint64_t v, const std::size_t k ) {
+                        const std::uint64_t x = v + ( 1ULL << k ); // Wraps around when v + 2^k = 2^64 or more.
+                        const std::size_t n = ( x < v ) ? 64ZU : (std::size_t) std::bit_width( x ) - 1ZU,
+                                          zeros = n - k,
+                                          len = zeros + 1ZU + n;
+                        if( len <= 64ZU ) { // Common case: the whole codeword in a single put (n < 64 here).
+                            this->put( ( ( ( x & ( ( 1ULL << n ) - 1ULL ) ) << 1 ) | 1ULL ) << zeros, len );
+                        } else {
+                            this->put( 0ULL, zeros );
+                            this->put( 1ULL, 1ZU );
+                            this->put( ( n >= 64ZU ) ? x : x & ( ( 1ULL << n ) - 1ULL ), n );
+                        }
+                        return len;
+                    }
+
+                    /**
+                     * @brief Appends the Elias-gamma code of v + 1, i.e., the Exp-Golomb code of order 0 of `v`.
+                     *
+                     * @param v
+                     * @return std::size_t is the codeword length in bits.
+                     */
+                    inline std::size_t put_elias_gamma( const std::uint64_t v ) {
+                        return this->put_exp_golomb( v, 0ZU );
+                    }
+
+                    /**
+                     * @brief Appends the Elias-delta code of x = v + 1: the Elias-gamma code of n + 1, with n = floor(log2(x)), followed by the low n bits of x.
+                     *
+                     * @param v
+                     * @return std::size_t is the codeword length in bits.
+                     */
+                    inline std::size_t put_elias_delta( const std::uint64_t v ) {
+                        const std::uint64_t x = v + 1ULL;
+                        const std::size_t n = ( x == 0ULL ) ? 64ZU : (std::size_t) std::bit_width( x ) - 1ZU;
+                        const std::size_t len = this->put_exp_golomb( n, 0ZU );
+                        this->put( ( n >= 64ZU ) ? 0ULL : x & ( ( 1ULL << n ) - 1ULL ), n );
+                        return len + n;
+                    }
+
+                    /**
+                     * @brief Writes pending bits, padded with zeros up to a multiple of `alignment` bytes.
                      * 
-                     * @param v 
+                     * @param alignment 
                      */
-                    virtual void push_metadata( std::size_t v ) = 0;
+                    void flush( const std::size_t alignment ) {
+                        const std::size_t pending_bytes = ( this->accumulator_bits + 7ZU ) / 8ZU;
+                        std::memcpy( this->block.data() + this->block_fill, &(this->accumulator), pending_bytes );
+                        this->block_fill += pending_bytes;
+                        while( this->block_fill % alignment != 0ZU ) {
+                            this->block[ this->block_fill++ ] = 0;
+                        }
+                        if( this->block_fill > 0ZU ) {
+                            this->target->add_bytes( this->block.data(), this->block_fill );
+                        }
+                        this->block_fill = 0ZU;
+                        this->accumulator = 0ULL;
+                        this->accumulator_bits = 0ZU;
+                    }
             };
 
             /**
-             * @brief Partial implementation of MetadataKeeper.
+             * @brief In-memory byte sink for `BitWriter`; bytes are appended to a caller-owned vector.
              * 
              */
-            class MetadataSaver : public MetadataKeeper {
-                protected:
-                    std::vector<std::size_t> metadata;
+            class ByteVectorWriter {
+                private:
+                    std::vector<std::uint8_t>& bytes;
                 public:
-                    void add_metadata( std::size_t v ) override {
-                        this->metadata.push_back( v );
-                        // std::cout << "Codec/add_metadata> v = " << v << "; |metadata| = " << this->metadata.size() << "; @ " << (&(this->metadata)) << std::endl;
+                    ByteVectorWriter( std::vector<std::uint8_t>& bytes ) :
+                        bytes ( bytes ) {}
+
+                    void add_bytes( const std::uint8_t* v, const std::size_t length ) {
+                        this->bytes.insert( this->bytes.end(), v, v + length );
                     }
+            };
 
-                    void push_metadata( std::size_t v ) override {
-                        this->metadata.insert( this->metadata.begin(), v );
-                        // this->push_metadata(v);
-                        // std::cout << "Codec/push_metadata> v = " << v << "; |metadata| = " << this->metadata.size() << "; @ " << (&(this->metadata)) << std::endl;
+            /**
+             * @brief In-memory byte source for `BitBuffer`, the counterpart of `ByteVectorWriter`; bytes are read from a caller-owned array.
+             *
+             */
+            class ByteArrayReader {
+                private:
+                    const std::uint8_t* bytes;
+                    std::size_t length,
+                                position;
+                public:
+                    ByteArrayReader( const std::uint8_t* bytes, const std::size_t length ) :
+                        bytes ( bytes ),
+                        length ( length ),
+                        position ( 0ZU ) {}
+
+                    std::size_t read_bytes( std::uint8_t* out, const std::size_t n ) {
+                        const std::size_t m = std::min( n, this->length - this->position );
+                        if( m > 0ZU ) {
+                            std::memcpy( out, this->bytes + this->position, m );
+                        }
+                        this->position += m;
+                        return m;
                     }
             };
 
-            template<typename Word> class Codec {
-                static_assert(
-                    std::is_same_v<Word, std::uint8_t> ||
-                    std::is_same_v<Word, std::uint16_t> ||
-                    std::is_same_v<Word, std::uint32_t> ||
-                    std::is_same_v<Word, std::uint64_t>,
-                    "typename must be one of std::uint8_t, std::uint16_t, std::uint32_t, or std::uint64_t"); 
+            /**
+             * @brief Universal codes available to `universal::writer::OfflineUniversalCodecWriter` and `universal::reader::OfflineUniversalCodecReader`. The type is recorded in the metadata tail.
+             *
+             */
+            enum UniversalCodeType {
+                EXP_GOLOMB,
+                ELIAS_GAMMA,
+                ELIAS_DELTA
+            };
+
+            /**
+             * @brief Exp-Golomb code of order k (k < 64).
+             *
+             */
+            struct ExpGolombCode {
+                static constexpr UniversalCodeType TYPE = UniversalCodeType::EXP_GOLOMB;
+                static constexpr bool HAS_ORDER = true;
+
+                template<typename Serializer> static inline std::size_t put( BitWriter<Serializer>& bits, const std::uint64_t v, const std::size_t k ) {
+                    return bits.put_exp_golomb( v, k );
+                }
+
+                template<typename Word, typename Serializer> static inline Word get( BitBuffer<Serializer>& bits, const std::size_t k ) {
+                    return bits.template read_exp_golomb<Word>( k );
+                }
+            };
+
+            /**
+             * @brief Elias-gamma code of v + 1; it takes no order (k must be 0).
+             *
+             */
+            struct EliasGammaCode {
+                static constexpr UniversalCodeType TYPE = UniversalCodeType::ELIAS_GAMMA;
+                static constexpr bool HAS_ORDER = false;
+
+                template<typename Serializer> static inline std::size_t put( BitWriter<Serializer>& bits, const std::uint64_t v, const std::size_t ) {
+                    return bits.put_elias_gamma( v );
+                }
+
+                template<typename Word, typename Serializer> static inline Word get( BitBuffer<Serializer>& bits, const std::size_t ) {
+                    return bits.template read_elias_gamma<Word>();
+                }
+            };
+
+            /**
+             * @brief Elias-delta code of v + 1; it takes no order (k must be 0).
+             *
+             */
+            struct EliasDeltaCode {
+                static constexpr UniversalCodeType TYPE = UniversalCodeType::ELIAS_DELTA;
+                static constexpr bool HAS_ORDER = false;
+
+                template<typename Serializer> static inline std::size_t put( BitWriter<Serializer>& bits, const std::uint64_t v, const std::size_t ) {
+                    return bits.put_elias_delta( v );
+                }
+
+                template<typename Word, typename Serializer> static inline Word get( BitBuffer<Serializer>& bits, const std::size_t ) {
+                    return bits.template read_elias_delta<Word>();
+                }
+            };
+
+            template<typename Word> struct RunLengthCommon {
+                using rseq_t = std::int64_t; //typedef unsigned long long int rseq_t; // Data type internally used by the relative sequence. It can be changed here to reduce memory footprint in case numbers in a relative sequence are small enough to fit in fewer bits.  
+                
+                template<typename TypeInt = rseq_t> using RelativeSequence = std::shared_ptr<samg::grcodec::adapter::QueueAdapter<TypeInt>>;
+                
+                template<typename TypeUInt = Word> using AbsoluteSequence = std::shared_ptr<samg::grcodec::adapter::QueueAdapter<TypeUInt>>;
+                
+
+                static const std::size_t    RLE_THRESHOLD = 3,     // Minimum number of repetitions to be compressed.
+                                            ESCAPE_RANGE_SPAN = 2; // Range span to reserve integers as special symbols (e.g. negative flag, repetition mark).
+                
+                static const Word   NEGATIVE_FLAG = 0,
+                                    REPETITION_FLAG = 1;
+
+                static const bool   IS_NEGATIVE = true;
+                
+                /**
+                 * @brief This function allows generating a gap centered in 0. The result is a value that belongs to either (-inf,-RunLengthCommon<Word>::ESCAPE_RANGE_SPAN+1] or [RunLengthCommon<Word>::ESCAPE_RANGE_SPAN,inf). This transformation of v allows to release values in [-RunLengthCommon<Word>::ESCAPE_RANGE_SPAN,RunLengthCommon<Word>::ESCAPE_RANGE_SPAN-1] to be used as scape symbols during encoding/decoding of, for instance, negative values.
+                 * 
+                 * @param v 
+                 * @return rseq_t 
+                 */
+                static rseq_t transform_rval( rseq_t v ) {
+                    return v >= 0 ? v + RunLengthCommon<Word>::ESCAPE_RANGE_SPAN : v - RunLengthCommon<Word>::ESCAPE_RANGE_SPAN; // Transform relative value. 
+                }
+
+                /**
+                 * @brief This function allows recovering an original value transformed by `transform_rval`.
+                 * 
+                 * @param v 
+                 * @return rseq_t 
+                 */
+                static rseq_t recover_rval( rseq_t v ) {
+                    return v < 0 ? v + RunLengthCommon<Word>::ESCAPE_RANGE_SPAN : v - RunLengthCommon<Word>::ESCAPE_RANGE_SPAN; // Recover relative value.
+                }
+
+                /**
+                 * @brief This function returns `current - previous` modulo 2^W as a signed integer of the width of Word, i.e., in [-2^(W-1), 2^(W-1)). The difference is taken in the unsigned domain, so it never overflows, and `apply_rval( previous, delta )` gives `current` back.
+                 * 
+                 * @param previous 
+                 * @param current 
+                 * @return rseq_t 
+                 */
+                static inline rseq_t get_relative_value( const Word previous, const Word current ) {
+                    return (rseq_t) (std::make_signed_t<Word>) (Word) ( current - previous );
+                }
+
+                /**
+                 * @brief This function returns the Word emitted for a relative value: its magnitude shifted by ESCAPE_RANGE_SPAN, as `transform_rval` does, but computed in the unsigned domain. The magnitude is at most 2^(W-1), so the result always fits in Word.
+                 * 
+                 * @param delta 
+                 * @return Word 
+                 */
+                static inline Word encode_rval( const rseq_t delta ) {
+                    const std::uint64_t magnitude = ( delta < 0 ) ? 0ULL - (std::uint64_t) delta : (std::uint64_t) delta;
+                    return (Word) ( magnitude + RunLengthCommon<Word>::ESCAPE_RANGE_SPAN );
+                }
+
+                /**
+                 * @brief This function recovers the relative value encoded by `encode_rval`.
+                 * 
+                 * @param m 
+                 * @param is_negative 
+                 * @return rseq_t 
+                 */
+                static inline rseq_t decode_rval( const Word m, const bool is_negative ) {
+                    const std::uint64_t magnitude = (std::uint64_t) m - RunLengthCommon<Word>::ESCAPE_RANGE_SPAN;
+                    return (rseq_t) ( is_negative ? 0ULL - magnitude : magnitude );
+                }
+
+                /**
+                 * @brief This function adds a relative value to `v` modulo 2^W.
+                 * 
+                 * @param v 
+                 * @param delta 
+                 * @return Word 
+                 */
+                static inline Word apply_rval( const Word v, const rseq_t delta ) {
+                    return (Word) ( (std::uint64_t) v + (std::uint64_t) delta );
+                }
+
+                /**
+                 * @brief This function allows converting a sequence of unsigned Word integers into a relative sequence of signed integers by computing their sequential differences. The resultant sequence is transformed in the process to prevent the number 0 that is used to represent negative integers when numbers are encoded with variable-length integers.  
+                 * 
+                 * @param sequence 
+                 * @return RelativeSequence 
+                 */
+                static RelativeSequence<> get_transformed_relative_sequence( AbsoluteSequence<> sequence ) {
+                    RelativeSequence<> ans = adapter::get_instance<rseq_t>( adapter::QueueAdapterType::Q_QUEUEADAPTER );
+                    // std::cout << sequence.size() << std::endl;
+                    // if( sequence.size() > 0 ) {
+                    if( !sequence.empty() ) {
+                        /* NOTE
+                            1 3 3 6  5  0 0 5
+                            1 2 0 3 -1 -5 0 5 <--- Original relative values.
+                            2 3 1 4 -1 -5 1 6 <--- transformed relative values.
+                        */
+                        Word    current,
+                                previous = sequence.front();
+                            
+                        sequence.pop();
+
+                        ans->push( transform_rval( previous ));
+                        // ans.push_back( transform_rval( sequence[0] ) );
+                        while( !sequence->empty() ) {
+                            current = sequence.front(); sequence.pop();
+                            // std::cout << current << std::endl;
+                            // ans.push( transform_rval( ((rseq_t)(current)) - ((rseq_t)(previous)) ) );
+                            ans->push( RunLengthCommon<Word>::get_transformed_relative_sequence( current, previous ));
+                            previous = current;
+                        }
+                        // for (std::size_t i = 1; i < sequence.size(); ++i) {
+                        //     ans.push_back( transform_rval( ((rseq_t)(sequence[i])) - ((rseq_t)(sequence[i-1])) ) );
+                        // }
+                    }
+                    return ans;
+                }
+                /**
+                 * @brief This function converts `current` into a relative value given `previous`.
+                 * 
+                 * @param previous 
+                 * @param current 
+                 * @return rseq_t 
+                 */
+                static rseq_t get_transformed_relative_sequence( rseq_t relativa_previous, rseq_t relativa_current ) {
+                    rseq_t ans = transform_rval( relativa_current - relativa_previous );
+                //  std::cout << "\t\tRiceRuns / get_transformed_relative_sequence> relativa_previous = " << relativa_previous << "; relativa_current = " << relativa_current << "; ans = " << ans << std::endl;
+                    return ans;
+                }
+
+                /**
+                 * @brief This function allows converting a relative sequence of sequential differences encoded as signed integers into an absolute sequence of unsigned Word integers. The resultant sequence is transformed in the process to revert previous transformation when relativization was applied by `get_transformed_relative_sequence` function.
+                 * 
+                 * @param relative_sequence 
+                 * @return AbsoluteSequence
+                 * 
+                 * @warning Side effects on input!
+                 */
+                static AbsoluteSequence<> get_transformed_absolute_sequence( RelativeSequence<>& sequence ) {
+                    AbsoluteSequence<> ans = adapter::get_instance<Word>( adapter::QueueAdapterType::Q_QUEUEADAPTER );
+
+                    // if( relative_sequence.size() > 0 ) {
+                    if( !sequence->empty() ) {
+                        /* NOTE
+                            1 3 3 6  5  0 0 5 <--- Original absolute values.
+                            1 2 0 3 -1 -5 0 5 <--- Original relative values.
+                            2 3 1 4 -1 -5 1 6 <--- Transformed relative values.
+                            1 2 0 3 -1 -5 0 5 <--- Recovered relative values.
+                            1 3 3 6  5  0 0 5 <--- Recovered absolute values.
+
+                        */
+                        ans->push( recover_rval( sequence->front() ));
+                        sequence->pop();
+                        // ans.push_back( recover_rval( relative_sequence[0] ) );
+                        // for (std::size_t i = 1; i < sequence.size(); ++i) {
+                        while( !sequence->empty() ){
+                            ans->push( ((rseq_t)ans->back()) + recover_rval( sequence->front() ) );
+                            sequence->pop();
+                        }
+                    }
+                    return ans; //.release();
+                }
+
+                /**
+                 * @brief Decodes Rice-runs tokens from `codec` straight into absolute values, writing up to `n` of them into `out`. The values of a run that does not fit are pushed into `overflow`.
+                 * @note A token is either n, NEGATIVE_FLAG n, REPETITION_FLAG n r, or REPETITION_FLAG NEGATIVE_FLAG n r, so it always ends at a boundary where the decoding FSM is back at its initial state.
+                 * 
+                 * @tparam Codec is a Rice reader; calling its `final` members avoids virtual dispatch.
+                 * @tparam Queue provides `push(Word)` (e.g., `adapter::RingBuffer<Word>`).
+                 * @param codec 
+                 * @param out 
+                 * @param n 
+                 * @param last is the last absolute value decoded so far (0 at the beginning); it is updated.
+                 * @param overflow 
+                 * @return std::size_t is the number of values written into `out`.
+                 */
+                template<typename Codec, typename Queue> static std::size_t decode_tokens( Codec& codec, Word* out, const std::size_t n, Word& last, Queue& overflow ) {
+                    std::size_t i = 0;
+                    Word v = last;
+                    while( i < n && codec.has_more() ) {
+                        Word s = codec.next();
+                        bool is_negative = false;
+                        std::size_t r = 1;
+                        if( s == RunLengthCommon<Word>::REPETITION_FLAG ) {
+                            s = codec.next();
+                            if( s == RunLengthCommon<Word>::NEGATIVE_FLAG ) {
+                                is_negative = true;
+                                s = codec.next();
+                            }
+                            r = codec.next();
+                        } else if( s == RunLengthCommon<Word>::NEGATIVE_FLAG ) {
+                            is_negative = true;
+                            s = codec.next();
+                        }
+                        const rseq_t delta = RunLengthCommon<Word>::decode_rval( s, is_negative );
+                        const std::size_t fit = std::min( r, n - i );
+                        for( std::size_t j = 0; j < fit; ++j ) {
+                            v = RunLengthCommon<Word>::apply_rval( v, delta );
+                            out[i++] = v;
+                        }
+                        for( std::size_t j = fit; j < r; ++j ) {
+                            v = RunLengthCommon<Word>::apply_rval( v, delta );
+                            overflow.push( v );
+                        }
+                    }
+                    last = v;
+                    return i;
+                }
+
+                /**
+                 * @brief Encodes `n` absolute values as Rice-runs tokens into `codec`, starting from a fresh relative state (the first value is relative to 0). The tokens are the ones emitted by `OfflineRiceRunsWriter`, except that runs longer than the largest Word are split so that their length always fits in a token.
+                 * 
+                 * @tparam Codec provides `add(Word)`.
+                 * @param codec 
+                 * @param values 
+                 * @param n 
+                 */
+                template<typename Codec> static void encode_tokens( Codec& codec, const Word* values, const std::size_t n ) {
+                    constexpr std::size_t MAX_RUN = std::numeric_limits<Word>::max();
+                    Word previous = 0;
+                    std::size_t i = 0;
+                    while( i < n ) {
+                        const rseq_t delta = RunLengthCommon<Word>::get_relative_value( previous, values[i] );
+                        std::size_t r = 1;
+                        previous = values[i++];
+                        while( i < n && r < MAX_RUN && RunLengthCommon<Word>::get_relative_value( previous, values[i] ) == delta ) {
+                            previous = values[i++];
+                            ++r;
+                        }
+                        const bool is_negative = delta < 0;
+                        const Word m = RunLengthCommon<Word>::encode_rval( delta );
+                        if( r < RunLengthCommon<Word>::RLE_THRESHOLD ) {
+                            for( std::size_t j = 0; j < r; ++j ) {
+                                if( is_negative ) { codec.add( RunLengthCommon<Word>::NEGATIVE_FLAG ); }
+                                codec.add( m );
+                            }
+                        } else {
+                            codec.add( RunLengthCommon<Word>::REPETITION_FLAG );
+                            if( is_negative ) { codec.add( RunLengthCommon<Word>::NEGATIVE_FLAG ); }
+                            codec.add( m );
+                            codec.add( (Word) r );
+                        }
+                    }
+                }
+
+            };
+        
+            // template<typename Word> struct Batch {
+            //     /**
+            //      * @brief Encodes in a batch the content of a QueueAdapter.
+            //      * 
+            //      * @param codec 
+            //      * @param queue 
+            //      */
+            //     static void batch_encode( samg::grcodec::base::writer::CodecFileWriter<Word>& codec, samg::grcodec::adapter::QueueAdapter<Word>& queue ) {
+            //         while( !queue.empty() ) {
+            //             codec.add( queue.front() );
+            //             queue.pop();
+            //         }
+            //     }
+            // };
+        }
+
+        namespace base {
+
+            /**
+             * @brief Interface for classes that handle metadata.
+             * 
+             */
+            class MetadataKeeper { 
+                public:
+                    /**
+                     * @brief Returnst the metadata.
+                     * 
+                     * @return const std::vector<std::size_t> 
+                     */
+                    virtual const std::vector<std::size_t> get_metadata() const = 0;
+
+                    /**
+                     * @brief Adds a new metadata at the end of the metadata list.
+                     * 
+                     * @param v 
+                     */
+                    virtual void add_metadata( std::size_t v ) = 0;
+
+                    /**
+                     * @brief Adds a new metadata at the beginning of the metadata list.
+                     * 
+                     * @param v 
+                     */
+                    virtual void push_metadata( std::size_t v ) = 0;
+            };
+
+            /**
+             * @brief Partial implementation of MetadataKeeper.
+             * 
+             */
+            class MetadataSaver : public MetadataKeeper {
+                protected:
+                    std::vector<std::size_t> metadata;
+                public:
+                    void add_metadata( std::size_t v ) override {
+                        this->metadata.push_back( v );
+                        // std::cout << "Codec/add_metadata> v = " << v << "; |metadata| = " << this->metadata.size() << "; @ " << (&(this->metadata)) << std::endl;
+                    }
+
+                    void push_metadata( std::size_t v ) override {
+                        this->metadata.insert( this->metadata.begin(), v );
+                        // this->push_metadata(v);
+                        // std::cout << "Codec/push_metadata> v = " << v << "; |metadata| = " << this->metadata.size() << "; @ " << (&(this->metadata)) << std::endl;
+                    }
+            };
+
+            template<typename Word> class Codec {
+                static_assert(
+                    std::is_same_v<Word, std::uint8_t> ||
+                    std::is_same_v<Word, std::uint16_t> ||
+                    std::is_same_v<Word, std::uint32_t> ||
+                    std::is_same_v<Word, std::uint64_t>,
+                    "typename must be one of std::uint8_t, std::uint16_t, std::uint32_t, or std::uint64_t"); 
+
+            };
+
+            class FileHandler {
+                private:
+                    const std::string file_name;
+                public:
+                    FileHandler( const std::string file_name ) :
+                        file_name (file_name) {}
+
+                    const std::string get_file_name() const {
+                        return this->file_name;
+                    }
+            };
+
+            namespace writer {
+                template<typename Word> class CodecWriter : public Codec<Word> {
+                    public:
+                        /**
+                         * @brief Adds a codeword to a bitmap.
+                         * 
+                         * @param n is the codeword.
+                         */
+                        virtual const bool add(const Word n) = 0;
+                };
+
+                template<typename Word> class CodecFileWriter : public CodecWriter<Word>, public FileHandler  {
+                    public:
+                        CodecFileWriter( const std::string file_name ) :
+                            FileHandler(file_name) {}
+                        /**
+                         * @brief Closes serialization.
+                         * 
+                         */
+                        virtual void close() = 0;
+                };
+            }
+
+            namespace reader {
+                template<typename Word> class CodecReader : public Codec<Word> {
+                    public:
+                        /**
+                         * @brief Decodes and returns the next encoded codeword as it iterates on a bitmap. 
+                         * 
+                         * @return const Word 
+                         */
+                        virtual const Word next() = 0;
+
+                        /**
+                         * @brief Verifies whether a bitmap has or doesn't have more codewords to iterate on.
+                         * 
+                         * @return true 
+                         * @return false 
+                         */
+                        virtual const bool has_more() const = 0;
+
+                        /**
+                         * @brief Decodes up to `n` codewords into `out`.
+                         * @note Subclasses override it to keep their decoding state in registers across the whole block instead of paying two virtual calls per codeword.
+                         * 
+                         * @param out 
+                         * @param n 
+                         * @return std::size_t is the number of decoded codewords; it is less than `n` only at the end of the sequence.
+                         */
+                        virtual std::size_t decode_block( Word* out, const std::size_t n ) {
+                            std::size_t i = 0;
+                            while( i < n && this->has_more() ) {
+                                out[i++] = this->next();
+                            }
+                            return i;
+                        }
+
+                        /**
+                         * @brief Restart the reading over again.
+                         * 
+                         */
+                        virtual void restart() = 0;
+                };
+
+                template<typename Word> class CodecFileReader : public CodecReader<Word>, public FileHandler {
+                    public:
+                        CodecFileReader( const std::string file_name ) :
+                            FileHandler(file_name) {}
+                        /**
+                         * @brief Closes serialization source.
+                         * 
+                         */
+                        virtual void close() = 0;
+                };
+
+            }
+        }
+        /***************************************************************/
+        /***************************************************************/
+        /***************************************************************/
+
+        namespace toolkits {
+            template<typename Word> struct Batch {
+                /**
+                 * @brief Encodes in a batch the content of a QueueAdapter.
+                 * 
+                 * @param codec 
+                 * @param queue 
+                 */
+                static void batch_encode( samg::grcodec::base::writer::CodecFileWriter<Word>& codec, samg::grcodec::adapter::QueueAdapter<Word>& queue ) {
+                    while( !queue.empty() ) {
+                        codec.add( queue.front() );
+                        queue.pop();
+                    }
+                }
+
+                /**
+                 * @brief Consumer stage of a two-stage pipeline: encodes what another thread pushes into `queue` until that thread closes it. The codec is not closed.
+                 * 
+                 * @param codec 
+                 * @param queue 
+                 * @param batch_length is the number of values popped at once.
+                 */
+                static void pipelined_encode( samg::grcodec::base::writer::CodecFileWriter<Word>& codec, samg::grcodec::adapter::SPSCQueueAdapter<Word>& queue, const std::size_t batch_length = 4096ZU ) {
+                    std::vector<Word> batch( batch_length );
+                    std::size_t n;
+                    while( ( n = queue.pop_batch( batch.data(), batch.size() ) ) > 0ZU ) {
+                        for( std::size_t i = 0; i < n; ++i ) {
+                            codec.add( batch[i] );
+                        }
+                    }
+                }
+            };
+
+            /**
+             * @brief Sampled skip index of a Rice bitmap. Every `sample_rate` values, it keeps the bit position where the next value starts and the sum of all previous values (i.e., the last absolute value of a gap-coded sequence).
+             * @note It is stored at the end of the metadata list as `(bit_position, sum)*, samples, sample_rate, SkipIndex::MAGIC`, so that streams without it decode as before.
+             * 
+             */
+            class SkipIndex {
+                public:
+                    static constexpr std::size_t MAGIC = 0x58444E4950494B53ULL; // "SKIPINDX" in little-endian ASCII.
+                private:
+                    std::size_t sample_rate;
+                    std::vector<std::size_t> positions, // positions[j-1] is the bit position of value j*sample_rate.
+                                             sums; // sums[j-1] is the sum of the first j*sample_rate values.
+                public:
+                    SkipIndex( const std::size_t sample_rate = 0ZU ) :
+                        sample_rate ( sample_rate ) {}
+
+                    const std::size_t get_sample_rate() const {
+                        return this->sample_rate;
+                    }
+
+                    /**
+                     * @brief Returns the number of samples; sample 0 (the beginning of the stream) is implicit.
+                     * 
+                     * @return const std::size_t 
+                     */
+                    const std::size_t size() const {
+                        return this->positions.size();
+                    }
+
+                    const bool empty() const {
+                        return this->positions.empty();
+                    }
+
+                    const std::size_t get_position( const std::size_t j ) const {
+                        return ( j == 0ZU ) ? 0ZU : this->positions[j - 1];
+                    }
+
+                    const std::size_t get_sum( const std::size_t j ) const {
+                        return ( j == 0ZU ) ? 0ZU : this->sums[j - 1];
+                    }
+
+                    const std::size_t get_value_index( const std::size_t j ) const {
+                        return j * this->sample_rate;
+                    }
+
+                    void add( const std::size_t bit_position, const std::size_t sum ) {
+                        this->positions.push_back( bit_position );
+                        this->sums.push_back( sum );
+                    }
+
+                    /**
+                     * @brief Returns the last sample at or before value `i`.
+                     * 
+                     * @param i 
+                     * @return const std::size_t 
+                     */
+                    const std::size_t floor_value( const std::size_t i ) const {
+                        return ( this->sample_rate == 0ZU ) ? 0ZU : std::min( i / this->sample_rate, this->size() );
+                    }
+
+                    /**
+                     * @brief Returns the last sample whose preceding sum is lower than `x`, that is, the first value reaching `x` is not before it.
+                     * 
+                     * @param x 
+                     * @return const std::size_t 
+                     */
+                    const std::size_t floor_sum( const std::size_t x ) const {
+                        return std::lower_bound( this->sums.begin(), this->sums.end(), x ) - this->sums.begin();
+                    }
+
+                    /**
+                     * @brief Appends the index at the end of the metadata list of `keeper`. Nothing is appended for an empty index.
+                     * 
+                     * @param keeper 
+                     */
+                    void save( samg::grcodec::base::MetadataKeeper& keeper ) const {
+                        if( this->empty() ) {
+                            return;
+                        }
+                        for( std::size_t j = 0; j < this->size(); ++j ) {
+                            keeper.add_metadata( this->positions[j] );
+                            keeper.add_metadata( this->sums[j] );
+                        }
+                        keeper.add_metadata( this->size() );
+                        keeper.add_metadata( this->sample_rate );
+                        keeper.add_metadata( SkipIndex::MAGIC );
+                    }
+
+                    /**
+                     * @brief Loads the index from the end of `metadata`, if any, and erases it from there.
+                     * 
+                     * @param metadata 
+                     * @return true if an index was found.
+                     */
+                    bool load( std::vector<std::size_t>& metadata ) {
+                        const std::size_t m = metadata.size();
+                        if( m < 3ZU || metadata[m - 1] != SkipIndex::MAGIC ) {
+                            return false;
+                        }
+                        const std::size_t samples = metadata[m - 3];
+                        if( m < 3ZU + 2ZU * samples ) {
+                            throw std::runtime_error("SkipIndex/load> Corrupted skip index: "+std::to_string(samples)+" samples in a metadata list of "+std::to_string(m)+" entries.");
+                        }
+                        this->sample_rate = metadata[m - 2];
+                        this->positions.clear();
+                        this->sums.clear();
+                        const std::size_t from = m - 3ZU - 2ZU * samples;
+                        for( std::size_t j = 0; j < samples; ++j ) {
+                            this->add( metadata[from + 2ZU * j], metadata[from + 2ZU * j + 1ZU] );
+                        }
+                        metadata.resize( from );
+                        return true;
+                    }
+            };
+        }
+
+        namespace rice {
+            
+            namespace writer {
+                /**
+                 * @brief Writes a binary sequence in offline mode (block by block).
+                 * 
+                 * @tparam Word used to encode bits.
+                 */
+                template<typename Word> class OfflineRCodecWriter : public samg::grcodec::base::writer::CodecFileWriter<Word>, public samg::grcodec::base::MetadataSaver {
+                    private:
+                        const std::size_t   k; // Rice-code order.
+                        std::size_t value_counter, // Number of encoded values.
+                                    bit_counter, // Number of encoded bits.
+                                    value_sum, // Sum of encoded values.
+                                    next_sample; // Value counter at which the next skip-index sample is taken.
+                        samg::grcodec::toolkits::SkipIndex skip_index;
+                        std::unique_ptr<samg::serialization::OfflineWordWriter<Word>> serializer;
+                        samg::grcodec::toolkits::BitWriter<samg::serialization::OfflineWordWriter<Word>> bits;
+
+                        /**
+                         * @brief Prepends metadata to output file.
+                         * 
+                         */
+                        void _save_metadata_() {
+                            std::vector<std::size_t> met = this->get_metadata();
+                            for (std::size_t v : this->get_metadata()) {
+                                this->serializer->template add_value<std::size_t>( v );
+                            }
+                            this->serializer->template add_value<std::size_t>( this->metadata.size() );
+                        } 
+
+                    public:
+                        /**
+                         * @brief Construct a new Offline Binary Sequence object
+                         * 
+                         * @param file_name 
+                         * @param k 
+                         * @param sample_rate is the number of values between skip-index samples; 0 disables the index.
+                         */
+                        OfflineRCodecWriter( const std::string file_name, const std::size_t k, const std::size_t sample_rate = 0ZU ):
+                            samg::grcodec::base::writer::CodecFileWriter<Word>::CodecFileWriter( file_name ),
+                            k ( k ),
+                            value_counter ( 0ULL ),
+                            bit_counter ( 0ULL ),
+                            value_sum ( 0ZU ),
+                            next_sample ( ( sample_rate == 0ZU ) ? std::numeric_limits<std::size_t>::max() : sample_rate ),
+                            skip_index ( sample_rate ) {
+                            if( k >= 64ZU ) {
+                                throw std::invalid_argument("OfflineRCodecWriter> k = "+std::to_string(k)+" must be lower than 64.");
+                            }
+                            this->serializer = std::make_unique<samg::serialization::OfflineWordWriter<Word>>( file_name );
+                            this->bits.reset( this->serializer.get() );
+                        }
+
+                        /**
+                         * @brief Returns the k constant
+                         * 
+                         * @return const std::size_t 
+                         */
+                        const std::size_t get_k() const {
+                            return this->k;
+                        }
+
+                        const std::size_t get_value_counter() const {
+                            return this->value_counter;
+                        }
+
+                        const std::size_t get_bit_counter() const {
+                            return this->bit_counter;
+                        }
+
+                        const bool add( const Word n ) override final {
+                            if( this->value_counter == this->next_sample ) {
+                                this->skip_index.add( this->bit_counter, this->value_sum );
+                                this->next_sample += this->skip_index.get_sample_rate();
+                            }
+                            this->value_sum += n;
+                            this->bit_counter += this->bits.put_rice( n, this->k );
+                            ++(this->value_counter);
+                            LOG("OfflineRCodecWriter/add> n = %lu; bit_counter = %zu", (std::uint64_t) n, this->bit_counter);
+                            return true; // To fulfill inheritance requirements.
+                        }
+
+                        const std::vector<std::size_t> get_metadata() const override {
+                            return this->metadata;
+                        }
+
+                        void close( ) override {
+                            // Write pending bits, padded with zeros up to a whole word:
+                            this->bits.flush( sizeof(Word) );
+                            // Appending metadata:
+                            this->push_metadata( this->bit_counter );
+                            this->push_metadata( this->k );
+                            this->skip_index.save( *this );
+                            this->_save_metadata_();
+                            this->serializer->close();
+                        }
+
+                };
+
+                /**
+                 * @brief Writes a binary sequence in offline mode, distributing values round-robin into `lanes` independent Rice bitstreams (interleaved Rice), so that a SIMD decoder can decode one codeword per lane at a time.
+                 * @note The file is a sequence of segments of `lanes * segment_values` values (the last one may be shorter). Each segment starts with `lanes` 32-bit lane lengths in bytes, followed by the lanes, each padded to 8 bytes. The metadata tail starts with `k, lanes, segment_values, value_count`.
+                 * 
+                 * @tparam Word used to encode bits.
+                 */
+                template<typename Word> class OfflineInterleavedRCodecWriter : public samg::grcodec::base::writer::CodecFileWriter<Word>, public samg::grcodec::base::MetadataSaver {
+                    private:
+                        /**
+                         * @brief LSB-first bitstream of a lane within the current segment.
+                         * 
+                         */
+                        struct Lane {
+                            std::uint64_t accumulator = 0ULL; // Pending bits, LSB-first.
+                            std::size_t accumulator_bits = 0ZU; // Number of pending bits in `accumulator` (always < 64).
+                            std::vector<std::uint64_t> words; // Spilled words; keeps its capacity across segments.
+
+                            /**
+                             * @brief Appends the lowest `len` bits of `bits` (len <= 64; higher bits must be 0).
+                             * 
+                             * @param bits 
+                             * @param len 
+                             */
+                            inline void put( const std::uint64_t bits, const std::size_t len ) {
+                                this->accumulator |= bits << this->accumulator_bits;
+                                if( this->accumulator_bits + len < 64ZU ) {
+                                    this->accumulator_bits += len;
+                                    return;
+                                }
+                                this->words.push_back( this->accumulator );
+                                const std::size_t used = 64ZU - this->accumulator_bits;
+                                this->accumulator = ( used < 64ZU ) ? bits >> used : 0ULL;
+                                this->accumulator_bits = this->accumulator_bits + len - 64ZU;
+                            }
+
+                            /**
+                             * @brief Spills pending bits, padded with zeros up to a whole word.
+                             * 
+                             */
+                            void flush() {
+                                if( this->accumulator_bits > 0ZU ) {
+                                    this->words.push_back( this->accumulator );
+                                }
+                                this->accumulator = 0ULL;
+                                this->accumulator_bits = 0ZU;
+                            }
+                        };
+
+                        const std::size_t   k, // Rice-code order.
+                                            lanes, // Number of interleaved bitstreams.
+                                            segment_values; // Values per lane in a segment.
+                        std::size_t value_counter, // Number of encoded values.
+                                    segment_counter, // Number of values in the current segment.
+                                    lane; // Lane of the next value.
+                        std::vector<Lane> lane_buffers;
+                        std::vector<std::uint32_t> header;
+                        std::unique_ptr<samg::serialization::OfflineWordWriter<Word>> serializer;
+
+                        /**
+                         * @brief Prepends metadata to output file.
+                         * 
+                         */
+                        void _save_metadata_() {
+                            for (std::size_t v : this->get_metadata()) {
+                                this->serializer->template add_value<std::size_t>( v );
+                            }
+                            this->serializer->template add_value<std::size_t>( this->metadata.size() );
+                        }
+
+                        /**
+                         * @brief Writes the current segment (header and lanes) and clears the lane buffers.
+                         * 
+                         */
+                        void _flush_segment_() {
+                            for( std::size_t j = 0; j < this->lanes; ++j ) {
+                                this->lane_buffers[j].flush();
+                                const std::size_t nbytes = this->lane_buffers[j].words.size() * sizeof(std::uint64_t);
+                                if( nbytes > std::numeric_limits<std::uint32_t>::max() ) {
+                                    throw std::runtime_error("OfflineInterleavedRCodecWriter/_flush_segment_> Lane "+std::to_string(j)+" takes "+std::to_string(nbytes)+" bytes, which exceeds the segment header range.");
+                                }
+                                this->header[j] = (std::uint32_t) nbytes;
+                            }
+                            this->serializer->add_bytes( reinterpret_cast<const std::uint8_t*>( this->header.data() ), this->lanes * sizeof(std::uint32_t) );
+                            for( Lane& l : this->lane_buffers ) {
+                                this->serializer->add_bytes( reinterpret_cast<const std::uint8_t*>( l.words.data() ), l.words.size() * sizeof(std::uint64_t) );
+                                l.words.clear();
+                            }
+                            this->segment_counter = 0ZU;
+                            this->lane = 0ZU;
+                        }
+
+                    public:
+                        /**
+                         * @brief Construct a new Offline Interleaved Binary Sequence object
+                         * 
+                         * @param file_name 
+                         * @param k 
+                         * @param lanes must be 4, 8, or 16.
+                         * @param segment_values is the number of values per lane in a segment.
+                         */
+                        OfflineInterleavedRCodecWriter( const std::string file_name, const std::size_t k, const std::size_t lanes = 8ZU, const std::size_t segment_values = 4096ZU ):
+                            samg::grcodec::base::writer::CodecFileWriter<Word>::CodecFileWriter( file_name ),
+                            k ( k ),
+                            lanes ( lanes ),
+                            segment_values ( segment_values ),
+                            value_counter ( 0ZU ),
+                            segment_counter ( 0ZU ),
+                            lane ( 0ZU ),
+                            lane_buffers ( lanes ),
+                            header ( lanes, 0U ) {
+                            if( k >= 64ZU ) {
+                                throw std::invalid_argument("OfflineInterleavedRCodecWriter> k = "+std::to_string(k)+" must be lower than 64.");
+                            }
+                            if( lanes != 4ZU && lanes != 8ZU && lanes != 16ZU ) {
+                                throw std::invalid_argument("OfflineInterleavedRCodecWriter> lanes = "+std::to_string(lanes)+" must be 4, 8, or 16.");
+                            }
+                            if( segment_values == 0ZU ) {
+                                throw std::invalid_argument("OfflineInterleavedRCodecWriter> segment_values must be positive.");
+                            }
+                            this->serializer = std::make_unique<samg::serialization::OfflineWordWriter<Word>>( file_name );
+                        }
+
+                        /**
+                         * @brief Returns the k constant
+                         * 
+                         * @return const std::size_t 
+                         */
+                        const std::size_t get_k() const {
+                            return this->k;
+                        }
+
+                        const std::size_t get_lanes() const {
+                            return this->lanes;
+                        }
+
+                        const std::size_t get_value_counter() const {
+                            return this->value_counter;
+                        }
+
+                        const bool add( const Word n ) override {
+                            const std::uint64_t v = n,
+                                                r = v & ( ( 1ULL << this->k ) - 1ULL );
+                            std::uint64_t q = v >> this->k;
+                            Lane& l = this->lane_buffers[ this->lane ];
+                            if( this->k + q < 64ZU ) { // Common case: remainder, unary quotient and its terminating 0 in a single put.
+                                l.put( r | ( ( ( 1ULL << q ) - 1ULL ) << this->k ), this->k + q + 1ZU );
+                            } else {
+                                l.put( r, this->k );
+                                for(; q >= 64ZU; q -= 64ZU ) {
+                                    l.put( ~0ULL, 64ZU );
+                                }
+                                l.put( ( 1ULL << q ) - 1ULL, q + 1ZU );
+                            }
+                            ++(this->value_counter);
+                            this->lane = ( this->lane + 1ZU == this->lanes ) ? 0ZU : this->lane + 1ZU;
+                            if( ++(this->segment_counter) == this->lanes * this->segment_values ) {
+                                this->_flush_segment_();
+                            }
+                            return true; // To fulfill inheritance requirements.
+                        }
+
+                        const std::vector<std::size_t> get_metadata() const override {
+                            return this->metadata;
+                        }
+
+                        void close( ) override {
+                            if( this->segment_counter > 0ZU ) {
+                                this->_flush_segment_();
+                            }
+                            // Appending metadata:
+                            this->push_metadata( this->value_counter );
+                            this->push_metadata( this->segment_values );
+                            this->push_metadata( this->lanes );
+                            this->push_metadata( this->k );
+                            this->_save_metadata_();
+                            this->serializer->close();
+                        }
+                };
+                /**
+                 * @brief Writes a binary sequence in offline mode with a block-adaptive Rice order: each block of `block_values` values is encoded with the k that minimizes its exact size, stored in a 6-bit block header.
+                 * @note The metadata tail starts with `block_values, bit_counter, value_count`.
+                 * 
+                 * @tparam Word used to encode bits.
+                 */
+                template<typename Word> class OfflineAdaptiveRCodecWriter : public samg::grcodec::base::writer::CodecFileWriter<Word>, public samg::grcodec::base::MetadataSaver {
+                    public:
+                        static constexpr std::size_t K_BITS = 6ZU; // Block header length; k < 64.
+                    private:
+                        const std::size_t block_values; // Values per block.
+                        std::size_t value_counter, // Number of encoded values.
+                                    bit_counter, // Number of encoded bits.
+                                    block_fill; // Values in `block`.
+                        std::vector<Word> block; // Values of the current block.
+                        std::unique_ptr<samg::serialization::OfflineWordWriter<Word>> serializer;
+                        samg::grcodec::toolkits::BitWriter<samg::serialization::OfflineWordWriter<Word>> bits;
+
+                        /**
+                         * @brief Prepends metadata to output file.
+                         * 
+                         */
+                        void _save_metadata_() {
+                            for (std::size_t v : this->get_metadata()) {
+                                this->serializer->template add_value<std::size_t>( v );
+                            }
+                            this->serializer->template add_value<std::size_t>( this->metadata.size() );
+                        }
+
+                        /**
+                         * @brief Encodes the current block with its optimal k.
+                         * 
+                         */
+                        void _flush_block_() {
+                            const auto [k, cost] = samg::grcodec::toolkits::GolombRiceCommon<Word>::optimal_rice_parameter( this->block.data(), this->block_fill );
+                            this->bits.put( k, OfflineAdaptiveRCodecWriter::K_BITS );
+                            for( std::size_t i = 0; i < this->block_fill; ++i ) {
+                                this->bits.put_rice( this->block[i], k );
+                            }
+                            this->bit_counter += OfflineAdaptiveRCodecWriter::K_BITS + cost;
+                            LOG("OfflineAdaptiveRCodecWriter/_flush_block_> block_fill = %zu; k = %zu; bit_counter = %zu", this->block_fill, k, this->bit_counter);
+                            this->block_fill = 0ZU;
+                        }
+
+                    public:
+                        /**
+                         * @brief Construct a new Offline Adaptive Binary Sequence object
+                         * 
+                         * @param file_name 
+                         * @param block_values is the number of values sharing a Rice order.
+                         */
+                        OfflineAdaptiveRCodecWriter( const std::string file_name, const std::size_t block_values = 128ZU ):
+                            samg::grcodec::base::writer::CodecFileWriter<Word>::CodecFileWriter( file_name ),
+                            block_values ( block_values ),
+                            value_counter ( 0ZU ),
+                            bit_counter ( 0ZU ),
+                            block_fill ( 0ZU ),
+                            block ( block_values ) {
+                            if( block_values == 0ZU ) {
+                                throw std::invalid_argument("OfflineAdaptiveRCodecWriter> block_values must be positive.");
+                            }
+                            this->serializer = std::make_unique<samg::serialization::OfflineWordWriter<Word>>( file_name );
+                            this->bits.reset( this->serializer.get() );
+                        }
+
+                        const std::size_t get_block_values() const {
+                            return this->block_values;
+                        }
+
+                        const std::size_t get_value_counter() const {
+                            return this->value_counter;
+                        }
+
+                        const std::size_t get_bit_counter() const {
+                            return this->bit_counter;
+                        }
+
+                        const bool add( const Word n ) override {
+                            this->block[ this->block_fill++ ] = n;
+                            ++(this->value_counter);
+                            if( this->block_fill == this->block_values ) {
+                                this->_flush_block_();
+                            }
+                            return true; // To fulfill inheritance requirements.
+                        }
+
+                        const std::vector<std::size_t> get_metadata() const override {
+                            return this->metadata;
+                        }
+
+                        void close( ) override {
+                            if( this->block_fill > 0ZU ) {
+                                this->_flush_block_();
+                            }
+                            // Write pending bits, padded with zeros up to a whole word:
+                            this->bits.flush( sizeof(Word) );
+                            // Appending metadata:
+                            this->push_metadata( this->value_counter );
+                            this->push_metadata( this->bit_counter );
+                            this->push_metadata( this->block_values );
+                            this->_save_metadata_();
+                            this->serializer->close();
+                        }
+                };
+            }
+
+            namespace reader {
+                /**
+                 * @brief Represents a binary sequence reader over a Rice-coded file; `OfflineRCodecReader` and `OnlineRCodecReader` only differ in the serializer, so the decoding and the skip-index navigation live here.
+                 * 
+                 * @tparam Word used to encode bits.
+                 * @tparam Serializer is either `samg::serialization::OfflineWordReader<Word>` or `samg::serialization::OnlineWordReader<Word>`.
+                 */
+                template<typename Word, typename Serializer> class RCodecReader : public samg::grcodec::base::reader::CodecFileReader<Word>, public samg::grcodec::base::MetadataSaver {
+                    private:
+                        const Word MAX;
+                        const std::size_t offset;
+                        Word R_MASK;
+                        std::unique_ptr<Serializer> serializer;
+                        samg::grcodec::toolkits::BitBuffer<Serializer> bits;
+                        std::unique_ptr<samg::grcodec::toolkits::RiceTable<>> table; // Only for small k.
+                        samg::grcodec::toolkits::SkipIndex skip_index;
+                        std::size_t k,
+                                    bit_limit,
+                                    bit_counter,
+                                    value_counter, // Number of decoded values since `offset`.
+                                    running_sum; // Sum of decoded values since `offset`.
+                        bool is_open;
+
+                        /**
+                         * @brief Moves `serializer` to byte `index`; `OfflineWordReader::seek` also takes the direction.
+                         * 
+                         * @param serializer 
+                         * @param index 
+                         */
+                        static inline void _seek_( Serializer& serializer, const std::size_t index ) {
+                            if constexpr( std::is_same_v<Serializer, samg::serialization::OfflineWordReader<Word>> ) {
+                                serializer.seek( index, std::ios::beg );
+                            } else {
+                                serializer.seek( index );
+                            }
+                        }
+
+                        void _retrieve_metadata_() {
+                            // k, bit_counter, metadata_size
+                            if( this->is_open ) {
+                                // std::cout << "RCodecReader/_retrieve_metadata_> (0) serializer size = " << this->serializer->size() << std::endl;
+                                std::size_t nbytes = this->serializer->size();
+                                RCodecReader::_seek_( *(this->serializer), nbytes - sizeof(std::size_t) );
+
+
+                                std::size_t metadata_size = this->serializer->template next<std::size_t>();
+                                // std::cout << "RCodecReader/_retrieve_metadata_> (1) tellg = " << this->serializer->tell() << "; metadata_size = " << metadata_size << std::endl;
+
+                                RCodecReader::_seek_( *(this->serializer), nbytes - ((metadata_size + 1) * sizeof(std::size_t)) );
+
+                                // std::cout << "RCodecReader/_retrieve_metadata_> (2) tellg = " << this->serializer->tell() << std::endl;
+
+                                for (std::size_t i = 0; i < metadata_size; i++) {
+                                    std::size_t v = this->serializer->template next<std::size_t>();
+                                    this->add_metadata( v );
+                                    // std::cout << "RCodecReader/_retrieve_metadata_> (2) \t\ttellg = " << this->serializer->tell() << "; v = " << v << std::endl;
+                                }
+                                
+                                RCodecReader::_seek_( *(this->serializer), this->offset / samg::constants::BITS_PER_BYTE );
+                                // std::cout << "RCodecReader/_retrieve_metadata_> (3) tellg = " << this->serializer->tell() << std::endl;
+                            }
+                        }
+
+                        /**
+                         * @brief Moves to absolute bit `bit_position`, where value `value_counter` starts after values summing `running_sum`. The serializer is only touched if the position is not buffered yet.
+                         * 
+                         * @param bit_position 
+                         * @param value_counter 
+                         * @param running_sum 
+                         */
+                        void _jump_( const std::size_t bit_position, const std::size_t value_counter, const std::size_t running_sum ) {
+                            if( !this->bits.jump( bit_position ) ) {
+                                RCodecReader::_seek_( *(this->serializer), bit_position / samg::constants::BITS_PER_BYTE );
+                                this->bits.reset( this->serializer.get(), bit_position );
+                            }
+                            this->bit_counter = bit_position;
+                            this->value_counter = value_counter;
+                            this->running_sum = running_sum;
+                        }
+
+                    public:
+                        /**
+                         * @brief Construct a new Binary Sequence object
+                         * 
+                         * @param file_name 
+                         * @param offset in bits
+                         * @param limit in bits
+                         */
+                        RCodecReader( const std::string file_name, const std::size_t offset = 0ULL, const std::size_t limit = 0ULL ) :
+                            samg::grcodec::base::reader::CodecFileReader<Word>::CodecFileReader( file_name ),
+                            MAX ( ~( (Word) 0 ) ),
+                            offset ( offset ),
+                            is_open ( false ) {
+                            
+                            // std::cout << "RCodecReader/init> (1)" << std::endl;
+
+                            this->restart();
+
+                            // std::cout << "RCodecReader/init> (2)" << std::endl;
+                            
+                            // Loading metadata:
+                            this->_retrieve_metadata_();
+
+                            // std::cout << "RCodecReader/init> (3)" << std::endl;
+                            // std::vector<std::size_t>metadata = this->get_metadata();
+                            // this->k = this->serializer->template next<std::size_t>();
+                            // this->bit_limit = this->serializer->template next<std::size_t>();
+                            this->k = this->metadata[0];
+                            this->bit_limit = ( limit == 0 ) ? this->metadata[1] : limit;
+                            this->metadata.erase( this->metadata.begin() ); // Erasing k from metadata.
+                            this->metadata.erase( this->metadata.begin() ); // Erasing bit_limit from metadata.
+                            this->skip_index.load( this->metadata ); // Erasing the skip index, if any, from metadata.
+
+                            // std::cout << "RCodecReader/init> (4) k = " << this->k << "; bit_limit = " << this->bit_limit << std::endl;
+                            // std::cout << "RCodecReader/init> k = " << this->k << "; bit_limit = " << this->bit_limit << std::endl;
+
+                            // Seting environment:
+                            this->R_MASK = MAX << this->k;
+                            if( this->k <= samg::grcodec::toolkits::RiceTable<>::MAX_K ) {
+                                this->table = std::make_unique<samg::grcodec::toolkits::RiceTable<>>( this->k );
+                            }
+
+                            LOG("RCodecReader/init> MAX = %u; offset = %zu; RMASK = %u; k = %zu; bit_limit = %zu; bit_counter = %zu; is_open = %u", this->MAX, this->offset, this->R_MASK, this->k, this->bit_limit, this->bit_counter, this->is_open);
+                            
+                            // // Set the starting byte within the serialization based on the input offset:
+                            // this->serializer->seek( std::ceil((std::double_t)offset/(std::double_t)BITS_PER_BYTE), std::ios::beg );
+                            // std::cout << "RCodecReader/init> (5)" << std::endl;
+                        }
 
-            };
+                        /**
+                         * @brief Returns the k constant
+                         * 
+                         * @return const std::size_t 
+                         */
+                        const std::size_t get_k() const {
+                            return this->k;
+                        }
 
-            class FileHandler {
-                private:
-                    const std::string file_name;
-                public:
-                    FileHandler( const std::string file_name ) :
-                        file_name (file_name) {}
+                        const Word next( ) override final { 
+                            // NOTE: Based on `samg::grcodec::toolkits::GolombRiceCommon<Word>::_rice_decode_`, but resolving the unary quotient a word at a time.
+                            const Word v = this->bits.template read_rice<Word>( this->k );
+                            this->bit_counter = this->bits.tell();
+                            ++(this->value_counter);
+                            this->running_sum += v;
+                            LOG("RCodecReader/next> k = %zu; bit_limit = %zu; bit_counter = %zu; v = %u", this->k, this->bit_limit, this->bit_counter, v);
+                            return v;
+                        }
 
-                    const std::string get_file_name() const {
-                        return this->file_name;
-                    }
-            };
+                        const bool has_more( ) const override final {
+                            return this->bit_counter < this->bit_limit; //this->serializer->has_more();
+                        }
+
+                        std::size_t decode_block( Word* out, const std::size_t n ) override {
+                            const std::size_t i = this->bits.template read_rice_block<Word>( out, n, this->k, this->bit_limit, this->table.get() );
+                            this->bit_counter = this->bits.tell();
+                            this->value_counter += i;
+                            for( std::size_t j = 0; j < i; ++j ) {
+                                this->running_sum += out[j];
+                            }
+                            return i;
+                        }
 
-            namespace writer {
-                template<typename Word> class CodecWriter : public Codec<Word> {
-                    public:
                         /**
-                         * @brief Adds a codeword to a bitmap.
+                         * @brief Positions the reader so that the next call to `next()` returns the `i`-th value (counted from `offset`). It jumps through the skip index when available and decodes forward from there.
+                         * @note The skip index holds absolute positions, so it is only used when `offset` is 0.
                          * 
-                         * @param n is the codeword.
+                         * @param i 
                          */
-                        virtual const bool add(const Word n) = 0;
-                };
+                        void seek_to_value( const std::size_t i ) {
+                            std::size_t j = ( this->offset == 0ZU ) ? this->skip_index.floor_value( i ) : 0ZU;
+                            while( j > 0ZU && this->skip_index.get_position( j ) > this->bit_limit ) {
+                                --j;
+                            }
+                            if( i < this->value_counter || this->skip_index.get_value_index( j ) > this->value_counter ) {
+                                this->_jump_( ( j == 0ZU ) ? this->offset : this->skip_index.get_position( j ), this->skip_index.get_value_index( j ), this->skip_index.get_sum( j ) );
+                            }
+                            Word buffer[64];
+                            while( this->value_counter < i && this->has_more() ) {
+                                this->decode_block( buffer, std::min( i - this->value_counter, 64ZU ) );
+                            }
+                        }
 
-                template<typename Word> class CodecFileWriter : public CodecWriter<Word>, public FileHandler  {
-                    public:
-                        CodecFileWriter( const std::string file_name ) :
-                            FileHandler(file_name) {}
                         /**
-                         * @brief Closes serialization.
+                         * @brief Treating values as gaps, decodes up to the first absolute value (running sum) not lower than `x` and returns it. If the last decoded absolute value already reaches `x`, it is returned again without decoding.
                          * 
+                         * @param x 
+                         * @return const std::size_t is the absolute value found, or `std::numeric_limits<std::size_t>::max()` if the sequence ends before reaching `x`.
                          */
-                        virtual void close() = 0;
-                };
-            }
+                        const std::size_t next_geq( const std::size_t x ) {
+                            if( this->value_counter > 0ZU && this->running_sum >= x ) {
+                                return this->running_sum;
+                            }
+                            if( this->offset == 0ZU ) {
+                                std::size_t j = this->skip_index.floor_sum( x );
+                                while( j > 0ZU && this->skip_index.get_position( j ) > this->bit_limit ) {
+                                    --j;
+                                }
+                                if( this->skip_index.get_value_index( j ) > this->value_counter ) {
+                                    this->_jump_( this->skip_index.get_position( j ), this->skip_index.get_value_index( j ), this->skip_index.get_sum( j ) );
+                                }
+                            }
+                            while( this->has_more() ) {
+                                this->next();
+                                if( this->running_sum >= x ) {
+                                    return this->running_sum;
+                                }
+                            }
+                            return std::numeric_limits<std::size_t>::max();
+                        }
 
-            namespace reader {
-                template<typename Word> class CodecReader : public Codec<Word> {
-                    public:
                         /**
-                         * @brief Decodes and returns the next encoded codeword as it iterates on a bitmap. 
+                         * @brief Returns the number of values decoded since `offset`.
                          * 
-                         * @return const Word 
+                         * @return const std::size_t 
                          */
-                        virtual const Word next() = 0;
+                        const std::size_t get_value_counter() const {
+                            return this->value_counter;
+                        }
 
                         /**
-                         * @brief Verifies whether a bitmap has or doesn't have more codewords to iterate on.
+                         * @brief Returns the sum of the values decoded since `offset`, i.e., the last absolute value of a gap-coded sequence.
                          * 
-                         * @return true 
-                         * @return false 
+                         * @return const std::size_t 
                          */
-                        virtual const bool has_more() const = 0;
+                        const std::size_t get_running_sum() const {
+                            return this->running_sum;
+                        }
 
                         /**
-                         * @brief Restart the reading over again.
+                         * @brief Returns the skip index stored with the sequence; it is empty if the writer did not sample.
                          * 
+                         * @return const samg::grcodec::toolkits::SkipIndex& 
                          */
-                        virtual void restart() = 0;
-                };
+                        const samg::grcodec::toolkits::SkipIndex& get_skip_index() const {
+                            return this->skip_index;
+                        }
+
+                        void restart() override {
+                            this->close();
+                            this->serializer = std::make_unique<Serializer>( this->get_file_name() );
+                            
+                            // Set the starting byte within the serialization based on the input offset:
+                            RCodecReader::_seek_( *(this->serializer), this->offset / samg::constants::BITS_PER_BYTE );
+                            this->bits.reset( this->serializer.get(), this->offset );
+                            this->bit_counter = this->offset;
+                            this->value_counter = 0ZU;
+                            this->running_sum = 0ZU;
+
+                            this->is_open = true;
+                        }
+
+                        const std::vector<std::size_t> get_metadata() const override {
+                            // Take out k and bit_counter entries in the metadata list:
+                            // std::vector<std::size_t> tmp = std::vector<std::size_t>( this->metadata.begin() + 2, this->metadata.end() );
+                            // return tmp;
+                            return this->metadata;
+                        }
 
-                template<typename Word> class CodecFileReader : public CodecReader<Word>, public FileHandler {
-                    public:
-                        CodecFileReader( const std::string file_name ) :
-                            FileHandler(file_name) {}
                         /**
-                         * @brief Closes serialization source.
+                         * @brief Returns bit limits of the reader. The limits are in the form of the range [offset,bit_limit).
                          * 
+                         * @return const std::pair<std::size_t,std::size_t> 
                          */
-                        virtual void close() = 0;
+                        const std::pair<std::size_t,std::size_t> get_bit_limits() const {
+                            return std::make_pair(this->offset, this->bit_limit);
+                        }
+
+                        void close( ) override {
+                            if( this->is_open ) {
+                                this->serializer->close();
+                                this->serializer.reset();
+                                this->is_open = false;
+                            }
+                        }
                 };
 
-            }
-        }
-        /***************************************************************/
-        /***************************************************************/
-        /***************************************************************/
+                /**
+                 * @brief Represents an offline binary sequence reader.
+                 * 
+                 * @tparam Word used to encode bits.
+                 */
+                template<typename Word> class OfflineRCodecReader : public RCodecReader<Word, samg::serialization::OfflineWordReader<Word>> {
+                    public:
+                        using RCodecReader<Word, samg::serialization::OfflineWordReader<Word>>::RCodecReader;
+                };
 
-        namespace toolkits {
-            template<typename Word> struct Batch {
                 /**
-                 * @brief Encodes in a batch the content of a QueueAdapter.
+                 * @brief Represents an online binary sequence reader.
                  * 
-                 * @param codec 
-                 * @param queue 
+                 * @tparam Word used to encode bits.
                  */
-                static void batch_encode( samg::grcodec::base::writer::CodecFileWriter<Word>& codec, samg::grcodec::adapter::QueueAdapter<Word>& queue ) {
-                    while( !queue.empty() ) {
-                        codec.add( queue.front() );
-                        queue.pop();
-                    }
-                }
-            };
-        }
+                template<typename Word> class OnlineRCodecReader : public RCodecReader<Word, samg::serialization::OnlineWordReader<Word>> {
+                    public:
+                        using RCodecReader<Word, samg::serialization::OnlineWordReader<Word>>::RCodecReader;
+                };
 
-        namespace rice {
-            
-            namespace writer {
                 /**
-                 * @brief Writes a binary sequence in offline mode (word by word).
+                 * @brief Represents an offline reader of sequences written by `OfflineInterleavedRCodecWriter`. Whole rows (one codeword per lane) are decoded with AVX2/AVX-512 gathers when available.
                  * 
                  * @tparam Word used to encode bits.
                  */
-                template<typename Word> class OfflineRCodecWriter : public samg::grcodec::base::writer::CodecFileWriter<Word>, public samg::grcodec::base::MetadataSaver {
+                template<typename Word> class OfflineInterleavedRCodecReader : public samg::grcodec::base::reader::CodecFileReader<Word>, public samg::grcodec::base::MetadataSaver {
                     private:
-                        static const std::size_t WORD_GROWING_SPAN = 1ULL; // Space in number of Word-type that the bitmap must grow. 
-                        Word *sequence; // It is the bitmap.
-                        const std::size_t   k; // Rice-code order.
-                        std::size_t bit_index, // Index of current bit within the bitmap `sequence`.
-                                    value_counter, // Number of encoded values.
-                                    word_counter, // Number of used words.
-                                    bit_counter, // Number of encoded bits.
-                                    words_max_capacity; // Max capacity of `sequence` in words.
-                        std::unique_ptr<samg::serialization::OfflineWordWriter<Word>> serializer;
+                        static constexpr std::size_t PADDING_BYTES = 16ZU; // Zeroed slack after the segment, so window loads never read out of bounds.
+                        std::unique_ptr<samg::serialization::OfflineWordReader<Word>> serializer;
+                        std::size_t k,
+                                    lanes,
+                                    segment_values, // Values per lane in a segment.
+                                    value_count, // Number of encoded values.
+                                    value_counter, // Number of decoded values.
+                                    segment_length, // Number of values in the loaded segment.
+                                    segment_counter; // Number of decoded values in the loaded segment.
+                        std::vector<std::uint8_t> segment;
+                        std::vector<std::uint32_t> header;
+                        std::vector<std::size_t> positions; // Bit position of each lane within `segment`.
+                        bool vectorizable, // Whether the loaded segment can be decoded with 32-bit SIMD windows.
+                             is_open;
+
+                        void _retrieve_metadata_() {
+                            // k, lanes, segment_values, value_count, metadata_size
+                            if( this->is_open ) {
+                                std::size_t nbytes = this->serializer->size();
+                                this->serializer->seek( nbytes - sizeof(std::size_t) , std::ios_base::beg );
+                                std::size_t metadata_size = this->serializer->template next<std::size_t>();
+                                this->serializer->seek( nbytes - ((metadata_size + 1) * sizeof(std::size_t)), std::ios_base::beg );
+                                for (std::size_t i = 0; i < metadata_size; i++) {
+                                    this->add_metadata( this->serializer->template next<std::size_t>() );
+                                }
+                                this->serializer->seek( 0, std::ios::beg );
+                            }
+                        }
 
                         /**
-                         * @brief Prepends metadata to output file.
+                         * @brief Returns the bits of `data` starting at bit `position`; at least the lowest 57 bits are valid.
                          * 
+                         * @param data 
+                         * @param position 
+                         * @return std::uint64_t 
                          */
-                        void _save_metadata_() {
-                            std::vector<std::size_t> met = this->get_metadata();
-                            for (std::size_t v : this->get_metadata()) {
-                                this->serializer->template add_value<std::size_t>( v );
+                        static inline std::uint64_t _window_( const std::uint8_t* data, const std::size_t position ) {
+                            std::uint64_t x;
+                            std::memcpy( &x, data + ( position >> 3 ), sizeof(x) );
+                            return x >> ( position & 7ZU );
+                        }
+
+                        /**
+                         * @brief Decodes the Rice codeword of order `k` at bit `position` of `data` and moves `position` past it.
+                         * 
+                         * @param data 
+                         * @param position 
+                         * @param k 
+                         * @return Word 
+                         */
+                        static inline Word _read_rice_( const std::uint8_t* data, std::size_t& position, const std::size_t k ) {
+                            std::uint64_t r = 0ULL, q = 0ULL;
+                            for( std::size_t got = 0; got < k; ) { // Remainder in chunks of at most 32 bits.
+                                const std::size_t len = std::min( k - got, 32ZU );
+                                r |= ( OfflineInterleavedRCodecReader::_window_( data, position ) & ( ( 1ULL << len ) - 1ULL ) ) << got;
+                                position += len;
+                                got += len;
                             }
-                            this->serializer->template add_value<std::size_t>( this->metadata.size() );
-                        } 
+                            while( true ) {
+                                const std::size_t ones = std::countr_one( OfflineInterleavedRCodecReader::_window_( data, position ) );
+                                if( ones <= 56ZU ) { // The terminating 0 lies within the valid bits.
+                                    q += ones;
+                                    position += ones + 1ZU;
+                                    break;
+                                }
+                                q += 56ZU;
+                                position += 56ZU;
+                            }
+                            return (Word) ( ( q << k ) | r );
+                        }
+
+                        /**
+                         * @brief Reads the next segment header and lanes.
+                         * 
+                         */
+                        void _load_segment_() {
+                            const std::size_t hbytes = this->lanes * sizeof(std::uint32_t);
+                            if( this->serializer->read_bytes( reinterpret_cast<std::uint8_t*>( this->header.data() ), hbytes ) != hbytes ) {
+                                throw std::runtime_error("OfflineInterleavedRCodecReader/_load_segment_> Truncated segment header in \""+this->get_file_name()+"\".");
+                            }
+                            std::size_t total = 0ZU;
+                            for( std::size_t j = 0; j < this->lanes; ++j ) {
+                                this->positions[j] = total * samg::constants::BITS_PER_BYTE;
+                                total += this->header[j];
+                            }
+                            this->segment.resize( total + OfflineInterleavedRCodecReader::PADDING_BYTES );
+                            if( this->serializer->read_bytes( this->segment.data(), total ) != total ) {
+                                throw std::runtime_error("OfflineInterleavedRCodecReader/_load_segment_> Truncated segment in \""+this->get_file_name()+"\".");
+                            }
+                            std::memset( this->segment.data() + total, 0, OfflineInterleavedRCodecReader::PADDING_BYTES );
+                            this->segment_length = std::min( this->value_count - this->value_counter, this->lanes * this->segment_values );
+                            this->segment_counter = 0ZU;
+                            this->vectorizable = this->k <= 24ZU && total < ( 1ZU << 28 ); // Codewords of up to 25 bits fit a 32-bit window; bit positions must fit 32 bits.
+                        }
+
+                        /**
+                         * @brief Decodes the next value of the loaded segment, from the lane it belongs to.
+                         * 
+                         * @return Word 
+                         */
+                        inline Word _next_scalar_() {
+                            const Word v = OfflineInterleavedRCodecReader::_read_rice_( this->segment.data(), this->positions[ this->segment_counter % this->lanes ], this->k );
+                            ++(this->segment_counter);
+                            ++(this->value_counter);
+                            return v;
+                        }
+
+                        /**
+                         * @brief Stores `count` 32-bit values into `out`, narrowing or widening them to `Word`.
+                         * 
+                         * @param out 
+                         * @param values 
+                         * @param count 
+                         */
+                        static inline void _store_( Word* out, const std::uint32_t* values, const std::size_t count ) {
+                            for( std::size_t j = 0; j < count; ++j ) {
+                                out[j] = (Word) values[j];
+                            }
+                        }
+
+#if defined(__AVX512F__)
+                        /**
+                         * @brief Decodes `rows` rows of 16 lanes, one codeword per lane and step.
+                         * 
+                         * @param out 
+                         * @param rows 
+                         */
+                        void _decode_rows_avx512_( Word* out, const std::size_t rows ) {
+                            alignas(64) std::uint32_t pos[16], old[16], values[16];
+                            for( std::size_t j = 0; j < 16ZU; ++j ) {
+                                pos[j] = (std::uint32_t) this->positions[j];
+                            }
+                            const std::uint8_t* data = this->segment.data();
+                            const __m128i kc = _mm_cvtsi32_si128( (int) this->k );
+                            const __m512i seven = _mm512_set1_epi32( 7 ),
+                                          one = _mm512_set1_epi32( 1 ),
+                                          bias = _mm512_set1_epi32( 127 ),
+                                          zero = _mm512_setzero_si512(),
+                                          rmask = _mm512_set1_epi32( (int) ( ( 1U << this->k ) - 1U ) ),
+                                          limit = _mm512_set1_epi32( (int) ( 24ZU - this->k ) ),
+                                          len = _mm512_set1_epi32( (int) ( this->k + 1ZU ) );
+                            __m512i p = _mm512_load_si512( pos );
+                            for( std::size_t r = 0; r < rows; ++r, out += 16 ) {
+                                __m512i w = _mm512_i32gather_epi32( _mm512_srli_epi32( p, 3 ), data, 1 );
+                                w = _mm512_srlv_epi32( w, _mm512_and_si512( p, seven ) ); // At least 25 valid bits.
+                                const __m512i u = _mm512_srl_epi32( w, kc ),
+                                              t = _mm512_andnot_si512( u, _mm512_add_epi32( u, one ) ), // Lowest 0 of the quotient as a power of two.
+                                              q = _mm512_sub_epi32( _mm512_srli_epi32( _mm512_castps_si512( _mm512_cvtepi32_ps( t ) ), 23 ), bias ); // log2(t) from the float exponent.
+                                const __mmask16 bad = _mm512_cmpgt_epi32_mask( q, limit ) | _mm512_cmpgt_epi32_mask( zero, q );
+                                const __m512i v = _mm512_or_si512( _mm512_sll_epi32( q, kc ), _mm512_and_si512( w, rmask ) );
+                                if( bad == 0 ) {
+                                    if constexpr( std::is_same_v<Word, std::uint32_t> ) {
+                                        _mm512_storeu_si512( out, v );
+                                    } else {
+                                        _mm512_store_si512( values, v );
+                                        OfflineInterleavedRCodecReader::_store_( out, values, 16ZU );
+                                    }
+                                    p = _mm512_add_epi32( p, _mm512_add_epi32( q, len ) );
+                                    continue;
+                                }
+                                // Some codeword does not fit the window; those lanes are decoded one at a time.
+                                _mm512_store_si512( old, p );
+                                _mm512_store_si512( pos, _mm512_add_epi32( p, _mm512_add_epi32( q, len ) ) );
+                                _mm512_store_si512( values, v );
+                                OfflineInterleavedRCodecReader::_store_( out, values, 16ZU );
+                                for( std::size_t j = 0; j < 16ZU; ++j ) {
+                                    if( ( bad >> j ) & 1U ) {
+                                        std::size_t position = old[j];
+                                        out[j] = OfflineInterleavedRCodecReader::_read_rice_( data, position, this->k );
+                                        pos[j] = (std::uint32_t) position;
+                                    }
+                                }
+                                p = _mm512_load_si512( pos );
+                            }
+                            _mm512_store_si512( pos, p );
+                            for( std::size_t j = 0; j < 16ZU; ++j ) {
+                                this->positions[j] = pos[j];
+                            }
+                        }
+#endif
+
+#if defined(__AVX2__)
+                        /**
+                         * @brief Decodes `rows` rows of 4, 8, or 16 lanes, in groups of 8 lanes and one codeword per lane and step.
+                         * 
+                         * @param out 
+                         * @param rows 
+                         */
+                        void _decode_rows_avx2_( Word* out, const std::size_t rows ) {
+                            alignas(32) std::uint32_t pos[16] = {}, old[8], values[8];
+                            for( std::size_t j = 0; j < this->lanes; ++j ) {
+                                pos[j] = (std::uint32_t) this->positions[j];
+                            }
+                            const std::uint8_t* data = this->segment.data();
+                            const std::size_t groups = ( this->lanes + 7ZU ) / 8ZU,
+                                              width = std::min( this->lanes, 8ZU ); // Active lanes per group.
+                            const __m128i kc = _mm_cvtsi32_si128( (int) this->k );
+                            const __m256i seven = _mm256_set1_epi32( 7 ),
+                                          one = _mm256_set1_epi32( 1 ),
+                                          bias = _mm256_set1_epi32( 127 ),
+                                          zero = _mm256_setzero_si256(),
+                                          rmask = _mm256_set1_epi32( (int) ( ( 1U << this->k ) - 1U ) ),
+                                          limit = _mm256_set1_epi32( (int) ( 24ZU - this->k ) ),
+                                          len = _mm256_set1_epi32( (int) ( this->k + 1ZU ) ),
+                                          active = ( width == 8ZU ) ? _mm256_set1_epi32( -1 ) : _mm256_setr_epi32( -1, -1, -1, -1, 0, 0, 0, 0 );
+                            __m256i p[2] = { _mm256_load_si256( reinterpret_cast<const __m256i*>( pos ) ), _mm256_load_si256( reinterpret_cast<const __m256i*>( pos + 8 ) ) };
+                            for( std::size_t r = 0; r < rows; ++r ) {
+                                for( std::size_t g = 0; g < groups; ++g, out += width ) {
+                                    __m256i w = _mm256_mask_i32gather_epi32( zero, reinterpret_cast<const int*>( data ), _mm256_srli_epi32( p[g], 3 ), active, 1 );
+                                    w = _mm256_srlv_epi32( w, _mm256_and_si256( p[g], seven ) ); // At least 25 valid bits.
+                                    const __m256i u = _mm256_srl_epi32( w, kc ),
+                                                  t = _mm256_andnot_si256( u, _mm256_add_epi32( u, one ) ), // Lowest 0 of the quotient as a power of two.
+                                                  q = _mm256_sub_epi32( _mm256_srli_epi32( _mm256_castps_si256( _mm256_cvtepi32_ps( t ) ), 23 ), bias ), // log2(t) from the float exponent.
+                                                  v = _mm256_or_si256( _mm256_sll_epi32( q, kc ), _mm256_and_si256( w, rmask ) ),
+                                                  next = _mm256_add_epi32( p[g], _mm256_add_epi32( q, len ) );
+                                    const int bad = _mm256_movemask_ps( _mm256_castsi256_ps( _mm256_and_si256( active, _mm256_or_si256( _mm256_cmpgt_epi32( q, limit ), _mm256_cmpgt_epi32( zero, q ) ) ) ) );
+                                    if constexpr( std::is_same_v<Word, std::uint32_t> ) {
+                                        if( width == 8ZU ) {
+                                            _mm256_storeu_si256( reinterpret_cast<__m256i*>( out ), v );
+                                        } else {
+                                            _mm_storeu_si128( reinterpret_cast<__m128i*>( out ), _mm256_castsi256_si128( v ) );
+                                        }
+                                    } else {
+                                        _mm256_store_si256( reinterpret_cast<__m256i*>( values ), v );
+                                        OfflineInterleavedRCodecReader::_store_( out, values, width );
+                                    }
+                                    if( bad != 0 ) { // Some codeword does not fit the window; those lanes are decoded one at a time.
+                                        _mm256_store_si256( reinterpret_cast<__m256i*>( old ), p[g] );
+                                        _mm256_store_si256( reinterpret_cast<__m256i*>( pos ), next );
+                                        for( std::size_t j = 0; j < width; ++j ) {
+                                            if( ( bad >> j ) & 1 ) {
+                                                std::size_t position = old[j];
+                                                out[j] = OfflineInterleavedRCodecReader::_read_rice_( data, position, this->k );
+                                                pos[j] = (std::uint32_t) position;
+                                            }
+                                        }
+                                        p[g] = _mm256_load_si256( reinterpret_cast<const __m256i*>( pos ) );
+                                    } else {
+                                        p[g] = next;
+                                    }
+                                }
+                            }
+                            _mm256_store_si256( reinterpret_cast<__m256i*>( pos ), p[0] );
+                            _mm256_store_si256( reinterpret_cast<__m256i*>( pos + 8 ), p[1] );
+                            for( std::size_t j = 0; j < this->lanes; ++j ) {
+                                this->positions[j] = pos[j];
+                            }
+                        }
+#endif
+
+                        /**
+                         * @brief Decodes `rows` whole rows (one codeword per lane) of the loaded segment into `out`.
+                         * 
+                         * @param out 
+                         * @param rows 
+                         */
+                        void _decode_rows_( Word* out, const std::size_t rows ) {
+                            if( this->vectorizable ) {
+#if defined(__AVX512F__)
+                                if( this->lanes == 16ZU ) {
+                                    this->_decode_rows_avx512_( out, rows );
+                                    return;
+                                }
+#endif
+#if defined(__AVX2__)
+                                this->_decode_rows_avx2_( out, rows );
+                                return;
+#endif
+                            }
+                            const std::uint8_t* data = this->segment.data();
+                            for( std::size_t r = 0; r < rows; ++r ) {
+                                for( std::size_t j = 0; j < this->lanes; ++j ) { // Independent lanes, so the CPU can overlap their decoding.
+                                    *(out++) = OfflineInterleavedRCodecReader::_read_rice_( data, this->positions[j], this->k );
+                                }
+                            }
+                        }
 
                     public:
                         /**
-                         * @brief Construct a new Offline Binary Sequence object
+                         * @brief Construct a new Interleaved Binary Sequence object
                          * 
                          * @param file_name 
-                         * @param k 
                          */
-                        OfflineRCodecWriter( const std::string file_name, const std::size_t k ):
-                            samg::grcodec::base::writer::CodecFileWriter<Word>::CodecFileWriter( file_name ),
-                            k ( k ),
-                            bit_index ( 0ULL ),
-                            value_counter ( 0ULL ),
-                            bit_counter ( 0ULL ),
-                            word_counter ( 0ULL ), // ( OfflineRCodecWriter<Word>::WORD_GROWING_SPAN ),
-                            words_max_capacity ( 0ULL ),// ( OfflineRCodecWriter<Word>::WORD_GROWING_SPAN ),
-                            sequence ( samg::grcodec::toolkits::GolombRiceCommon<Word>::rmalloc( 0ULL ) ) //( samg::grcodec::toolkits::GolombRiceCommon<Word>::rmalloc( OfflineRCodecWriter<Word>::WORD_GROWING_SPAN ) ) 
-                        {
-                            // std::cout << "OfflineRCodecWriter/init> (1)" << std::endl;
-                            this->serializer = std::make_unique<samg::serialization::OfflineWordWriter<Word>>( file_name );
-                            // this->serializer->template add_value<std::size_t>( k );
-                            // std::cout << "OfflineRCodecWriter/init> (2)" << std::endl;
+                        OfflineInterleavedRCodecReader( const std::string file_name ) :
+                            samg::grcodec::base::reader::CodecFileReader<Word>::CodecFileReader( file_name ),
+                            is_open ( false ) {
+                            this->restart();
+
+                            // Loading metadata:
+                            this->_retrieve_metadata_();
+                            this->k = this->metadata[0];
+                            this->lanes = this->metadata[1];
+                            this->segment_values = this->metadata[2];
+                            this->value_count = this->metadata[3];
+                            this->metadata.erase( this->metadata.begin(), this->metadata.begin() + 4 ); // Erasing k, lanes, segment_values, and value_count from metadata.
+                            this->header.resize( this->lanes );
+                            this->positions.resize( this->lanes );
                         }
 
                         /**
@@ -947,58 +3165,50 @@ namespace samg {
                             return this->k;
                         }
 
-                        const std::size_t get_value_counter() const {
-                            return this->value_counter;
+                        const std::size_t get_lanes() const {
+                            return this->lanes;
                         }
 
-                        const std::size_t get_bit_counter() const {
-                            return this->bit_counter;
+                        const Word next( ) override final {
+                            if( this->segment_counter == this->segment_length ) {
+                                this->_load_segment_();
+                            }
+                            return this->_next_scalar_();
                         }
 
-                        const bool add( const Word n ) override {
-                            LOG("OfflineRCodecWriter/add> [BEGIN] n = %u; bit_counter = %zu; bit_index = %zu", n, this->bit_counter, this->bit_index);
-                            const std::size_t n_bits = samg::grcodec::toolkits::GolombRiceCommon<Word>::_value_size_( n, this->k );
-                            // std::cout << "OfflineRCodecWriter/add> [BEGIN] k = " << this->k << "; n = " << n << "; |n| = " << n_bits << "[b]; bit_index = " << this->bit_index << "; bit_counter = " << this->bit_counter << "; value_counter = " << this->value_counter << "; word_max_capacity = " << this->words_max_capacity << "; word_counter = " << this->word_counter << std::endl;
-                            if( std::ceil( (double)(this->bit_index + n_bits ) / (double) samg::grcodec::toolkits::GolombRiceCommon<Word>::get_word_bits() ) > this->words_max_capacity ) {
-                            // if( std::floor( (double)(this->bit_index + n_bits ) / (double) samg::grcodec::toolkits::GolombRiceCommon<Word>::get_word_bits() ) >= this->words_max_capacity ) {
-                                // std::cout << "RCodec/BinarySequence/add --- growing bitmap from " << this->max_length << "[W]";
-                                const std::size_t new_word_capacity = std::ceil( (double)n_bits / (double)samg::grcodec::toolkits::GolombRiceCommon<Word>::get_word_bits() ); //+ OfflineRCodecWriter::WORD_GROWING_SPAN );
-                                // std::cout << "OfflineRCodecWriter/add>\t\tGrowing in "<< new_word_capacity <<"[W]..." << std::endl;
-                                this->word_counter += new_word_capacity;
-                                this->words_max_capacity += new_word_capacity;
-                                // std::cout << " to " << this->max_length << " [W]" << std::endl;
-                                this->sequence = samg::grcodec::toolkits::GolombRiceCommon<Word>::rrealloc( this->sequence, this->words_max_capacity );
-                            }
-                            std::size_t bit_index_tmp = this->bit_index;
-                            this->bit_index = samg::grcodec::toolkits::GolombRiceCommon<Word>::_rice_encode_(this->sequence, this->bit_index, n, this->k);
-                            this->bit_counter += n_bits;
-                            ++(this->value_counter);
+                        const bool has_more( ) const override final {
+                            return this->value_counter < this->value_count;
+                        }
 
-                            LOG("OfflineRCodecWriter/add> [MID] bit_counter = %zu; pre-bit_index %zu; bit_index = %zu", this->bit_counter, bit_index_tmp, this->bit_index);
-                            LOG("OfflineRCodecReader/next> %s", samg::utils::to_string<Word>( this->sequence, this->words_max_capacity, this->bit_index, true, this->bit_counter ).c_str() );
-                            // Checking if sequence is ready to be written on secondary memory:
-                            const double words_in_sequence = (double) this->bit_index  / (double) samg::grcodec::toolkits::GolombRiceCommon<Word>::get_word_bits();
-                            const std::size_t words = std::floor( words_in_sequence );
-                            if( words > 0 ) { // Flush to secondary memory:
-                                // std::cout << "OfflineRCodecWriter/add>\t\tFlushing..." << std::endl;
-                                LOG("OfflineRCodecWriter/add> [MID] Flushing...");
-                                const std::size_t delta_words = std::ceil( words_in_sequence ) - words;
-                                this->serializer->template add_values<Word>( this->sequence, words );
-                                // this->word_counter += ( this->words_max_capacity - delta_words );
-                                this->words_max_capacity = delta_words > 0 ? delta_words : OfflineRCodecWriter::WORD_GROWING_SPAN;
-                                Word* tmp_sequence = samg::grcodec::toolkits::GolombRiceCommon<Word>::rmalloc( this->words_max_capacity );
-                                for (size_t i = 0; i < delta_words; i++) {
-                                    tmp_sequence[i] = this->sequence[ words + i ];
-                                }
-                                samg::grcodec::toolkits::GolombRiceCommon<Word>::rfree( this->sequence );
-                                this->sequence = tmp_sequence;
-                                this->bit_index -= ( words * samg::grcodec::toolkits::GolombRiceCommon<Word>::get_word_bits() );
-                                LOG("OfflineRCodecReader/next> %s", samg::utils::to_string<Word>( this->sequence, this->words_max_capacity, this->bit_index, true, this->bit_counter ).c_str() );
-                            }
-                            LOG("OfflineRCodecWriter/add> [END] bit_counter = %zu; bit_index = %zu", this->bit_counter, this->bit_index);
-                            
-                            return true; // To fulfill inheritance requirements.
-                            // std::cout << "OfflineRCodecWriter/add>   [END] k = " << this->k << "; n = " << n << "; |n| = " << n_bits << "[b]; bit_index = " << this->bit_index << "; bit_counter = " << this->bit_counter << "; value_counter = " << this->value_counter << "; word_max_capacity = " << this->words_max_capacity << "; word_counter = " << this->word_counter << std::endl;
+                        std::size_t decode_block( Word* out, const std::size_t n ) override {
+                            std::size_t i = 0;
+                            while( i < n && this->has_more() ) {
+                                if( this->segment_counter == this->segment_length ) {
+                                    this->_load_segment_();
+                                }
+                                if( this->segment_counter % this->lanes == 0ZU ) {
+                                    const std::size_t rows = std::min( n - i, this->segment_length - this->segment_counter ) / this->lanes;
+                                    if( rows > 0ZU ) {
+                                        this->_decode_rows_( out + i, rows );
+                                        i += rows * this->lanes;
+                                        this->segment_counter += rows * this->lanes;
+                                        this->value_counter += rows * this->lanes;
+                                        continue;
+                                    }
+                                }
+                                out[i++] = this->_next_scalar_();
+                            }
+                            return i;
+                        }
+
+                        void restart() override {
+                            this->close();
+                            this->serializer = std::make_unique<samg::serialization::OfflineWordReader<Word>>( this->get_file_name() );
+                            this->serializer->seek( 0, std::ios::beg );
+                            this->value_counter = 0ZU;
+                            this->segment_length = 0ZU;
+                            this->segment_counter = 0ZU;
+                            this->is_open = true;
                         }
 
                         const std::vector<std::size_t> get_metadata() const override {
@@ -1006,150 +3216,87 @@ namespace samg {
                         }
 
                         void close( ) override {
-                            // std::cout << "OfflineRCodecWriter/close> [BEGIN] k = " << this->k << "[b]; bit_index = " << this->bit_index << "; bit_counter = " << this->bit_counter << "; value_counter = " << this->value_counter << "; word_max_capacity = " << this->words_max_capacity << "; word_counter = " << this->word_counter << std::endl;
-                            // Write pending words in the sequence:
-                            const std::size_t pending_words = std::ceil( (double)this->bit_index  / (double) samg::grcodec::toolkits::GolombRiceCommon<Word>::get_word_bits() );
-                            // std::cout << "OfflineRCodecWriter/close> \t\tpending_words = " << pending_words << std::endl;
-                            if( pending_words > 0 ) { // Flush to secondary memory:
-                                // std::cout << "OfflineRCodecWriter/close> \t\tFlusing..." << std::endl;
-                                this->serializer->template add_values<Word>( this->sequence, pending_words );
-                                // std::cout << "OfflineRCodecWriter/close> \t\tPrepending ---> k = " << this->k << "; bit_counter = " << this->bit_counter << std::endl;
-                            }
-                            // this->serializer->close();
-                            // Appending metadata:
-                            // std::cout << "OfflineRCodecWriter/close> |metadata| = " << this->get_metadata().size() << std::endl;
-                            this->push_metadata( this->bit_counter );
-                            this->push_metadata( this->k );
-                            // std::cout << "OfflineRCodecWriter/close> |metadata| = " << this->get_metadata().size() << std::endl;
-                            // this->metadata.insert(this->metadata.begin(), this->bit_counter );
-                            // this->metadata.insert(this->metadata.begin(), this->k );
-                            this->_save_metadata_();
-                            // std::cout << "OfflineRCodecWriter/close> [END]" << std::endl;
-                            this->serializer->close();
+                            if( this->is_open ) {
+                                this->serializer->close();
+                                this->serializer.reset();
+                                this->is_open = false;
+                            }
                         }
-
                 };
-            }
-
-            namespace reader {
                 /**
-                 * @brief Represents an offline binary sequence reader.
+                 * @brief Represents an offline reader of sequences written by `OfflineAdaptiveRCodecWriter`. Each block is decoded by a loop specialized for its k (table-driven for small k).
                  * 
                  * @tparam Word used to encode bits.
                  */
-                template<typename Word> class OfflineRCodecReader : public samg::grcodec::base::reader::CodecFileReader<Word>, public samg::grcodec::base::MetadataSaver {
+                template<typename Word> class OfflineAdaptiveRCodecReader : public samg::grcodec::base::reader::CodecFileReader<Word>, public samg::grcodec::base::MetadataSaver {
                     private:
-                        const Word MAX;
-                        const std::size_t offset;
-                        Word R_MASK;
                         std::unique_ptr<samg::serialization::OfflineWordReader<Word>> serializer;
-                        std::vector<Word> buffer;
-                        std::size_t k,
-                                    position,
+                        samg::grcodec::toolkits::BitBuffer<samg::serialization::OfflineWordReader<Word>> bits;
+                        std::array<std::unique_ptr<samg::grcodec::toolkits::RiceTable<>>, samg::grcodec::toolkits::RiceTable<>::MAX_K + 1ZU> tables; // Built on first use.
+                        const samg::grcodec::toolkits::RiceTable<>* table; // Table of the current block, if any.
+                        std::size_t block_values,
                                     bit_limit,
-                                    bit_counter;
+                                    value_count, // Number of encoded values.
+                                    value_counter, // Number of decoded values.
+                                    block_length, // Number of values in the current block.
+                                    block_counter, // Number of decoded values in the current block.
+                                    k; // Rice order of the current block.
                         bool is_open;
 
-                        const std::size_t _get_buffer_length_() {
-                            return this->buffer.size() * samg::grcodec::toolkits::GolombRiceCommon<Word>::get_word_bits();
-                        }
-
-                        const bool _fecth_() {
-                            // static std::size_t counter = 0;
-                            if( this->has_more() ) {
-                                this->buffer.push_back( this->serializer->template next<Word>() );
-                                // counter++;
-                                // std::cout << "OfflineRCodecReader/_fetch_> counter = " << counter << std::endl;
-                                return true;
-                            } else {
-                                // std::cout << "OfflineRCodecReader/_fetch_> NO MORE ENTRIES!!! --- counter = " << counter << std::endl;
-                                return false;
-                            }
-                        }
-
-                        void _update_() {
-                            // Relief buffer:
-                            while( this->position >= samg::grcodec::toolkits::GolombRiceCommon<Word>::get_word_bits() ) {
-                                this->buffer.erase(this->buffer.begin()); // !XXX INEFFICIENT OPERATIN ON STD::VECTOR !!!
-                                this->position -= samg::grcodec::toolkits::GolombRiceCommon<Word>::get_word_bits();
-                            }
-                            // Fill up buffer:
-                            while( this->position >= this->_get_buffer_length_() && this->_fecth_());
-                        }
-
                         void _retrieve_metadata_() {
-                            // k, bit_counter, metadata_size
+                            // block_values, bit_counter, value_count, metadata_size
                             if( this->is_open ) {
-                                // std::cout << "OfflineRCodecReader/_retrieve_metadata_> (0) serializer size = " << this->serializer->size() << std::endl;
                                 std::size_t nbytes = this->serializer->size();
                                 this->serializer->seek( nbytes - sizeof(std::size_t) , std::ios_base::beg );
-
-
                                 std::size_t metadata_size = this->serializer->template next<std::size_t>();
-                                // std::cout << "OfflineRCodecReader/_retrieve_metadata_> (1) tellg = " << this->serializer->tell() << "; metadata_size = " << metadata_size << std::endl;
-
                                 this->serializer->seek( nbytes - ((metadata_size + 1) * sizeof(std::size_t)), std::ios_base::beg );
-
-                                // std::cout << "OfflineRCodecReader/_retrieve_metadata_> (2) tellg = " << this->serializer->tell() << std::endl;
-
                                 for (std::size_t i = 0; i < metadata_size; i++) {
-                                    std::size_t v = this->serializer->template next<std::size_t>();
-                                    this->add_metadata( v );
-                                    // std::cout << "OfflineRCodecReader/_retrieve_metadata_> (2) \t\ttellg = " << this->serializer->tell() << "; v = " << v << std::endl;
+                                    this->add_metadata( this->serializer->template next<std::size_t>() );
                                 }
-                                
                                 this->serializer->seek( 0, std::ios::beg );
-                                // std::cout << "OfflineRCodecReader/_retrieve_metadata_> (3) tellg = " << this->serializer->tell() << std::endl;
+                            }
+                        }
+
+                        /**
+                         * @brief Reads the header of the next block.
+                         * 
+                         */
+                        void _start_block_() {
+                            this->k = this->bits.read( samg::grcodec::rice::writer::OfflineAdaptiveRCodecWriter<Word>::K_BITS );
+                            this->block_length = std::min( this->block_values, this->value_count - this->value_counter );
+                            this->block_counter = 0ZU;
+                            this->table = nullptr;
+                            if( this->k <= samg::grcodec::toolkits::RiceTable<>::MAX_K ) {
+                                if( !this->tables[ this->k ] ) {
+                                    this->tables[ this->k ] = std::make_unique<samg::grcodec::toolkits::RiceTable<>>( this->k );
+                                }
+                                this->table = this->tables[ this->k ].get();
                             }
                         }
 
                     public:
                         /**
-                         * @brief Construct a new Binary Sequence object
+                         * @brief Construct a new Adaptive Binary Sequence object
                          * 
                          * @param file_name 
-                         * @param offset in bits
-                         * @param limit in bits
                          */
-                        OfflineRCodecReader( const std::string file_name, const std::size_t offset = 0ULL, const std::size_t limit = 0ULL ) :
+                        OfflineAdaptiveRCodecReader( const std::string file_name ) :
                             samg::grcodec::base::reader::CodecFileReader<Word>::CodecFileReader( file_name ),
-                            MAX ( ~( (Word) 0 ) ),
-                            offset ( offset ),
+                            table ( nullptr ),
+                            k ( 0ZU ),
                             is_open ( false ) {
-                            
-                            // std::cout << "OfflineRCodecReader/init> (1)" << std::endl;
-
                             this->restart();
 
-                            // std::cout << "OfflineRCodecReader/init> (2)" << std::endl;
-                            
                             // Loading metadata:
                             this->_retrieve_metadata_();
-
-                            // std::cout << "OfflineRCodecReader/init> (3)" << std::endl;
-                            // std::vector<std::size_t>metadata = this->get_metadata();
-                            // this->k = this->serializer->template next<std::size_t>();
-                            // this->bit_limit = this->serializer->template next<std::size_t>();
-                            this->k = this->metadata[0];
-                            this->bit_limit = ( limit == 0 ) ? this->metadata[1] : limit;
-                            this->metadata.erase( this->metadata.begin() ); // Erasing k from metadata.
-                            this->metadata.erase( this->metadata.begin() ); // Erasing bit_limit from metadata.
-
-                            // std::cout << "OfflineRCodecReader/init> (4) k = " << this->k << "; bit_limit = " << this->bit_limit << std::endl;
-                            // std::cout << "OfflineRCodecReader/init> k = " << this->k << "; bit_limit = " << this->bit_limit << std::endl;
-
-                            // Seting environment:
-                            this->R_MASK = MAX << this->k;
-
-                            LOG("OfflineRCodecReader/init> MAX = %u; offset = %zu; RMASK = %u; k = %zu; position = %zu; bit_limit = %zu; bit_counter = %zu; is_open = %u", this->MAX, this->offset, this->R_MASK, this->k, this->position, this->bit_limit, this->bit_counter, this->is_open);
-                            
-                            // // Set the starting byte within the serialization based on the input offset:
-                            // this->serializer->seek( std::ceil((std::double_t)offset/(std::double_t)BITS_PER_BYTE), std::ios::beg );
-                            // std::cout << "OfflineRCodecReader/init> (5)" << std::endl;
+                            this->block_values = this->metadata[0];
+                            this->bit_limit = this->metadata[1];
+                            this->value_count = this->metadata[2];
+                            this->metadata.erase( this->metadata.begin(), this->metadata.begin() + 3 ); // Erasing block_values, bit_limit, and value_count from metadata.
                         }
 
                         /**
-                         * @brief Returns the k constant
+                         * @brief Returns the k constant of the current block.
                          * 
                          * @return const std::size_t 
                          */
@@ -1157,77 +3304,48 @@ namespace samg {
                             return this->k;
                         }
 
-                        const Word next( ) override { 
-                            LOG("OfflineRCodecReader/next> [BEGIN] k = %zu; position = %zu; bit_limit = %zu; bit_counter = %zu; buffer_length = %zu [b]; buffer = %s", this->k, this->position, this->bit_limit, this->bit_counter, this->_get_buffer_length_(), samg::utils::to_string<Word>(this->buffer).c_str());
-                            // NOTE: Based on `samg::grcodec::toolkits::GolombRiceCommon<Word>::_rice_decode_`.
-                            while( this->position > this->_get_buffer_length_() || ( this->_get_buffer_length_() - this->position ) < this->k ) {
-                                this->_fecth_();
+                        const Word next( ) override final {
+                            if( this->block_counter == this->block_length ) {
+                                this->_start_block_();
                             }
+                            ++(this->block_counter);
+                            ++(this->value_counter);
+                            return this->bits.template read_rice<Word>( this->k );
+                        }
 
-                            LOG("OfflineRCodecReader/next> [MID] k = %zu; position = %zu; bit_limit = %zu; bit_counter = %zu; buffer_length = %zu [b]; buffer = %s", this->k, this->position, this->bit_limit, this->bit_counter, this->_get_buffer_length_(), samg::utils::to_string<Word>(this->buffer).c_str());
-
-                            LOG("OfflineRCodecReader/next> %s", samg::utils::to_string( this->buffer.data(), this->buffer.size(), this->buffer.size() * sizeof(Word) * samg::constants::BITS_PER_BYTE, true, this->position ).c_str() );
-
-                            // Retrieve reminder:
-                            Word v = samg::grcodec::toolkits::GolombRiceCommon<Word>::_bitread_( buffer.data(), this->position, this->k );
-                            // Word v = samg::grcodec::toolkits::GolombRiceCommon<Word>::_bitread_( buffer.begin(), this->position, this->k );
-                            this->position += this->k;
-                            this->bit_counter += this->k;
-
-                            // Retrieve quotient:
-                            this->_update_();
-                            while ( samg::grcodec::toolkits::GolombRiceCommon<Word>::_bitget_( buffer.data() , this->position ) ) {
-                            // while ( samg::grcodec::toolkits::GolombRiceCommon<Word>::_bitget_( buffer.begin() , this->position ) ) {
-                                v += ( 1 << this->k );
-                                ++(this->position);
-                                ++(this->bit_counter);
-                                this->_update_();
-                            }
-                            ++(this->position);
-                            ++(this->bit_counter);
-                            // std::cout << "OfflineRCodecReader/next> \t\t[END] k = " << this->k << "; bit_limit = " << this->bit_limit << "; position = " << this->position << "; bit_counter = " << this->bit_counter << std::endl;
-                            LOG("OfflineRCodecReader/next> [END] k = %zu; position = %zu; bit_limit = %zu; bit_counter = %zu; v = %u", this->k, this->position, this->bit_limit, this->bit_counter, v);
-                            return v;
+                        const bool has_more( ) const override final {
+                            return this->value_counter < this->value_count;
                         }
 
-                        const bool has_more( ) const override {
-                            return this->bit_counter < this->bit_limit; //this->serializer->has_more();
+                        std::size_t decode_block( Word* out, const std::size_t n ) override {
+                            std::size_t i = 0;
+                            while( i < n && this->has_more() ) {
+                                if( this->block_counter == this->block_length ) {
+                                    this->_start_block_();
+                                }
+                                const std::size_t m = this->bits.template read_rice_block<Word>( out + i, std::min( n - i, this->block_length - this->block_counter ), this->k, this->bit_limit, this->table );
+                                i += m;
+                                this->block_counter += m;
+                                this->value_counter += m;
+                            }
+                            return i;
                         }
 
                         void restart() override {
                             this->close();
                             this->serializer = std::make_unique<samg::serialization::OfflineWordReader<Word>>( this->get_file_name() );
-                            
-                            // Set the starting byte within the serialization based on the input offset:
-                            std::size_t bytes = std::floor((std::double_t)this->offset/(std::double_t)samg::constants::BITS_PER_BYTE),
-                                        words = std::floor((std::double_t)bytes / (std::double_t)sizeof(Word));
-
-                            this->position = this->offset - ( words * sizeof(Word) * samg::constants::BITS_PER_BYTE ); //( byte * BITS_PER_BYTE ) - this->offset;
-                            this->bit_counter = this->offset;//( words * sizeof(Word) * BITS_PER_BYTE ); // - this->offset ;// 0ULL;
-                            this->serializer->seek( words * sizeof(Word), std::ios::beg );
-
+                            this->serializer->seek( 0, std::ios::beg );
+                            this->bits.reset( this->serializer.get(), 0ZU );
+                            this->value_counter = 0ZU;
+                            this->block_length = 0ZU;
+                            this->block_counter = 0ZU;
                             this->is_open = true;
-
-                            LOG("OfflineRCodecReader/restart> bytes = %zu, position = %zu; bit_counter = %zu; bit_limit = %zu",bytes, this->position, this->bit_counter, this->bit_limit);
-
                         }
 
                         const std::vector<std::size_t> get_metadata() const override {
-                            // Take out k and bit_counter entries in the metadata list:
-                            // std::vector<std::size_t> tmp = std::vector<std::size_t>( this->metadata.begin() + 2, this->metadata.end() );
-                            // return tmp;
                             return this->metadata;
                         }
 
-                        /**
-                         * @brief Returns bit limits of the reader. The limits are in the form of the range [offset,bit_limit).
-                         * 
-                         * @return const std::pair<std::size_t,std::size_t> 
-                         */
-                        const std::pair<std::size_t,std::size_t> get_bit_limits() const {
-                            return std::make_pair(this->offset, this->bit_limit);
-                        }
-
                         void close( ) override {
                             if( this->is_open ) {
                                 this->serializer->close();
@@ -1236,117 +3354,165 @@ namespace samg {
                             }
                         }
                 };
-
-                template<typename Word> class OnlineRCodecReader : public samg::grcodec::base::reader::CodecFileReader<Word>, public samg::grcodec::base::MetadataSaver {
+            }
+        }
+        
+        namespace universal {
+            namespace writer {
+                /**
+                 * @brief Writes a sequence of unsigned integers in offline mode with a universal code (Exp-Golomb of order k, Elias gamma or Elias delta). It shares the bit writer and the metadata tail of `rice::writer::OfflineRCodecWriter`, so it can replace it wherever Rice is used (e.g., as the codec of `runlength::writer::OfflineRiceRunsWriter`).
+                 * @note The metadata tail starts with `code type, k, bit_counter, value_count`.
+                 * 
+                 * @tparam Word used to encode bits.
+                 * @tparam Code is one of `toolkits::ExpGolombCode`, `toolkits::EliasGammaCode` or `toolkits::EliasDeltaCode`.
+                 */
+                template<typename Word, typename Code = samg::grcodec::toolkits::ExpGolombCode> class OfflineUniversalCodecWriter : public samg::grcodec::base::writer::CodecFileWriter<Word>, public samg::grcodec::base::MetadataSaver {
                     private:
-                        const Word MAX;
-                        const std::size_t offset;
-                        Word R_MASK;
-                        std::unique_ptr<samg::serialization::OnlineWordReader<Word>> serializer;
-                        std::vector<Word> buffer;
-                        // std::list<Word> buffer;
-                        std::size_t k,
-                                    position,
-                                    bit_limit,
-                                    bit_counter;
-                        bool is_open;
+                        const std::size_t   k; // Exp-Golomb order; 0 for the Elias codes.
+                        std::size_t value_counter, // Number of encoded values.
+                                    bit_counter; // Number of encoded bits.
+                        std::unique_ptr<samg::serialization::OfflineWordWriter<Word>> serializer;
+                        samg::grcodec::toolkits::BitWriter<samg::serialization::OfflineWordWriter<Word>> bits;
 
-                        const std::size_t _get_buffer_length_() {
-                            return this->buffer.size() * samg::grcodec::toolkits::GolombRiceCommon<Word>::get_word_bits();
-                        }
+                        /**
+                         * @brief Prepends metadata to output file.
+                         * 
+                         */
+                        void _save_metadata_() {
+                            for (std::size_t v : this->get_metadata()) {
+                                this->serializer->template add_value<std::size_t>( v );
+                            }
+                            this->serializer->template add_value<std::size_t>( this->metadata.size() );
+                        } 
 
-                        const bool _fecth_() {
-                            // static std::size_t counter = 0;
-                            if( this->has_more() ) {
-                                this->buffer.push_back( this->serializer->template next<Word>() );
-                                // counter++;
-                                // std::cout << "OfflineRCodecReader/_fetch_> counter = " << counter << std::endl;
-                                return true;
-                            } else {
-                                // std::cout << "OfflineRCodecReader/_fetch_> NO MORE ENTRIES!!! --- counter = " << counter << std::endl;
-                                return false;
+                    public:
+                        /**
+                         * @brief Construct a new Offline Universal Codec Writer object
+                         * 
+                         * @param file_name 
+                         * @param k is the Exp-Golomb order; it must be 0 for the Elias codes.
+                         */
+                        OfflineUniversalCodecWriter( const std::string file_name, const std::size_t k = 0ZU ):
+                            samg::grcodec::base::writer::CodecFileWriter<Word>::CodecFileWriter( file_name ),
+                            k ( k ),
+                            value_counter ( 0ZU ),
+                            bit_counter ( 0ZU ) {
+                            if( k >= 64ZU ) {
+                                throw std::invalid_argument("OfflineUniversalCodecWriter> k = "+std::to_string(k)+" must be lower than 64.");
                             }
+                            if( !Code::HAS_ORDER && k != 0ZU ) {
+                                throw std::invalid_argument("OfflineUniversalCodecWriter> Elias codes take no order, but k = "+std::to_string(k)+".");
+                            }
+                            this->serializer = std::make_unique<samg::serialization::OfflineWordWriter<Word>>( file_name );
+                            this->bits.reset( this->serializer.get() );
                         }
 
-                        void _update_() {
-                            // Relief buffer:
-                            while( this->position >= samg::grcodec::toolkits::GolombRiceCommon<Word>::get_word_bits() ) {
-                                this->buffer.erase(this->buffer.begin()); // !XXX INNEFICIENT OPERATION ON STD::VECTOR !!! 
-                                // this->buffer.pop_front();
-                                this->position -= samg::grcodec::toolkits::GolombRiceCommon<Word>::get_word_bits();
-                            }
-                            // Fill up buffer:
-                            while( this->position >= this->_get_buffer_length_() && this->_fecth_());
+                        /**
+                         * @brief Returns the k constant
+                         * 
+                         * @return const std::size_t 
+                         */
+                        const std::size_t get_k() const {
+                            return this->k;
                         }
 
-                        void _retrieve_metadata_() {
-                            // k, bit_counter, metadata_size
-                            if( this->is_open ) {
-                                // std::cout << "OfflineRCodecReader/_retrieve_metadata_> (0) serializer size = " << this->serializer->size() << std::endl;
-                                std::size_t nbytes = this->serializer->size();
-                                this->serializer->seek( nbytes - sizeof(std::size_t) );
+                        const std::size_t get_value_counter() const {
+                            return this->value_counter;
+                        }
 
-                                std::size_t metadata_size = this->serializer->template next<std::size_t>();
-                                // std::cout << "OfflineRCodecReader/_retrieve_metadata_> (1) tellg = " << this->serializer->tell() << "; metadata_size = " << metadata_size << std::endl;
+                        const std::size_t get_bit_counter() const {
+                            return this->bit_counter;
+                        }
+
+                        const bool add( const Word n ) override final {
+                            this->bit_counter += Code::put( this->bits, n, this->k );
+                            ++(this->value_counter);
+                            LOG("OfflineUniversalCodecWriter/add> n = %lu; bit_counter = %zu", (std::uint64_t) n, this->bit_counter);
+                            return true; // To fulfill inheritance requirements.
+                        }
+
+                        const std::vector<std::size_t> get_metadata() const override {
+                            return this->metadata;
+                        }
+
+                        void close( ) override {
+                            // Write pending bits, padded with zeros up to a whole word:
+                            this->bits.flush( sizeof(Word) );
+                            // Appending metadata:
+                            this->push_metadata( this->value_counter );
+                            this->push_metadata( this->bit_counter );
+                            this->push_metadata( this->k );
+                            this->push_metadata( Code::TYPE );
+                            this->_save_metadata_();
+                            this->serializer->close();
+                        }
+                };
 
-                                this->serializer->seek( nbytes - ((metadata_size + 1) * sizeof(std::size_t)) );
+                template<typename Word> using OfflineExpGolombCodecWriter = OfflineUniversalCodecWriter<Word, samg::grcodec::toolkits::ExpGolombCode>;
+                template<typename Word> using OfflineEliasGammaCodecWriter = OfflineUniversalCodecWriter<Word, samg::grcodec::toolkits::EliasGammaCode>;
+                template<typename Word> using OfflineEliasDeltaCodecWriter = OfflineUniversalCodecWriter<Word, samg::grcodec::toolkits::EliasDeltaCode>;
+            }
 
-                                // std::cout << "OfflineRCodecReader/_retrieve_metadata_> (2) tellg = " << this->serializer->tell() << std::endl;
+            namespace reader {
+                /**
+                 * @brief Reads a sequence written by `universal::writer::OfflineUniversalCodecWriter` with the same `Code`. Codeword lengths are resolved with `countr_zero` on 64-bit windows of the bitmap.
+                 * 
+                 * @tparam Word used to decode bits.
+                 * @tparam Code is one of `toolkits::ExpGolombCode`, `toolkits::EliasGammaCode` or `toolkits::EliasDeltaCode`.
+                 */
+                template<typename Word, typename Code = samg::grcodec::toolkits::ExpGolombCode> class OfflineUniversalCodecReader : public samg::grcodec::base::reader::CodecFileReader<Word>, public samg::grcodec::base::MetadataSaver {
+                    private:
+                        const std::size_t offset;
+                        std::unique_ptr<samg::serialization::OfflineWordReader<Word>> serializer;
+                        samg::grcodec::toolkits::BitBuffer<samg::serialization::OfflineWordReader<Word>> bits;
+                        std::size_t k,
+                                    bit_limit,
+                                    bit_counter,
+                                    value_count; // Number of values in the whole file.
+                        bool is_open;
 
+                        void _retrieve_metadata_() {
+                            // code type, k, bit_counter, value_count, metadata_size
+                            if( this->is_open ) {
+                                std::size_t nbytes = this->serializer->size();
+                                this->serializer->seek( nbytes - sizeof(std::size_t) , std::ios_base::beg );
+                                std::size_t metadata_size = this->serializer->template next<std::size_t>();
+                                this->serializer->seek( nbytes - ((metadata_size + 1) * sizeof(std::size_t)), std::ios_base::beg );
                                 for (std::size_t i = 0; i < metadata_size; i++) {
-                                    std::size_t v = this->serializer->template next<std::size_t>();
-                                    this->add_metadata( v );
-                                    // std::cout << "OfflineRCodecReader/_retrieve_metadata_> (2) \t\ttellg = " << this->serializer->tell() << "; v = " << v << std::endl;
+                                    this->add_metadata( this->serializer->template next<std::size_t>() );
                                 }
-                                
-                                this->serializer->seek( 0 );
-                                // std::cout << "OfflineRCodecReader/_retrieve_metadata_> (3) tellg = " << this->serializer->tell() << std::endl;
+                                this->serializer->seek( this->offset / samg::constants::BITS_PER_BYTE, std::ios::beg );
                             }
                         }
 
                     public:
                         /**
-                         * @brief Construct a new Binary Sequence object
+                         * @brief Construct a new Offline Universal Codec Reader object
                          * 
                          * @param file_name 
                          * @param offset in bits
                          * @param limit in bits
                          */
-                        OnlineRCodecReader( const std::string file_name, const std::size_t offset = 0ULL, const std::size_t limit = 0ULL ) :
+                        OfflineUniversalCodecReader( const std::string file_name, const std::size_t offset = 0ZU, const std::size_t limit = 0ZU ) :
                             samg::grcodec::base::reader::CodecFileReader<Word>::CodecFileReader( file_name ),
-                            MAX ( ~( (Word) 0 ) ),
                             offset ( offset ),
                             is_open ( false ) {
-                            
-                            // std::cout << "OfflineRCodecReader/init> (1)" << std::endl;
-
                             this->restart();
 
-                            // std::cout << "OfflineRCodecReader/init> (2)" << std::endl;
-                            
                             // Loading metadata:
                             this->_retrieve_metadata_();
+                            if( this->metadata.size() < 4ZU ) {
+                                throw std::runtime_error("OfflineUniversalCodecReader> Missing metadata in "+file_name+".");
+                            }
+                            if( this->metadata[0] != Code::TYPE ) {
+                                throw std::runtime_error("OfflineUniversalCodecReader> "+file_name+" was written with code type "+std::to_string(this->metadata[0])+", not "+std::to_string(Code::TYPE)+".");
+                            }
+                            this->k = this->metadata[1];
+                            this->bit_limit = ( limit == 0 ) ? this->metadata[2] : limit;
+                            this->value_count = this->metadata[3];
+                            this->metadata.erase( this->metadata.begin(), this->metadata.begin() + 4 ); // Erasing code type, k, bit_limit and value_count from metadata.
 
-                            // std::cout << "OfflineRCodecReader/init> (3)" << std::endl;
-                            // std::vector<std::size_t>metadata = this->get_metadata();
-                            // this->k = this->serializer->template next<std::size_t>();
-                            // this->bit_limit = this->serializer->template next<std::size_t>();
-                            this->k = this->metadata[0];
-                            this->bit_limit = ( limit == 0 ) ? this->metadata[1] : limit;
-                            this->metadata.erase( this->metadata.begin() ); // Erasing k from metadata.
-                            this->metadata.erase( this->metadata.begin() ); // Erasing bit_limit from metadata.
-
-                            // std::cout << "OfflineRCodecReader/init> (4) k = " << this->k << "; bit_limit = " << this->bit_limit << std::endl;
-                            // std::cout << "OfflineRCodecReader/init> k = " << this->k << "; bit_limit = " << this->bit_limit << std::endl;
-
-                            // Seting environment:
-                            this->R_MASK = MAX << this->k;
-
-                            // LOG("OfflineRCodecReader/init> MAX = %u; offset = %zu; RMASK = %u; k = %zu; position = %zu; bit_limit = %zu; bit_counter = %zu; is_open = %u", this->MAX, this->offset, this->R_MASK, this->k, this->position, this->bit_limit, this->bit_counter, this->is_open);
-                            
-                            // // Set the starting byte within the serialization based on the input offset:
-                            // this->serializer->seek( std::ceil((std::double_t)offset/(std::double_t)BITS_PER_BYTE), std::ios::beg );
-                            // std::cout << "OfflineRCodecReader/init> (5)" << std::endl;
+                            LOG("OfflineUniversalCodecReader/init> offset = %zu; k = %zu; bit_limit = %zu; value_count = %zu", this->offset, this->k, this->bit_limit, this->value_count);
                         }
 
                         /**
@@ -1358,66 +3524,48 @@ namespace samg {
                             return this->k;
                         }
 
-                        const Word next( ) override { 
-                            // LOG("OfflineRCodecReader/next> [BEGIN] k = %zu; position = %zu; bit_limit = %zu; bit_counter = %zu; buffer_length = %zu [b]; buffer = %s", this->k, this->position, this->bit_limit, this->bit_counter, this->_get_buffer_length_(), samg::utils::to_string<Word>(this->buffer).c_str());
-                            // NOTE: Based on `samg::grcodec::toolkits::GolombRiceCommon<Word>::_rice_decode_`.
-                            while( this->position > this->_get_buffer_length_() || ( this->_get_buffer_length_() - this->position ) < this->k ) {
-                                this->_fecth_();
-                            }
-
-                            // LOG("OfflineRCodecReader/next> [MID] k = %zu; position = %zu; bit_limit = %zu; bit_counter = %zu; buffer_length = %zu [b]; buffer = %s", this->k, this->position, this->bit_limit, this->bit_counter, this->_get_buffer_length_(), samg::utils::to_string<Word>(this->buffer).c_str());
-
-                            // LOG("OfflineRCodecReader/next> %s", samg::utils::to_string( this->buffer.data(), this->buffer.size(), this->buffer.size() * sizeof(Word) * samg::constants::BITS_PER_BYTE, true, this->position ).c_str() );
-
-                            // Retrieve reminder:
-                            Word v = samg::grcodec::toolkits::GolombRiceCommon<Word>::_bitread_( this->buffer.data(), this->position, this->k );
-                            // Word v = samg::grcodec::toolkits::GolombRiceCommon<Word>::_bitread_( this->buffer.begin(), this->position, this->k );
-                            this->position += this->k;
-                            this->bit_counter += this->k;
+                        /**
+                         * @brief Returns the number of values in the whole file (regardless of `offset` and `limit`).
+                         * 
+                         * @return const std::size_t 
+                         */
+                        const std::size_t get_value_count() const {
+                            return this->value_count;
+                        }
 
-                            // Retrieve quotient:
-                            this->_update_();
-                            while ( samg::grcodec::toolkits::GolombRiceCommon<Word>::_bitget_( this->buffer.data() , this->position ) ) {
-                            // while ( samg::grcodec::toolkits::GolombRiceCommon<Word>::_bitget_( this->buffer.begin() , this->position ) ) {
-                                v += ( 1 << this->k );
-                                ++(this->position);
-                                ++(this->bit_counter);
-                                this->_update_();
-                            }
-                            ++(this->position);
-                            ++(this->bit_counter);
-                            // std::cout << "OfflineRCodecReader/next> \t\t[END] k = " << this->k << "; bit_limit = " << this->bit_limit << "; position = " << this->position << "; bit_counter = " << this->bit_counter << std::endl;
-                            // LOG("OfflineRCodecReader/next> [END] k = %zu; position = %zu; bit_limit = %zu; bit_counter = %zu; v = %u", this->k, this->position, this->bit_limit, this->bit_counter, v);
+                        const Word next( ) override final { 
+                            const Word v = Code::template get<Word>( this->bits, this->k );
+                            this->bit_counter = this->bits.tell();
+                            LOG("OfflineUniversalCodecReader/next> k = %zu; bit_limit = %zu; bit_counter = %zu; v = %lu", this->k, this->bit_limit, this->bit_counter, (std::uint64_t) v);
                             return v;
                         }
 
-                        const bool has_more( ) const override {
-                            return this->bit_counter < this->bit_limit; //this->serializer->has_more();
+                        const bool has_more( ) const override final {
+                            return this->bit_counter < this->bit_limit;
+                        }
+
+                        std::size_t decode_block( Word* out, const std::size_t n ) override {
+                            std::size_t i = 0;
+                            for(; i < n && this->bits.tell() < this->bit_limit; ++i ) {
+                                out[i] = Code::template get<Word>( this->bits, this->k );
+                            }
+                            this->bit_counter = this->bits.tell();
+                            return i;
                         }
 
                         void restart() override {
                             this->close();
-
-                            this->serializer = std::make_unique<samg::serialization::OnlineWordReader<Word>>( this->get_file_name() );
+                            this->serializer = std::make_unique<samg::serialization::OfflineWordReader<Word>>( this->get_file_name() );
                             
                             // Set the starting byte within the serialization based on the input offset:
-                            std::size_t bytes = std::floor((std::double_t)this->offset/(std::double_t)samg::constants::BITS_PER_BYTE),
-                                        words = std::floor((std::double_t)bytes / (std::double_t)sizeof(Word));
-
-                            this->position = this->offset - ( words * sizeof(Word) * samg::constants::BITS_PER_BYTE ); //( byte * BITS_PER_BYTE ) - this->offset;
-                            this->bit_counter = this->offset;//( words * sizeof(Word) * BITS_PER_BYTE ); // - this->offset ;// 0ULL;
-                            this->serializer->seek( words * sizeof(Word) );
+                            this->serializer->seek( this->offset / samg::constants::BITS_PER_BYTE, std::ios::beg );
+                            this->bits.reset( this->serializer.get(), this->offset );
+                            this->bit_counter = this->offset;
 
                             this->is_open = true;
-
-                            // LOG("OfflineRCodecReader/restart> bytes = %zu, position = %zu; bit_counter = %zu; bit_limit = %zu",bytes, this->position, this->bit_counter, this->bit_limit);
-
                         }
 
                         const std::vector<std::size_t> get_metadata() const override {
-                            // Take out k and bit_counter entries in the metadata list:
-                            // std::vector<std::size_t> tmp = std::vector<std::size_t>( this->metadata.begin() + 2, this->metadata.end() );
-                            // return tmp;
                             return this->metadata;
                         }
 
@@ -1438,16 +3586,23 @@ namespace samg {
                             }
                         }
                 };
+
+                template<typename Word> using OfflineExpGolombCodecReader = OfflineUniversalCodecReader<Word, samg::grcodec::toolkits::ExpGolombCode>;
+                template<typename Word> using OfflineEliasGammaCodecReader = OfflineUniversalCodecReader<Word, samg::grcodec::toolkits::EliasGammaCode>;
+                template<typename Word> using OfflineEliasDeltaCodecReader = OfflineUniversalCodecReader<Word, samg::grcodec::toolkits::EliasDeltaCode>;
             }
         }
-        
+
         namespace golomb {
             /**
-             * @brief This class represents a Golomb-Rice encoding of a sequence of integers.
+             * @brief This class represents a Golomb-Rice encoding of a sequence of integers. Codewords are packed LSB-first into a contiguous buffer of 64-bit words: the remainder r = n mod m in truncated binary (b - 1 bits for the first c = 2^b - m remainders, b bits for the others, where b = ceil(log2(m))), followed by the quotient n / m in unary (ones terminated by a 0).
+             * @note When m is a power of 2 (c = 0), codewords are identical to the Rice codewords of order log2(m) written by `OfflineRCodecWriter`.
+             * @note The b-bit remainders are stored as `((r + c) >> 1) | (((r + c) & 1) << (b - 1))`, so their first b - 1 bits are the MSB-first prefix that tells them apart from the short ones.
+             * @note With `EXPONENTIAL_GOLOMB`, codewords are Exp-Golomb codes of order floor(log2(m)), identical to those written by `universal::writer::OfflineExpGolombCodecWriter`.
              * 
-             * @tparam Type 
+             * @tparam Type
              * 
-             * @note It requires [https://github.com/simongog/sdsl-lite sdsl] library.
+             * @note It requires [https://github.com/simongog/sdsl-lite sdsl] library (only for the `sdsl::bit_vector` based interface).
              */
             template<typename Type> class GRCodec {
                 static_assert(
@@ -1456,287 +3611,242 @@ namespace samg {
                         std::is_same_v<Type, std::uint32_t> ||
                         std::is_same_v<Type, std::uint64_t>,
                         "typename must be one of std::uint8_t, std::uint16_t, std::uint32_t, or std::uint64_t");
+                public:
+                    enum GRCodecType {
+                        GOLOMB_RICE,
+                        EXPONENTIAL_GOLOMB
+                    };
                 private:
-                    // static const std::size_t BITS_PER_BYTE = sizeof(std::uint8_t)*8;
-                    std::size_t m;
-                    sdsl::bit_vector sequence;
-                    std::uint64_t iterator_index;
+                    std::size_t m,
+                                b, // Length of the long remainders.
+                                c, // Number of short (b - 1 bits) remainders.
+                                k; // Exp-Golomb order.
+                    std::vector<std::uint64_t> words; // Packed codewords.
+                    std::size_t bit_length, // Number of stored bits.
+                                iterator_index; // Bit position of the next codeword.
+
+                    static inline std::uint64_t _mask_( const std::size_t len ) {
+                        return ( len >= 64ZU ) ? ~0ULL : ( 1ULL << len ) - 1ULL;
+                    }
 
                     /**
-                     * @brief This function allows computing the log2 of x.
+                     * @brief Computes b and c for m.
                      * 
-                     * @param x 
-                     * @return std::double_t 
+                     * @param m 
+                     * @param b 
+                     * @param c 
                      */
-                    static const std::double_t log2(const double x) {
-                        return std::log(x) / std::log(2.0); // NOTE Much more efficient than std::log2! 34 nanoseconds avg.
-                        // return std::log2(x); // NOTE 180 nanoseconds avg.
+                    static void _parameters_( const std::size_t m, std::size_t& b, std::size_t& c ) {
+                        if( m == 0ZU ) {
+                            throw std::invalid_argument("GRCodec> m must be positive.");
+                        }
+                        b = std::bit_width( (std::uint64_t) ( m - 1ZU ) );
+                        c = ( ( b >= 64ZU ) ? 0ULL : ( 1ULL << b ) ) - m; // 2^b - m (mod 2^64 when b = 64).
                     }
 
                     /**
-                     * @brief This function allows checking whether x is or not a power of 2.
+                     * @brief Returns the Exp-Golomb order for m, i.e., floor(log2(m)).
                      * 
-                     * @param x 
-                     * @param T
-                     * @return true 
-                     * @return false 
+                     * @param m 
+                     * @return std::size_t 
                      */
-                    static const bool _is_power_of_2_(const Type x) {
-                        /* Examples:
-                        x         = 0000 0111 = 7
-                        x - 1     = 0000 0110
-                        x & (x-1) = 0000 0110 --> false
-                        ---------------------
-                        x         = 0001 0000 = 16
-                        x - 1     = 0000 1111
-                        x & (x-1) = 0000 0000 --> true
-                        ---------------------
-                        x         = 0010 0101 = 37
-                        x - 1     = 0010 0100
-                        x & (x-1) = 0010 0100 --> false
-                        */
-                        return (x > 0) && ((x & (x - 1)) == 0);
+                    static inline std::size_t _order_( const std::size_t m ) {
+                        return ( m == 0ZU ) ? 0ZU : (std::size_t) std::bit_width( (std::uint64_t) m ) - 1ZU;
                     }
 
-                    /**
-                     * @brief This function allows getting a sub-vector from v.
-                     * 
-                     * @param v 
-                     * @param begin 
-                     * @param length 
-                     * @return sdsl::bit_vector 
-                     */
-                    static sdsl::bit_vector _get_sub_vector_( const sdsl::bit_vector &v, const std::uint64_t begin, const std::size_t length ) {
-                        sdsl::bit_vector rv(length);
-                        for (std::size_t i = begin; i < (begin + length); i++) {
-                            rv[i-begin] = v[i];
+                    static void _check_type_( const GRCodecType type ) {
+                        if( type != GRCodecType::GOLOMB_RICE && type != GRCodecType::EXPONENTIAL_GOLOMB ) {
+                            throw std::runtime_error("Not valid or not implemented algorithm!");
                         }
-                        return rv;
                     }
 
                     /**
-                     * @brief This function allows converting from unary into decimal.
-                     * 
-                     * @param v 
-                     * @return const std::size_t 
+                     * @brief Appends the lowest `len` bits of `bits` (len <= 64; higher bits must be 0).
                      * 
-                     * @warning It is assumed that v starts with unary code.
+                     * @param words 
+                     * @param bit_length 
+                     * @param bits 
+                     * @param len 
                      */
-                    static const std::size_t _decode_unary_( const sdsl::bit_vector &v, std::uint64_t begin ) {
-                        /* NOTE
-                            987654
-                            111110
-                            begin = 9
-                            i = 987654
-                                    ^
-                            Therefore 9 - 4 = 5 ones!
-                        */
-                        // Counting ones:
-                        std::size_t i = begin;
-                        for (; 0 <= i && i < v.size() ; --i) {
-                            if( v[i] == 0 ) {
-                                break;
+                    static inline void _put_( std::vector<std::uint64_t>& words, std::size_t& bit_length, const std::uint64_t bits, const std::size_t len ) {
+                        if( len == 0ZU ) {
+                            return;
+                        }
+                        const std::size_t offset = bit_length & 63ZU;
+                        if( offset == 0ZU ) {
+                            words.push_back( bits );
+                        } else {
+                            words.back() |= bits << offset;
+                            if( offset + len > 64ZU ) {
+                                words.push_back( bits >> ( 64ZU - offset ) );
                             }
                         }
-                        return (begin - i);
+                        bit_length += len;
                     }
 
                     /**
-                     * @brief This method allows computing the next codeword length in a sequence in v.
+                     * @brief Returns the 64 bits starting at bit `position`; bits past the end read as 0.
                      * 
-                     * @param v 
-                     * @param m 
-                     * @return const std::size_t 
+                     * @param words 
+                     * @param nwords 
+                     * @param position 
+                     * @return std::uint64_t 
                      */
-                    static const std::size_t _get_next_codeword_length_( const sdsl::bit_vector &v, const std::size_t m, const std::uint64_t begin ) {
-                        std::size_t A = GRCodec::_decode_unary_( v, begin ), 
-                                    s = std::ceil(GRCodec::log2(m));
-                        if(  GRCodec::_is_power_of_2_(m) ) {// Acting as Rice.
-                            // Computing length:
-                            return A + 1 + s;
-                        } else { // Acting as Golomb.
-                            // Retrieving R:
-                            /* NOTE
-                                9876543210
-                                1111100101
-                                
-                                A = 5
-                                begin = 9
-                                s = 5
-                                get sub-vector --> [ begin-A-1-(s-2) , length = s-1 ] === [ 0 , 3 ]
-                            */
-                            sdsl::bit_vector rv = GRCodec::_get_sub_vector_(v,begin-A-1-(s-2),s-1);
-                            Type R = rv.get_int( 0, sizeof(Type) * samg::constants::BITS_PER_BYTE );
-                            // Computing length:
-                            std::size_t c = std::pow(2,std::ceil(GRCodec::log2(m))) - m;
-                            return A + 1 + ( R >= c ? s : s - 1 );
+                    static inline std::uint64_t _peek_( const std::uint64_t* words, const std::size_t nwords, const std::size_t position ) {
+                        const std::size_t i = position >> 6,
+                                          offset = position & 63ZU;
+                        if( i + 1ZU < nwords ) { // Common case; `<< 1 << (63 - offset)` is 0 when offset is 0.
+                            return ( words[i] >> offset ) | ( ( words[i + 1ZU] << 1 ) << ( 63ZU - offset ) );
                         }
+                        return ( i < nwords ) ? words[i] >> offset : 0ULL;
                     }
 
-                    /**
-                     * @brief This function allows referring encoding computation to either Rice or Golomb functions based on whether n is a power of 2 or not, respectively. 
-                     * 
-                     * @param n 
-                     * @param m 
-                     * @param T
-                     * @return sdsl::bit_vector 
-                     */
-                    static sdsl::bit_vector _encode_golomb_rice_(const Type n, const std::size_t m) {
-                        Type    q = std::floor( ((std::double_t) n) / ((std::double_t)m) ),
-                                r = n - ( m * q );
-
-                        if(  GRCodec::_is_power_of_2_(m) ) { // Acting as Rice encoder.
-                            return GRCodec::_rice_encode_( n, q, r, m );   
-                        } else { // Acting as Golomb encoder.
-                            return GRCodec::_golomb_encode_( n, q, r, m );
+                    static inline void _put_codeword_( std::vector<std::uint64_t>& words, std::size_t& bit_length, const std::uint64_t n, const std::size_t m, const std::size_t b, const std::size_t c ) {
+                        std::uint64_t q = n / m;
+                        const std::uint64_t r = n - q * m;
+                        // Remainder in truncated binary:
+                        if( c == 0ZU ) { // Acting as Rice.
+                            GRCodec::_put_( words, bit_length, r, b );
+                        } else if( r < c ) {
+                            GRCodec::_put_( words, bit_length, r, b - 1ZU );
+                        } else {
+                            const std::uint64_t x = r + c;
+                            GRCodec::_put_( words, bit_length, ( x >> 1 ) | ( ( x & 1ULL ) << ( b - 1ZU ) ), b );
                         }
+                        // Quotient in unary:
+                        for(; q >= 64ZU; q -= 64ZU ) {
+                            GRCodec::_put_( words, bit_length, ~0ULL, 64ZU );
+                        }
+                        GRCodec::_put_( words, bit_length, ( 1ULL << q ) - 1ULL, q + 1ZU );
                     }
 
-                    /**
-                     * @brief This function allows encoding n using the Rice algorithm. 
-                     * 
-                     * @param n 
-                     * @param q 
-                     * @param r 
-                     * @param m
-                     * @return sdsl::bit_vector 
-                     */
-                    static sdsl::bit_vector _rice_encode_(const Type n, const Type q, const Type r, const std::size_t m) {
-                        static std::size_t r_bits, prev_m = 0; // Using simple memoization method for log2. 
-                        
-                        if ( m != prev_m ) {
-                            r_bits = (std::size_t)log2(m);
-                            prev_m = m;
+                    static inline Type _get_codeword_( const std::uint64_t* words, const std::size_t nwords, std::size_t& position, const std::size_t m, const std::size_t b, const std::size_t c ) {
+                        std::uint64_t w = GRCodec::_peek_( words, nwords, position ),
+                                      r;
+                        std::size_t used;
+                        if( c == 0ZU ) {
+                            r = ( b == 0ZU ) ? 0ULL : w & ( ~0ULL >> ( 64ZU - b ) );
+                            used = b;
+                        } else {
+                            const std::uint64_t x = w & ( ( 1ULL << ( b - 1ZU ) ) - 1ULL ), // b - 1 < 64 as c > 0.
+                                                y = ( ( x << 1 ) | ( ( w >> ( b - 1ZU ) ) & 1ULL ) ) - c;
+                            const bool is_short = x < c; // Branch-free selection; remainders are close to uniform.
+                            r = is_short ? x : y;
+                            used = b - (std::size_t) is_short;
                         }
-                        
-                        sdsl::bit_vector v(r_bits + q + 1);
-                        
-                        v.set_int(0,r,samg::constants::BITS_PER_BYTE);
-
-                        for (std::size_t i = r_bits + 1; i < (r_bits + q + 1); ++i) {
-                            v[i] = 1;
-                        } // v[r_bits] = 0 as the sdsl::bit_vector initialization default value is 0. 
-                        
-                        return v;
+                        // Unary quotient: count the ones with a single `countr_one` whenever the codeword fits in the peeked word.
+                        std::uint64_t q = ( used < 64ZU ) ? (std::uint64_t) std::countr_one( w >> used ) : 64ULL;
+                        if( used + q < 64ZU ) {
+                            position += used + q + 1ZU;
+                        } else {
+                            position += used;
+                            q = 0ULL;
+                            for(;;) {
+                                const std::size_t ones = std::countr_one( GRCodec::_peek_( words, nwords, position ) );
+                                q += ones;
+                                if( ones < 64ZU ) {
+                                    position += ones + 1ZU;
+                                    break;
+                                }
+                                position += 64ZU;
+                            }
+                        }
+                        return (Type) ( q * m + r );
                     }
 
                     /**
-                     * @brief This function allows encoding n using the Golomb algorithm. 
+                     * @brief Appends the Exp-Golomb code of order k of n: with x = n + 2^k and l = floor(log2(x)), l - k zeros, a 1, and the low l bits of x (see `toolkits::BitWriter::put_exp_golomb`).
                      * 
+                     * @param words 
+                     * @param bit_length 
                      * @param n 
-                     * @param q 
-                     * @param r 
-                     * @param m
-                     * @return sdsl::bit_vector 
+                     * @param k 
                      */
-                    static sdsl::bit_vector _golomb_encode_(const Type n, const Type q, const Type r, const std::size_t m) {
-                        std::size_t c = std::pow(2,std::ceil(GRCodec::log2(m))) - m;
-                        std::double_t x = GRCodec::log2(m);
-                        bool phase = r < c;
-                        std::size_t r_bits = (std::size_t) ( phase ? std::floor(x) : std::ceil(x) );
-                        sdsl::bit_vector v(r_bits + q + 1);
-                        
-                        if( phase ) {
-                            v.set_int(0,r,samg::constants::BITS_PER_BYTE);
+                    static inline void _put_exp_golomb_( std::vector<std::uint64_t>& words, std::size_t& bit_length, const std::uint64_t n, const std::size_t k ) {
+                        const std::uint64_t x = n + ( 1ULL << k ); // Wraps around when n + 2^k = 2^64 or more.
+                        const std::size_t l = ( x < n ) ? 64ZU : (std::size_t) std::bit_width( x ) - 1ZU,
+                                          zeros = l - k;
+                        if( zeros + 1ZU + l <= 64ZU ) {
+                            GRCodec::_put_( words, bit_length, ( ( ( x & GRCodec::_mask_( l ) ) << 1 ) | 1ULL ) << zeros, zeros + 1ZU + l );
                         } else {
-                            v.set_int(0,r+c,samg::constants::BITS_PER_BYTE);
+                            GRCodec::_put_( words, bit_length, 0ULL, zeros );
+                            GRCodec::_put_( words, bit_length, 1ULL, 1ZU );
+                            GRCodec::_put_( words, bit_length, x & GRCodec::_mask_( l ), l );
                         }
-
-                        for (std::size_t i = r_bits + 1; i < (r_bits + q + 1); ++i) {
-                            v[i] = 1;
-                        } // v[r_bits] = 0 as the sdsl::bit_vector initialization default value is 0. 
-                        
-                        return v;
                     }
 
-                    /**
-                     * @brief This function allows referring decoding computation to either Rice or Golomb functions based on whether n is a power of 2 or not, respectively. 
-                     * 
-                     * @param v 
-                     * @param m
-                     * @return Type
-                     */
-                    static Type _decode_golomb_rice_(sdsl::bit_vector &v, const std::size_t m) {
-                        std::size_t A = 0ul, 
-                                    s = std::ceil(GRCodec::log2(m)),
-                                    i = v.size()-1;
-
-                        // Counting ones:
-                        for (; 0 <= i && i < v.size() ; --i) {
-                            if( v[i] == 1 ) {
-                                ++A;
-                                v[i] = 0;
-                            } else { 
-                                break;
+                    static inline Type _get_exp_golomb_( const std::uint64_t* words, const std::size_t nwords, std::size_t& position, const std::size_t k ) {
+                        const std::uint64_t w = GRCodec::_peek_( words, nwords, position );
+                        std::size_t zeros = std::countr_zero( w );
+                        if( 2ZU * zeros + k + 1ZU <= 64ZU ) { // Fast path: the whole codeword lies within the peeked word.
+                            const std::size_t l = zeros + k;
+                            position += zeros + 1ZU + l;
+                            return (Type) ( ( ( w >> ( zeros + 1ZU ) ) & GRCodec::_mask_( l ) ) + ( 1ULL << l ) - ( 1ULL << k ) );
+                        }
+                        if( zeros == 64ZU ) { // At most 64 zeros in a valid codeword.
+                            zeros += std::countr_zero( GRCodec::_peek_( words, nwords, position + 64ZU ) );
+                            if( zeros > 64ZU ) {
+                                throw std::runtime_error("GRCodec> More than 64 leading zeros in an Exp-Golomb codeword.");
                             }
                         }
-
-                        if( GRCodec::_is_power_of_2_(m) ) { // Acting as Rice decoder.
-                            return GRCodec::_rice_decode_( v, A, m );
-                        } else { // Acting as Golomb decoder.
-                            return GRCodec::_golomb_decode_( v, A, m );
+                        const std::size_t l = zeros + k;
+                        if( l > 64ZU ) {
+                            throw std::runtime_error("GRCodec> Exp-Golomb codeword of "+std::to_string(l)+" value bits does not fit 64 bits.");
                         }
-                    }
-
-                    /**
-                     * @brief This function allows decoding n using the Rice algorithm. 
-                     * 
-                     * @param v 
-                     * @param A 
-                     * @param m
-                     * @return Type 
-                     */
-                    static Type _rice_decode_(sdsl::bit_vector &v, const std::size_t A, const std::size_t m) {
-                        // auto start = std::chrono::high_resolution_clock::now();
-                        Type R = v.get_int( 0, sizeof(Type) * samg::constants::BITS_PER_BYTE ),
-                             ans = ( m * A ) + R;
-                        // auto end = std::chrono::high_resolution_clock::now();
-                        // double time_taken = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-                        // printf("*** Rice decoding time %.2f[ns]\n",time_taken);
-
-                        return ans;
-                        // return ( m * A ) + R;
-                    }
-
-                    /**
-                     * @brief This function allows decoding n using the Golomb algorithm. 
-                     * 
-                     * @param v 
-                     * @param A
-                     * @param m 
-                     * @return Type
-                     */
-                    static Type _golomb_decode_(sdsl::bit_vector &v, const std::size_t A, const std::size_t m) {
-                        std::size_t c = std::pow(2,std::ceil(GRCodec::log2(m))) - m;
-                        Type    R = v.get_int( 0, sizeof(Type) * samg::constants::BITS_PER_BYTE ),
-                                n = GRCodec::_rice_decode_( v, A, m );
-
-                        return ( R >= c )? ( n - c ) : n;
+                        position += zeros + 1ZU;
+                        const std::uint64_t low = GRCodec::_peek_( words, nwords, position ) & GRCodec::_mask_( l );
+                        position += l;
+                        return (Type) ( low + ( ( l >= 64ZU ) ? 0ULL : 1ULL << l ) - ( 1ULL << k ) );
                     }
 
                 public:
-                    enum GRCodecType {
-                        GOLOMB_RICE,
-                        EXPONENTIAL_GOLOMB
-                    } type;
+                    GRCodecType type;
 
                     GRCodec():
-                        m(8),
-                        type(GRCodecType::GOLOMB_RICE)
-                    {}
+                        GRCodec( 8ZU ) {}
 
                     GRCodec(const std::size_t m, const GRCodecType type=GRCodecType::GOLOMB_RICE): 
                         m(m), 
+                        bit_length(0ZU),
                         type(type)
                     {
+                        GRCodec::_parameters_( m, this->b, this->c );
+                        this->k = GRCodec::_order_( m );
                         this->restart();
                     }
 
+                    /**
+                     * @brief Construct a new GRCodec object over the bits of `sequence` (as returned by `get_bit_vector`).
+                     * 
+                     * @param sequence 
+                     * @param m 
+                     * @param type 
+                     */
                     GRCodec(sdsl::bit_vector sequence, const std::size_t m, const GRCodecType type=GRCodecType::GOLOMB_RICE): 
-                        sequence(sequence),
+                        GRCodec( std::vector<std::uint64_t>( sequence.data(), sequence.data() + ( ( sequence.size() + 63ZU ) >> 6 ) ), sequence.size(), m, type ) {}
+
+                    /**
+                     * @brief Construct a new GRCodec object over `bit_length` packed bits.
+                     * 
+                     * @param words 
+                     * @param bit_length 
+                     * @param m 
+                     * @param type 
+                     */
+                    GRCodec(std::vector<std::uint64_t> words, const std::size_t bit_length, const std::size_t m, const GRCodecType type=GRCodecType::GOLOMB_RICE): 
                         m(m), 
+                        words(std::move(words)),
+                        bit_length(bit_length),
                         type(type)
                     {
+                        GRCodec::_parameters_( m, this->b, this->c );
+                        this->k = GRCodec::_order_( m );
+                        if( this->words.size() != ( ( bit_length + 63ZU ) >> 6 ) ) {
+                            throw std::invalid_argument("GRCodec> "+std::to_string(bit_length)+" bits do not fit "+std::to_string(this->words.size())+" words.");
+                        }
+                        if( ( bit_length & 63ZU ) != 0ZU ) {
+                            this->words.back() &= GRCodec::_mask_( bit_length & 63ZU ); // Appends rely on clean padding.
+                        }
                         this->restart();
                     }
 
@@ -1749,12 +3859,9 @@ namespace samg {
                      * @return sdsl::bit_vector 
                      */
                     static sdsl::bit_vector encode(const Type n, const std::size_t m, GRCodecType type = GRCodecType::GOLOMB_RICE ) {
-                        switch( type ) {
-                            case GRCodecType::GOLOMB_RICE:
-                                return GRCodec::_encode_golomb_rice_( n, m );
-                            default:
-                                throw std::runtime_error("Not valid or not implemented algorithm!");
-                        }
+                        GRCodec codec( m, type );
+                        codec.append( n );
+                        return codec.get_bit_vector();
                     }
                     
                     /**
@@ -1766,46 +3873,90 @@ namespace samg {
                      * @return Type 
                      */
                     static Type decode(sdsl::bit_vector v, const std::size_t m, GRCodecType type = GRCodecType::GOLOMB_RICE ) {
-                        switch( type ) {
-                            case GRCodecType::GOLOMB_RICE:
-                                return GRCodec::_decode_golomb_rice_( v, m );
-                            default:
-                                throw std::runtime_error("Not valid or not implemented algorithm!");
+                        GRCodec::_check_type_( type );
+                        return GRCodec( v, m, type ).next();
+                    }
+
+                    /**
+                     * @brief Encodes `n` integers with parameter m, appending them to `words`.
+                     * 
+                     * @param values 
+                     * @param n 
+                     * @param m 
+                     * @param words 
+                     * @param bit_length is the number of bits already in `words`; it is updated.
+                     * @param type 
+                     */
+                    static void encode( const Type* values, const std::size_t n, const std::size_t m, std::vector<std::uint64_t>& words, std::size_t& bit_length, const GRCodecType type = GRCodecType::GOLOMB_RICE ) {
+                        GRCodec::_check_type_( type );
+                        std::size_t b, c;
+                        GRCodec::_parameters_( m, b, c );
+                        if( type == GRCodecType::EXPONENTIAL_GOLOMB ) {
+                            const std::size_t k = GRCodec::_order_( m );
+                            for( std::size_t i = 0; i < n; ++i ) {
+                                GRCodec::_put_exp_golomb_( words, bit_length, values[i], k );
+                            }
+                            return;
+                        }
+                        for( std::size_t i = 0; i < n; ++i ) {
+                            GRCodec::_put_codeword_( words, bit_length, values[i], m, b, c );
                         }
                     }
 
                     /**
-                     * @brief This function allows appending the encoded representation of n to an internal bitmap.
+                     * @brief Decodes up to `n` integers encoded with parameter m from the packed bits [position, bit_length) of `words`.
                      * 
+                     * @param words 
+                     * @param bit_length 
+                     * @param m 
+                     * @param out 
                      * @param n 
+                     * @param position is the bit position of the first codeword; it is updated.
+                     * @param type 
+                     * @return std::size_t is the number of decoded integers.
+                     */
+                    static std::size_t decode( const std::uint64_t* words, const std::size_t bit_length, const std::size_t m, Type* out, const std::size_t n, std::size_t& position, const GRCodecType type = GRCodecType::GOLOMB_RICE ) {
+                        GRCodec::_check_type_( type );
+                        std::size_t b, c, i = 0;
+                        GRCodec::_parameters_( m, b, c );
+                        const std::size_t nwords = ( bit_length + 63ZU ) >> 6;
+                        if( type == GRCodecType::EXPONENTIAL_GOLOMB ) {
+                            const std::size_t k = GRCodec::_order_( m );
+                            for(; i < n && position < bit_length; ++i ) {
+                                out[i] = GRCodec::_get_exp_golomb_( words, nwords, position, k );
+                            }
+                            return i;
+                        }
+                        for(; i < n && position < bit_length; ++i ) {
+                            out[i] = GRCodec::_get_codeword_( words, nwords, position, m, b, c );
+                        }
+                        return i;
+                    }
+
+                    /**
+                     * @brief This function allows appending the encoded representation of n to an internal bitmap.
                      * 
-                     * @warning This implementation is O(n), where n is the number of bits in the internal bitmap.
+                     * @param n 
                      */
                     void append(const Type n) {
-                        /* NOTE
-                        ( 1 )
-                        10111
-                        ( 1 ) ( 2 ) 
-                        10111 11001
-                        ( 1 ) ( 2 ) ( 3 )
-                        10111 11001 11100101
-                        ( 1 ) ( 2 ) ( 3 )    ( 4 )
-                        10111 11001 11100101 xxxxxx
-                        */
-                        // Encode n:
-                        sdsl::bit_vector v = GRCodec::encode(n,this->m,this->type);
-
-                        // Fuse both the new codeword and the previous codewords:
-                        std::size_t s = v.size();
-                        v.resize(s + this->sequence.size());
-                        
-                        for (std::size_t i = s; i < v.size(); ++i) {
-                            v[i] = this->sequence[i-s];
+                        GRCodec::_check_type_( this->type );
+                        if( this->type == GRCodecType::EXPONENTIAL_GOLOMB ) {
+                            GRCodec::_put_exp_golomb_( this->words, this->bit_length, n, this->k );
+                        } else {
+                            GRCodec::_put_codeword_( this->words, this->bit_length, n, this->m, this->b, this->c );
                         }
-                        this->sequence = v; // Store fused internal bitmap.
+                    }
 
-                        // Update iterator index:
-                        this->iterator_index += s;
+                    /**
+                     * @brief This function allows appending the encoded representation of `n` integers to an internal bitmap.
+                     * 
+                     * @param values 
+                     * @param n 
+                     */
+                    void append(const Type* values, const std::size_t n) {
+                        GRCodec::_check_type_( this->type );
+                        this->words.reserve( this->words.size() + ( n * ( this->b + 2ZU ) ) / 64ZU + 1ZU );
+                        GRCodec::encode( values, n, this->m, this->words, this->bit_length, this->type );
                     }
 
                     /**
@@ -1814,15 +3965,22 @@ namespace samg {
                      * @return const Type 
                      */
                     const Type next() {
-                        // Retrieve codeword length:
-                        std::size_t codeword_length = GRCodec::_get_next_codeword_length_( this->sequence , this->m , this->iterator_index );
-                        // Copy sub-vetor defined from `0` to `codeword_length`:
-                        sdsl::bit_vector v = GRCodec::_get_sub_vector_(this->sequence,this->iterator_index - ( codeword_length - 1 ) , codeword_length ); 
-                        // Moving interal pointer `codeword_length` bits backward:
-                        this->iterator_index -= codeword_length;
-                        // Returning decoded codeword:
-                        return  GRCodec::decode(v,this->m,this->type);
-                    } 
+                        if( this->type == GRCodecType::EXPONENTIAL_GOLOMB ) {
+                            return GRCodec::_get_exp_golomb_( this->words.data(), this->words.size(), this->iterator_index, this->k );
+                        }
+                        return GRCodec::_get_codeword_( this->words.data(), this->words.size(), this->iterator_index, this->m, this->b, this->c );
+                    }
+
+                    /**
+                     * @brief Decodes up to `n` integers into `out`.
+                     * 
+                     * @param out 
+                     * @param n 
+                     * @return std::size_t is the number of decoded integers; it is less than `n` only at the end of the bitmap.
+                     */
+                    std::size_t decode_block( Type* out, const std::size_t n ) {
+                        return GRCodec::decode( this->words.data(), this->bit_length, this->m, out, n, this->iterator_index, this->type );
+                    }
 
                     /**
                      * @brief This function verifies whether the internal bitmap has or doesn't have more codewords to iterate on.
@@ -1831,7 +3989,7 @@ namespace samg {
                      * @return false 
                      */
                     const bool has_more() const {
-                        return this->sequence.size() > this->iterator_index && this->iterator_index >= 0ull;
+                        return this->iterator_index < this->bit_length;
                     }
 
                     /**
@@ -1839,7 +3997,7 @@ namespace samg {
                      * 
                      */
                     void restart() {
-                        this->iterator_index = this->sequence.size()-1;
+                        this->iterator_index = 0ZU;
                     }
 
                     /**
@@ -1848,7 +4006,22 @@ namespace samg {
                      * @return const sdsl::bit_vector 
                      */
                     const sdsl::bit_vector get_bit_vector() const {
-                        return this->sequence;
+                        sdsl::bit_vector v( this->bit_length );
+                        std::copy( this->words.begin(), this->words.end(), v.data() );
+                        return v;
+                    }
+
+                    /**
+                     * @brief This function returns the packed words of the internal bitmap.
+                     * 
+                     * @return const std::vector<std::uint64_t>& 
+                     */
+                    const std::vector<std::uint64_t>& get_words() const {
+                        return this->words;
+                    }
+
+                    const std::size_t get_m() const {
+                        return this->m;
                     }
 
                     /**
@@ -1857,11 +4030,11 @@ namespace samg {
                      * @return const std::size_t 
                      */
                     const std::size_t length() const {
-                        return this->sequence.size();
+                        return this->bit_length;
                     }
 
                     /**
-                     * @brief This function returns the current iterator index.
+                     * @brief This function returns the current iterator index, i.e., the bit position of the next codeword.
                      * 
                      * @return const std::uint64_t 
                      */
@@ -1870,16 +4043,13 @@ namespace samg {
                     }
 
                     friend std::ostream & operator<<(std::ostream & strm, const GRCodec<Type> &codec) {
-                        sdsl::bit_vector v = codec.get_bit_vector();
-                        bool printer_prompt = false;
-                        for (std::size_t i = v.size()-1; 0 <= i && i < v.size() ; --i) {
+                        for (std::size_t i = 0; i < codec.length(); ++i) {
                             if( i == codec.get_current_iterator_index() ) {
                                 strm << "|";
-                                printer_prompt = true;
                             }
-                            strm << v[i];
+                            strm << ( ( codec.get_words()[i >> 6] >> ( i & 63ZU ) ) & 1ULL );
                         }
-                        if( !printer_prompt ) {
+                        if( !codec.has_more() ) {
                             strm << "|";
                         }
                         return strm;
@@ -1890,12 +4060,13 @@ namespace samg {
         namespace runlength {
             namespace writer {
                 /**
-                 * @brief This class represents an unsigned integer Rice-runs encoder. This codec uses OfflineRCodecWriter class. 
+                 * @brief This class represents an unsigned integer Rice-runs encoder. This codec uses OfflineRCodecWriter class by default. 
                  * 
                  * @tparam Word 
-                 * @tparam std::size_t 
+                 * @tparam Queue is the FIFO type of the internal buffers; the non-virtual `adapter::RingBuffer` by default.
+                 * @tparam Encoder writes the run tokens; `rice::writer::OfflineRCodecWriter` by default, or any `universal::writer::OfflineUniversalCodecWriter`.
                  */
-                template<typename Word> class OfflineRiceRunsWriter : public samg::grcodec::base::writer::CodecFileWriter<Word>, samg::grcodec::base::MetadataKeeper {
+                template<typename Word, template<typename> class Queue = samg::grcodec::adapter::RingBuffer, typename Encoder = samg::grcodec::rice::writer::OfflineRCodecWriter<Word>> class OfflineRiceRunsWriter : public samg::grcodec::base::writer::CodecFileWriter<Word>, samg::grcodec::base::MetadataKeeper {
                     private:
                         /**
                          * @brief This class represents a FSM for encoding. 
@@ -1938,102 +4109,46 @@ namespace samg {
                                     EC_ERROR    //7
                                 };
 
-                                /**
-                                 * @brief Functions to be executed by each state.
-                                 * 
-                                 */
-                                const std::array<std::function<void( std::shared_ptr<samg::grcodec::base::writer::CodecWriter<Word>>, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t&, const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t, std::size_t&)>,10> sfunction = {
-                                    []( std::shared_ptr<samg::grcodec::base::writer::CodecWriter<Word>>codec, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &previous_n,const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, std::size_t &r ) { // ES_Q0
-                                        previous_n = n;
-                                        r = 1;
-                                    },
-                                    []( std::shared_ptr<samg::grcodec::base::writer::CodecWriter<Word>>codec, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &previous_n,const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, std::size_t &r ) { // ES_Q1
-                                        ++r;
-                                    },
-                                    []( std::shared_ptr<samg::grcodec::base::writer::CodecWriter<Word>>codec, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &previous_n,const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, std::size_t &r ) { // ES_Q2
-                                        _write_integer_( codec, previous_n, r );
-                                        previous_n = n;
-                                        r = 1;
-                                    },
-                                    []( std::shared_ptr<samg::grcodec::base::writer::CodecWriter<Word>>codec, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &previous_n,const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, std::size_t &r ) { // ES_Q3
-                                        _write_integer_( codec, previous_n, r );
-                                        previous_n = n;
-                                        r = 1;
-                                    },
-                                    []( std::shared_ptr<samg::grcodec::base::writer::CodecWriter<Word>>codec, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &previous_n,const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, std::size_t &r ) { // ES_Q4
-                                        _write_integer_( codec, previous_n, r, samg::grcodec::toolkits::RunLengthCommon<Word>::IS_NEGATIVE );
-                                        previous_n = n;
-                                        r = 1;
-                                    },
-                                    []( std::shared_ptr<samg::grcodec::base::writer::CodecWriter<Word>>codec, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &previous_n,const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, std::size_t &r ) { // ES_Q5
-                                        ++r;
-                                    },
-                                    []( std::shared_ptr<samg::grcodec::base::writer::CodecWriter<Word>>codec, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &previous_n,const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, std::size_t &r ) { // ES_Q6
-                                        _write_integer_( codec, previous_n, r, samg::grcodec::toolkits::RunLengthCommon<Word>::IS_NEGATIVE );
-                                        previous_n = n;
-                                        r = 1;
-                                    },
-                                    []( std::shared_ptr<samg::grcodec::base::writer::CodecWriter<Word>>codec, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &previous_n,const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, std::size_t &r ) { // ES_PSINK
-                                        _write_integer_( codec, previous_n, r );
-                                    },
-                                    []( std::shared_ptr<samg::grcodec::base::writer::CodecWriter<Word>>codec, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &previous_n,const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, std::size_t &r ) { // ES_NSINK
-                                        _write_integer_( codec, previous_n, r, samg::grcodec::toolkits::RunLengthCommon<Word>::IS_NEGATIVE );
-                                    },
-                                    []( std::shared_ptr<samg::grcodec::base::writer::CodecWriter<Word>>codec, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &previous_n,const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, std::size_t &r ) { // ES_ERROR
-                                        throw std::runtime_error("Encoding error state!");
-                                    }
-                                };
-
                                 /**
                                  * @brief States matrix.
                                  * 
                                  */
-                                const std::array<std::array<EState,8>,10> fsm = {
-                                                    //   n > 0                n < 0                 n > 0 & n == n'       n > 0 & n != n'       n < 0 & n == n'       n < 0 & n != n'       EOS                ERROR
-                                    std::array<EState,8>({EState::ES_ERROR,    EState::ES_Q3,        EState::ES_Q1,        EState::ES_Q2,        EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_PSINK,  EState::ES_ERROR}), // ES_Q0
-                                    std::array<EState,8>({EState::ES_ERROR,    EState::ES_Q3,        EState::ES_Q1,        EState::ES_Q2,        EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_PSINK,  EState::ES_ERROR}), // ES_Q1
-                                    std::array<EState,8>({EState::ES_ERROR,    EState::ES_Q3,        EState::ES_Q1,        EState::ES_Q2,        EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_PSINK,  EState::ES_ERROR}), // ES_Q2
-                                    std::array<EState,8>({EState::ES_Q6,       EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_Q5,        EState::ES_Q4,        EState::ES_NSINK,  EState::ES_ERROR}), // ES_Q3
-                                    std::array<EState,8>({EState::ES_Q6,       EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_Q5,        EState::ES_Q4,        EState::ES_NSINK,  EState::ES_ERROR}), // ES_Q4
-                                    std::array<EState,8>({EState::ES_Q6,       EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_Q5,        EState::ES_Q4,        EState::ES_NSINK,  EState::ES_ERROR}), // ES_Q5
-                                    std::array<EState,8>({EState::ES_ERROR,    EState::ES_Q3,        EState::ES_Q1,        EState::ES_Q2,        EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_PSINK,  EState::ES_ERROR}), // ES_Q6
-                                    std::array<EState,8>({EState::ES_ERROR,    EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,  EState::ES_ERROR}), // ES_PSINK
-                                    std::array<EState,8>({EState::ES_ERROR,    EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,  EState::ES_ERROR}), // ES_NSINK
-                                    std::array<EState,8>({EState::ES_ERROR,    EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,  EState::ES_ERROR})  // ES_ERROR
-                                };
+                                static constexpr std::array<std::array<EState,8>,10> fsm = {{
+                                    //   n > 0                n < 0                 n > 0 & n == n'       n > 0 & n != n'       n < 0 & n == n'       n < 0 & n != n'       EOS                ERROR
+                                    {{EState::ES_ERROR,    EState::ES_Q3,        EState::ES_Q1,        EState::ES_Q2,        EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_PSINK,  EState::ES_ERROR}}, // ES_Q0
+                                    {{EState::ES_ERROR,    EState::ES_Q3,        EState::ES_Q1,        EState::ES_Q2,        EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_PSINK,  EState::ES_ERROR}}, // ES_Q1
+                                    {{EState::ES_ERROR,    EState::ES_Q3,        EState::ES_Q1,        EState::ES_Q2,        EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_PSINK,  EState::ES_ERROR}}, // ES_Q2
+                                    {{EState::ES_Q6,       EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_Q5,        EState::ES_Q4,        EState::ES_NSINK,  EState::ES_ERROR}}, // ES_Q3
+                                    {{EState::ES_Q6,       EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_Q5,        EState::ES_Q4,        EState::ES_NSINK,  EState::ES_ERROR}}, // ES_Q4
+                                    {{EState::ES_Q6,       EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_Q5,        EState::ES_Q4,        EState::ES_NSINK,  EState::ES_ERROR}}, // ES_Q5
+                                    {{EState::ES_ERROR,    EState::ES_Q3,        EState::ES_Q1,        EState::ES_Q2,        EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_PSINK,  EState::ES_ERROR}}, // ES_Q6
+                                    {{EState::ES_ERROR,    EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,  EState::ES_ERROR}}, // ES_PSINK
+                                    {{EState::ES_ERROR,    EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,  EState::ES_ERROR}}, // ES_NSINK
+                                    {{EState::ES_ERROR,    EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,     EState::ES_ERROR,  EState::ES_ERROR}}  // ES_ERROR
+                                }};
 
                                 /**
                                  * @brief This function writes the output to a Golomb-Rice encoder.
                                  * 
+                                 * @tparam Codec is a Rice writer; calling its `final` members avoids virtual dispatch.
                                  * @param codec 
                                  * @param n 
                                  * @param r 
                                  * @param is_negative 
                                  */
-                                static void _write_integer_( std::shared_ptr<samg::grcodec::base::writer::CodecWriter<Word>>codec, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, const std::size_t r, const bool is_negative = false ) {
-                                   LOG("OfflineRiceRunsWriter/FSMEncoder/_write_integer_> n = %ld; r = %zu; is_negative = %u", n, r, is_negative);
-                                    n = ( is_negative ) ? n * -1 : n;
+                                template<typename Codec> static inline void _write_integer_( Codec& codec, const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, const std::size_t r, const bool is_negative = false ) {
+                                    LOG("OfflineRiceRunsWriter/FSMEncoder/_write_integer_> n = %ld; r = %zu; is_negative = %u", n, r, is_negative);
+                                    const Word m = samg::grcodec::toolkits::RunLengthCommon<Word>::encode_rval( n );
                                     if( r < samg::grcodec::toolkits::RunLengthCommon<Word>::RLE_THRESHOLD ) {
-                                        // std::cout << "\t\t\tOfflineRiceRunsWriter/FSMEncoder/_write_integer_> (1)" << std::endl;
                                         for (std::size_t j = 0; j < r; ++j) {
-                                            if( is_negative ) { codec->add(samg::grcodec::toolkits::RunLengthCommon<Word>::NEGATIVE_FLAG); }
-                                            codec->add(n);
-                                            // std::cout << "\t\t\tOfflineRiceRunsWriter/FSMEncoder/_write_integer_> (1.1)" << std::endl;
+                                            if( is_negative ) { codec.add(samg::grcodec::toolkits::RunLengthCommon<Word>::NEGATIVE_FLAG); }
+                                            codec.add(m);
                                         }
-                                        // std::cout << "\t\t\tOfflineRiceRunsWriter/FSMEncoder/_write_integer_> (1.2)" << std::endl;
-                                        // std::cout << " Write ---> r<" << r << "> x (" << (is_negative ? " NEG<00>":"") << " n<" << n << "> )" << std::endl;
                                     } else {
-                                        // std::cout << "\t\t\tOfflineRiceRunsWriter/FSMEncoder/_write_integer_> (2)" << std::endl;
-                                        codec->add(samg::grcodec::toolkits::RunLengthCommon<Word>::REPETITION_FLAG);
-                                        // std::cout << "\t\t\tOfflineRiceRunsWriter/FSMEncoder/_write_integer_> (2.1)" << std::endl;
-                                        if( is_negative ) { codec->add(samg::grcodec::toolkits::RunLengthCommon<Word>::NEGATIVE_FLAG); }
-                                        // std::cout << "\t\t\tOfflineRiceRunsWriter/FSMEncoder/_write_integer_> (2.2)" << std::endl;
-                                        codec->add(n);
-                                        // std::cout << "\t\t\tOfflineRiceRunsWriter/FSMEncoder/_write_integer_> (2.3)" << std::endl;
-                                        codec->add(r);
-                                        // std::cout << "\t\t\tOfflineRiceRunsWriter/FSMEncoder/_write_integer_> (2.4)" << std::endl;
-
-                                        // std::cout << " Write ---> REP<01>" << (is_negative ? " NEG<00>":"") << " n<" << n << "> r<" << r << ">" << std::endl;
+                                        codec.add(samg::grcodec::toolkits::RunLengthCommon<Word>::REPETITION_FLAG);
+                                        if( is_negative ) { codec.add(samg::grcodec::toolkits::RunLengthCommon<Word>::NEGATIVE_FLAG); }
+                                        codec.add(m);
+                                        codec.add((Word) r);
                                     }
                                 }
 
@@ -2041,50 +4156,30 @@ namespace samg {
                                  * @brief This function identifies the case generated by a next FSM input. 
                                  * 
                                  * @param rs 
-                                 * @param i 
                                  * @param previous_n 
                                  * @param n 
                                  * @return const ECase 
                                  */
-                                // static const ECase _get_case_( const RelativeSequence rs, std::size_t &i, const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t previous_n, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &n ) {
-                                static const ECase _get_case_( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> rs, const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t previous_n, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &n ) {
-                                    // if( i == rs.size() ) {
-                                    if( rs->empty() ) {
+                                static inline const ECase _get_case_( Queue<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>& rs, const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t previous_n, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &n ) {
+                                    if( rs.empty() ) {
                                         return ECase::EC_EOS;
-                                    }else {
-                                        // n = rs[i++];
-                                        n = rs->front(); rs->pop();
-                                    //  std::cout << "\t\t\tFSMEncoder/_get_case_> previous_n = " << previous_n << "; n = " << n << std::endl;
-                                        if( n > 0 && previous_n < 0 ) {
-                                            return ECase::EC_PINT;
-                                        } else if( n < 0 && previous_n > 0 ) {
-                                            return ECase::EC_NINT;
-                                        } else if( n > 0 && n == previous_n ) {
-                                            return ECase::EC_PIEQPRV;
-                                        } else if( n > 0 && n != previous_n ) {
-                                            return ECase::EC_PINQPRV;
-                                        } else if( n < 0 && n == previous_n ) {
-                                            return ECase::EC_NIEQPRV;
-                                        } else if( n < 0 && n != previous_n ) {
-                                            return ECase::EC_NINQPRV;
-                                        } else {
-                                            return ECase::EC_ERROR;
-                                        }
                                     }
+                                    n = rs.front(); rs.pop();
+                                    // Relative values are not transformed, so 0 counts as positive:
+                                    if( n >= 0 && previous_n < 0 ) {
+                                        return ECase::EC_PINT;
+                                    } else if( n < 0 && previous_n >= 0 ) {
+                                        return ECase::EC_NINT;
+                                    } else if( n >= 0 ) {
+                                        return ( n == previous_n ) ? ECase::EC_PIEQPRV : ECase::EC_PINQPRV;
+                                    }
+                                    return ( n == previous_n ) ? ECase::EC_NIEQPRV : ECase::EC_NINQPRV;
                                 }
 
-                                /**
-                                 * @brief This function initializes the FSM.
-                                 * 
-                                 * @param rs 
-                                 * @param i 
-                                 * @param n 
-                                 */
-                                void _init_( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> rs, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &n ) {
-                                    // i = 0;
-                                    // n = rs[i++];
-                                    n = rs->front(); rs->pop();
-                                    this->current_state = EState::ES_Q0;
+                                inline void _init_( Queue<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>& rs, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &n ) {
+                                    n = rs.front(); rs.pop();
+                                    // A negative first value (e.g., a 64-bit value of 2^63 or more) starts at ES_Q3, whose action writes nothing yet as r = 0:
+                                    this->current_state = ( n < 0 ) ? EState::ES_Q3 : EState::ES_Q0;
                                 }
 
                             public:
@@ -2093,42 +4188,60 @@ namespace samg {
                                  * @brief This function allows moving the FSM to the next state.
                                  * 
                                  * @param rs 
-                                 * @param i 
                                  * @param previous_n 
                                  * @param n 
                                  * @return EState 
                                  */
-                                // EState next( const RelativeSequence rs, std::size_t &i, const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t previous_n, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &n ) {
-                                EState next( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> rs, const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t previous_n, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &n ) {
-                                    // std::cout << "FSMEncoder/next> (1)" << std::endl;
+                                inline EState next( Queue<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>& rs, const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t previous_n, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &n ) {
                                     if( this->is_initilized ) {
-                                    //  std::cout << "\t\t\tFSMEncoder/next> (1) previous_n = " << previous_n << "; n = " << n << std::endl;
-                                        // this->current_state = fsm[this->current_state][ FSMEncoder::_get_case_( rs, i, previous_n, n ) ];
-                                        this->current_state = fsm[this->current_state][ FSMEncoder::_get_case_( rs, previous_n, n ) ];
-                                        // std::cout << "FSMEncoder/next> (1.1.2)" << std::endl;
+                                        this->current_state = FSMEncoder::fsm[this->current_state][ FSMEncoder::_get_case_( rs, previous_n, n ) ];
                                     } else {
-                                    //  std::cout << "\t\t\tFSMEncoder/next> (2 - init) previous_n = " << previous_n << "; n = " << n << std::endl;
-                                        // this->_init_( rs, i, n );
                                         this->_init_( rs, n );
-                                        // std::cout << "FSMEncoder/next> (1.2.2)" << std::endl;
                                         this->is_initilized = true;
-                                        // std::cout << "FSMEncoder/next> (1.2.3)" << std::endl;
                                     }
-                                    // LOG("OfflineRiceRunsWriter/FSMEncoder/next> current_state = %d; previous_n = %ld; n = %ld", this->current_state, previous_n, n);
                                     return this->current_state;
                                 }
 
                                 /**
-                                 * @brief This function allows running the current state's associated function. 
+                                 * @brief This function allows running the current state's associated action. 
                                  * 
+                                 * @tparam Codec 
                                  * @param codec 
                                  * @param previous_n 
                                  * @param n 
                                  * @param r 
                                  */
-                                void run( std::shared_ptr<samg::grcodec::base::writer::CodecWriter<Word>> codec, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &previous_n, const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, std::size_t &r ) {
-                                    // std::cout << "\t\t\tOfflineRiceRunsWriter/FSMEncoder/run> current_state = " << this->current_state << "; previous_n = " << previous_n << "; n = " << n << "; r = " << r << std::endl;
-                                    this->sfunction[this->current_state]( codec, previous_n, n, r );
+                                template<typename Codec> inline void run( Codec& codec, typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t &previous_n, const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t n, std::size_t &r ) {
+                                    switch( this->current_state ) {
+                                        case EState::ES_Q0:
+                                            previous_n = n;
+                                            r = 1;
+                                            break;
+                                        case EState::ES_Q1:
+                                        case EState::ES_Q5:
+                                            ++r;
+                                            break;
+                                        case EState::ES_Q2:
+                                        case EState::ES_Q3:
+                                            FSMEncoder::_write_integer_( codec, previous_n, r );
+                                            previous_n = n;
+                                            r = 1;
+                                            break;
+                                        case EState::ES_Q4:
+                                        case EState::ES_Q6:
+                                            FSMEncoder::_write_integer_( codec, previous_n, r, samg::grcodec::toolkits::RunLengthCommon<Word>::IS_NEGATIVE );
+                                            previous_n = n;
+                                            r = 1;
+                                            break;
+                                        case EState::ES_PSINK:
+                                            FSMEncoder::_write_integer_( codec, previous_n, r );
+                                            break;
+                                        case EState::ES_NSINK:
+                                            FSMEncoder::_write_integer_( codec, previous_n, r, samg::grcodec::toolkits::RunLengthCommon<Word>::IS_NEGATIVE );
+                                            break;
+                                        default: // ES_ERROR
+                                            throw std::runtime_error("Encoding error state!");
+                                    }
                                 }
                                 
                                 /**
@@ -2163,13 +4276,13 @@ namespace samg {
                         };
 
                         // Attributes for relative-sequence traversal:
-                        std::shared_ptr<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>> codec;
+                        std::shared_ptr<Encoder> codec;
                         FSMEncoder                      encoding_fsm;
                         Word                            encoding_previous_n;
                         std::size_t                     encoding_r; // Repetition of current encoding value.
                         typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t encoding_previous_relative_n;
                         bool                            encoding_is_first, is_flushed;
-                        typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> encoding_buffer;
+                        Queue<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t> encoding_buffer;
 
                         void _flush_encoding_buffer_( ) {
                             LOG("OfflineRiceRunsWriter/_flush_encoding_buffer_> [BEGIN] --- is_flushed = %u",this->is_flushed);
@@ -2183,22 +4296,21 @@ namespace samg {
                         }
                     
                     protected:
-                        std::shared_ptr<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>> get_codec() const {
+                        std::shared_ptr<Encoder> get_codec() const {
                             return this->codec;
                         }
 
                         void restart( ) {
                             // LOG("OfflineRiceRunsWriter/restart> (1)");
-                            if( this->encoding_buffer ) {
-                                this->_flush_encoding_buffer_();
-                                // std::cout << "OfflineRiceRunsWriter/restart> (2)" << std::endl;
-                                this->encoding_buffer.reset();
-                            }
+                            this->_flush_encoding_buffer_();
+                            // std::cout << "OfflineRiceRunsWriter/restart> (2)" << std::endl;
                             // LOG("OfflineRiceRunsWriter/restart> (2)");
                             this->encoding_fsm.restart();
                             // LOG("OfflineRiceRunsWriter/restart> (3)");
                             // std::cout << "OfflineRiceRunsWriter/restart> (3)" << std::endl;
-                            this->encoding_buffer = adapter::get_instance<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>( adapter::QueueAdapterType::Q_QUEUEADAPTER );
+                            while( !this->encoding_buffer.empty() ) {
+                                this->encoding_buffer.pop();
+                            }
                             // std::cout << "OfflineRiceRunsWriter/restart> (4)" << std::endl;
                             this->encoding_is_first = true; // NOTE It helps to restart the encoding_fsm!
                             this->encoding_previous_n = 0;
@@ -2214,82 +4326,315 @@ namespace samg {
                             // std::cout << "\tRiceRuns/encode> (1)" << std::endl;
                             this->encoding_fsm.next( this->encoding_buffer, this->encoding_previous_relative_n, relative_v );
                             // std::cout << "\tRiceRuns/encode> (2)" << std::endl;
-                            LOG( "OfflineRiceRunsWriter/encode> [BEGIN] --- encoding_previous_relative_n = %ld; relative_v = %ld; encoding_r = %zu; |encoding_buffer| = %zu",this->encoding_previous_relative_n, relative_v,this->encoding_r,this->encoding_buffer->size());
-                            if( this->encoding_fsm.is_error_state() ) { std::runtime_error("Encoding error state!"); }
+                            LOG( "OfflineRiceRunsWriter/encode> [BEGIN] --- encoding_previous_relative_n = %ld; relative_v = %ld; encoding_r = %zu; |encoding_buffer| = %zu",this->encoding_previous_relative_n, relative_v,this->encoding_r,this->encoding_buffer.size());
+                            if( this->encoding_fsm.is_error_state() ) { throw std::runtime_error("OfflineRiceRunsWriter/encode> Encoding error state!"); }
                             // std::cout << "\tRiceRuns/encode> (3)" << std::endl;
-                            this->encoding_fsm.run( this->codec, this->encoding_previous_relative_n, relative_v, this->encoding_r );
-                            LOG( "OfflineRiceRunsWriter/encode> [END] --- encoding_previous_relative_n = %ld; relative_v = %ld; encoding_r = %zu; |encoding_buffer| = %zu",this->encoding_previous_relative_n, relative_v,this->encoding_r,this->encoding_buffer->size());
+                            this->encoding_fsm.run( *(this->codec), this->encoding_previous_relative_n, relative_v, this->encoding_r );
+                            LOG( "OfflineRiceRunsWriter/encode> [END] --- encoding_previous_relative_n = %ld; relative_v = %ld; encoding_r = %zu; |encoding_buffer| = %zu",this->encoding_previous_relative_n, relative_v,this->encoding_r,this->encoding_buffer.size());
                             return this->encoding_fsm.is_end_state();
                         }
 
-                    public:
-                        // OfflineRiceRunsWriter( const std::string file_name, const std::size_t k ) { 
-                        OfflineRiceRunsWriter( std::shared_ptr<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>> codec ) :
-                            samg::grcodec::base::writer::CodecFileWriter<Word>::CodecFileWriter( codec->get_file_name() ),
-                            is_flushed ( true ) // `true` is for the sake of the first call to `restart` function. (for not unnecessarily flush the `encoding_buffer`)
-                        { 
-                            // std::cout << "OfflineRiceRunsWriter/init> (1)" << std::endl;
-                            // this->codec = std::make_shared<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>>( file_name, k );
-                            this->codec = codec;
-
-                            // std::cout << "OfflineRiceRunsWriter/init> (2)" << std::endl;
-                            // this->encoding_buffer = adapter::get_instance<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>( adapter::QueueAdapterType::Q_QUEUEADAPTER );
-                            this->restart();
+                    public:
+                        // OfflineRiceRunsWriter( const std::string file_name, const std::size_t k ) { 
+                        OfflineRiceRunsWriter( std::shared_ptr<Encoder> codec ) :
+                            samg::grcodec::base::writer::CodecFileWriter<Word>::CodecFileWriter( codec->get_file_name() ),
+                            is_flushed ( true ) // `true` is for the sake of the first call to `restart` function. (for not unnecessarily flush the `encoding_buffer`)
+                        { 
+                            // std::cout << "OfflineRiceRunsWriter/init> (1)" << std::endl;
+                            // this->codec = std::make_shared<samg::grcodec::rice::writer::OfflineRCodecWriter<Word>>( file_name, k );
+                            this->codec = codec;
+
+                            // std::cout << "OfflineRiceRunsWriter/init> (2)" << std::endl;
+                            // this->encoding_buffer = adapter::get_instance<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>( adapter::QueueAdapterType::Q_QUEUEADAPTER );
+                            this->restart();
+
+                            // std::cout << "OfflineRiceRunsWriter/init> (3)" << std::endl;
+                        }
+
+                        
+                        const bool add( Word v ) override {
+                            LOG("---------------------------------------------------------------\nOfflineRiceRunsWriter/add(v = %u)",v);
+                            // Relativize:
+                            // The first value is relative to 0; `encode_rval` transforms the relative values when they are written.
+                            const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t relative_v = samg::grcodec::toolkits::RunLengthCommon<Word>::get_relative_value( this->encoding_is_first ? 0 : this->encoding_previous_n, v );
+                            this->encoding_is_first = false;
+                            // std::cout << "\tOfflineRiceRunsWriter/add> pushing relative_v..." << std::endl;
+                            // PRINT_OFFLINERICERUNSWRITER_ADD("pushing relative_v...");
+                            this->encoding_buffer.push( relative_v );
+                            // std::cout << "\tOfflineRiceRunsWriter/add> v = " << v << "; relative_v (" << typeid(relative_v).name() << ") = " << relative_v << "; |encoding_buffer| = " << this->encoding_buffer.size() << "; encoding_previous_n = " << this->encoding_previous_n << std::endl;
+                            // LOG("OfflineRiceRunsWriter/add> v = %u; relative_v = %ld; |encoding_buffer| = %zu; encoding_previous_n = %u", v, relative_v, this->encoding_buffer.size(),this->encoding_previous_n);
+                            this->encoding_previous_n = v;
+                            this->is_flushed = false;
+                            return this->encode();
+                        }
+
+                        void close( ) override {
+                            // this->encoding_buffer.pop();
+                            this->_flush_encoding_buffer_();
+                            this->codec->close();
+                            this->codec.reset();
+                        }
+
+                        const std::vector<std::size_t> get_metadata() const {
+                            return this->codec->get_metadata();
+                        }
+
+                        void add_metadata( std::size_t v ) {
+                            this->codec->add_metadata( v );
+                        }
+
+                        void push_metadata( std::size_t v ) {
+                            this->codec->push_metadata( v );
+                        }
+
+                };
+
+                /**
+                 * @brief This class represents a blocked Rice-runs encoder. The input is split into blocks of `block_values` values that restart the relative sequence, so batches of blocks are encoded on `nthreads` threads and `OfflineBlockedRiceRunsReader` can decode them in parallel. Each block is Rice-coded with the order that minimizes its size.
+                 * @note The calling thread and `nthreads - 1` workers, started with the first batch of several blocks and kept until `close()`, share the blocks of each batch.
+                 * @note File layout: the block payloads, each padded to 8 bytes, followed by the metadata tail `block_values, value_count, blocks, (byte_offset, bit_length, token_count, k)*, <user metadata>`.
+                 * 
+                 * @tparam Word 
+                 */
+                template<typename Word> class OfflineBlockedRiceRunsWriter : public samg::grcodec::base::writer::CodecFileWriter<Word>, public samg::grcodec::base::MetadataSaver {
+                    public:
+                        static constexpr std::size_t DIRECTORY_ENTRY_LENGTH = 4ZU; // byte_offset, bit_length, token_count, k.
+                    private:
+                        /**
+                         * @brief Collects the tokens of a block before choosing its Rice order.
+                         * 
+                         */
+                        struct TokenBuffer {
+                            std::vector<Word> tokens;
+                            inline const bool add( const Word n ) {
+                                this->tokens.push_back( n );
+                                return true;
+                            }
+                        };
+
+                        struct EncodedBlock {
+                            std::vector<std::uint8_t> bytes;
+                            std::size_t bit_length,
+                                        token_count,
+                                        k;
+                        };
+
+                        const std::size_t block_values, // Values per block.
+                                          nthreads; // Blocks encoded at once.
+                        std::size_t value_counter, // Number of encoded values.
+                                    byte_counter; // Number of written payload bytes.
+                        std::vector<Word> pending; // Values of the current batch (up to `nthreads` blocks).
+                        std::vector<EncodedBlock> encoded; // One slot per block of a batch.
+                        std::vector<std::size_t> directory;
+                        std::unique_ptr<samg::serialization::OfflineWordWriter<Word>> serializer;
+
+                        // Worker pool:
+                        std::vector<std::thread> workers;
+                        std::mutex pool_mutex;
+                        std::condition_variable batch_ready,
+                                                batch_done;
+                        std::size_t batch_id, // Number of batches handed to the workers.
+                                    batch_blocks, // Number of blocks of the current batch.
+                                    busy_workers; // Workers still encoding the current batch.
+                        std::atomic<std::size_t> next_block; // Next unclaimed block of the current batch.
+                        bool is_stopping;
+
+                        /**
+                         * @brief Writes metadata at the end of the output file.
+                         * 
+                         */
+                        void _save_metadata_() {
+                            for (std::size_t v : this->get_metadata()) {
+                                this->serializer->template add_value<std::size_t>( v );
+                            }
+                            this->serializer->template add_value<std::size_t>( this->metadata.size() );
+                        }
+
+                        static void _encode_block_( const Word* values, const std::size_t n, EncodedBlock& block ) {
+                            TokenBuffer buffer;
+                            buffer.tokens.reserve( n );
+                            samg::grcodec::toolkits::RunLengthCommon<Word>::encode_tokens( buffer, values, n );
+                            const auto [k, cost] = samg::grcodec::toolkits::GolombRiceCommon<Word>::optimal_rice_parameter( buffer.tokens.data(), buffer.tokens.size() );
+                            block.bytes.clear();
+                            block.bytes.reserve( ( ( cost + 63ZU ) / 64ZU ) * sizeof(std::uint64_t) );
+                            samg::grcodec::toolkits::ByteVectorWriter sink( block.bytes );
+                            samg::grcodec::toolkits::BitWriter<samg::grcodec::toolkits::ByteVectorWriter> bits;
+                            bits.reset( &sink );
+                            for( const Word t : buffer.tokens ) {
+                                bits.put_rice( t, k );
+                            }
+                            bits.flush( sizeof(std::uint64_t) );
+                            block.bit_length = cost;
+                            block.token_count = buffer.tokens.size();
+                            block.k = k;
+                        }
+
+                        /**
+                         * @brief Encodes unclaimed blocks of the current batch until none is left.
+                         * 
+                         */
+                        void _encode_blocks_() {
+                            const std::size_t m = this->pending.size();
+                            for( std::size_t b = this->next_block++; b < this->batch_blocks; b = this->next_block++ ) {
+                                const std::size_t first = b * this->block_values;
+                                OfflineBlockedRiceRunsWriter::_encode_block_( this->pending.data() + first, std::min( this->block_values, m - first ), this->encoded[b] );
+                            }
+                        }
+
+                        /**
+                         * @brief Loop of a pool worker: waits for a new batch, helps encoding it, and reports back.
+                         * 
+                         */
+                        void _work_() {
+                            std::size_t seen = 0ZU;
+                            for(;;) {
+                                {
+                                    std::unique_lock<std::mutex> lock( this->pool_mutex );
+                                    this->batch_ready.wait( lock, [&]() { return this->is_stopping || this->batch_id != seen; } );
+                                    if( this->is_stopping ) {
+                                        return;
+                                    }
+                                    seen = this->batch_id;
+                                }
+                                this->_encode_blocks_();
+                                std::lock_guard<std::mutex> lock( this->pool_mutex );
+                                if( --(this->busy_workers) == 0ZU ) {
+                                    this->batch_done.notify_one();
+                                }
+                            }
+                        }
 
-                            // std::cout << "OfflineRiceRunsWriter/init> (3)" << std::endl;
+                        void _stop_workers_() {
+                            {
+                                std::lock_guard<std::mutex> lock( this->pool_mutex );
+                                this->is_stopping = true;
+                            }
+                            this->batch_ready.notify_all();
+                            for( auto& w : this->workers ) {
+                                w.join();
+                            }
+                            this->workers.clear();
+                            this->is_stopping = false; // A later batch starts a new pool.
                         }
 
-                        
-                        const bool add( Word v ) override {
-                            LOG("---------------------------------------------------------------\nOfflineRiceRunsWriter/add(v = %u)",v);
-                            // Relativize:
-                            typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t relative_v;
-                            if( this->encoding_is_first ) {
-                                relative_v = samg::grcodec::toolkits::RunLengthCommon<Word>::transform_rval( v );
-                                this->encoding_is_first = false;
+                        /**
+                         * @brief Encodes the pending blocks in parallel and appends them to the file in order.
+                         * 
+                         */
+                        void _flush_batch_() {
+                            const std::size_t blocks = ( this->pending.size() + this->block_values - 1ZU ) / this->block_values;
+                            if( this->nthreads <= 1ZU || blocks <= 1ZU ) {
+                                this->batch_blocks = blocks;
+                                this->next_block = 0ZU;
+                                this->_encode_blocks_();
                             } else {
-                                // this->encoding_buffer.push( this->encoding_previous_relative_n );
-                                relative_v = samg::grcodec::toolkits::RunLengthCommon<Word>::get_transformed_relative_sequence( this->encoding_previous_n, v );
+                                if( this->workers.empty() ) {
+                                    this->workers.reserve( this->nthreads - 1ZU );
+                                    for( std::size_t t = 1; t < this->nthreads; ++t ) {
+                                        this->workers.emplace_back( &OfflineBlockedRiceRunsWriter::_work_, this );
+                                    }
+                                }
+                                {
+                                    std::lock_guard<std::mutex> lock( this->pool_mutex );
+                                    this->batch_blocks = blocks;
+                                    this->next_block = 0ZU;
+                                    this->busy_workers = this->workers.size();
+                                    ++(this->batch_id);
+                                }
+                                this->batch_ready.notify_all();
+                                this->_encode_blocks_(); // The calling thread takes part, too.
+                                std::unique_lock<std::mutex> lock( this->pool_mutex );
+                                this->batch_done.wait( lock, [&]() { return this->busy_workers == 0ZU; } );
                             }
-                            // std::cout << "\tOfflineRiceRunsWriter/add> pushing relative_v..." << std::endl;
-                            // PRINT_OFFLINERICERUNSWRITER_ADD("pushing relative_v...");
-                            this->encoding_buffer->push( relative_v );
-                            // std::cout << "\tOfflineRiceRunsWriter/add> v = " << v << "; relative_v (" << typeid(relative_v).name() << ") = " << relative_v << "; |encoding_buffer| = " << this->encoding_buffer->size() << "; encoding_previous_n = " << this->encoding_previous_n << std::endl;
-                            // LOG("OfflineRiceRunsWriter/add> v = %u; relative_v = %ld; |encoding_buffer| = %zu; encoding_previous_n = %u", v, relative_v, this->encoding_buffer->size(),this->encoding_previous_n);
-                            this->encoding_previous_n = v;
-                            this->is_flushed = false;
-                            return this->encode();
+                            for( std::size_t b = 0; b < blocks; ++b ) {
+                                const EncodedBlock& block = this->encoded[b];
+                                this->serializer->add_bytes( block.bytes.data(), block.bytes.size() );
+                                this->directory.push_back( this->byte_counter );
+                                this->directory.push_back( block.bit_length );
+                                this->directory.push_back( block.token_count );
+                                this->directory.push_back( block.k );
+                                this->byte_counter += block.bytes.size();
+                                LOG("OfflineBlockedRiceRunsWriter/_flush_batch_> block = %zu; k = %zu; bit_length = %zu; token_count = %zu", this->directory.size() / OfflineBlockedRiceRunsWriter::DIRECTORY_ENTRY_LENGTH - 1ZU, block.k, block.bit_length, block.token_count);
+                            }
+                            this->pending.clear();
                         }
 
-                        void close( ) override {
-                            // this->encoding_buffer.pop();
-                            this->_flush_encoding_buffer_();
-                            this->codec->close();
-                            this->codec.reset();
-                            this->encoding_buffer.reset();
+                    public:
+                        /**
+                         * @brief Construct a new Offline Blocked Rice Runs Writer object
+                         * 
+                         * @param file_name 
+                         * @param block_values is the number of values per independently decodable block.
+                         * @param nthreads is the number of encoding threads; it is also the number of blocks buffered before encoding.
+                         */
+                        OfflineBlockedRiceRunsWriter( const std::string file_name, const std::size_t block_values = 1ZU << 20, const std::size_t nthreads = std::thread::hardware_concurrency() ) :
+                            samg::grcodec::base::writer::CodecFileWriter<Word>::CodecFileWriter( file_name ),
+                            block_values ( block_values ),
+                            nthreads ( std::max<std::size_t>( 1ZU, nthreads ) ),
+                            value_counter ( 0ZU ),
+                            byte_counter ( 0ZU ),
+                            batch_id ( 0ZU ),
+                            batch_blocks ( 0ZU ),
+                            busy_workers ( 0ZU ),
+                            next_block ( 0ZU ),
+                            is_stopping ( false ) {
+                            if( block_values == 0ZU ) {
+                                throw std::invalid_argument("OfflineBlockedRiceRunsWriter> block_values must be positive.");
+                            }
+                            // `pending` grows as values arrive and keeps its capacity between batches; reserving `block_values * nthreads` up front costs hundreds of MB with the defaults.
+                            this->encoded.resize( this->nthreads );
+                            this->serializer = std::make_unique<samg::serialization::OfflineWordWriter<Word>>( file_name );
                         }
 
-                        const std::vector<std::size_t> get_metadata() const {
-                            return this->codec->get_metadata();
+                        ~OfflineBlockedRiceRunsWriter() {
+                            this->_stop_workers_();
                         }
 
-                        void add_metadata( std::size_t v ) {
-                            this->codec->add_metadata( v );
+                        const std::size_t get_block_values() const {
+                            return this->block_values;
                         }
 
-                        void push_metadata( std::size_t v ) {
-                            this->codec->push_metadata( v );
+                        const std::size_t get_value_counter() const {
+                            return this->value_counter;
+                        }
+
+                        const bool add( const Word n ) override {
+                            this->pending.push_back( n );
+                            ++(this->value_counter);
+                            if( this->pending.size() == this->block_values * this->nthreads ) {
+                                this->_flush_batch_();
+                            }
+                            return true; // To fulfill inheritance requirements.
+                        }
+
+                        const std::vector<std::size_t> get_metadata() const override {
+                            return this->metadata;
                         }
 
+                        void close( ) override {
+                            if( !this->pending.empty() ) {
+                                this->_flush_batch_();
+                            }
+                            this->_stop_workers_();
+                            // Appending metadata (block directory first):
+                            this->metadata.insert( this->metadata.begin(), this->directory.begin(), this->directory.end() );
+                            this->push_metadata( this->directory.size() / OfflineBlockedRiceRunsWriter::DIRECTORY_ENTRY_LENGTH );
+                            this->push_metadata( this->value_counter );
+                            this->push_metadata( this->block_values );
+                            this->_save_metadata_();
+                            this->serializer->close();
+                        }
                 };
             }
             namespace reader {
                 /**
-                 * @brief This class represents an unsigned integer Rice-runs decoder. This codec uses OfflineRCodecReader class. 
+                 * @brief This class represents an unsigned integer Rice-runs decoder. This codec uses OfflineRCodecReader class by default. 
                  * 
                  * @tparam Word 
+                 * @tparam Queue is the FIFO type of the internal buffers; the non-virtual `adapter::RingBuffer` by default.
+                 * @tparam Decoder reads the run tokens; it must match the `Encoder` of the writer.
                  */
-                template<typename Word> class OfflineRiceRunsReader : public samg::grcodec::base::reader::CodecFileReader<Word>, samg::grcodec::base::MetadataKeeper {
+                template<typename Word, template<typename> class Queue = samg::grcodec::adapter::RingBuffer, typename Decoder = samg::grcodec::rice::reader::OfflineRCodecReader<Word>> class OfflineRiceRunsReader : public samg::grcodec::base::reader::CodecFileReader<Word>, samg::grcodec::base::MetadataKeeper {
                     private:
                         /**
                          * @brief This class represents a FSM for decoding. 
@@ -2297,8 +4642,6 @@ namespace samg {
                          */
                         class FSMDecoder {
                             private:
-                                bool is_init = false;
-
                                 /**
                                  * @brief States of the FSM.
                                  * 
@@ -2316,7 +4659,7 @@ namespace samg {
                                     DS_Q9,      //9
                                     DS_SINK,    //10 Sink after a run was written.
                                     DS_ERROR    //11
-                                } current_state; // Current state.
+                                } current_state = DState::DS_Q0; // Current state.
 
                                 /**
                                  * @brief Cases generated by inputs in the FSM. 
@@ -2330,117 +4673,60 @@ namespace samg {
                                     DC_ERROR    //4
                                 };
 
-                                /**
-                                 * @brief Functions to be executed by each state.
-                                 * 
-                                 */
-                                const std::array<std::function<void( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>, Word&, const Word )>,12> sfunction = {
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q0
-                                        // Empty
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q1
-                                        _write_integer_( rs, n, 1 );
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q2
-                                        // Empty
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q3
-                                        _write_integer_( rs, n, 1, samg::grcodec::toolkits::RunLengthCommon<Word>::IS_NEGATIVE );
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_04
-                                        // Empty
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q5
-                                        previous_n = n;
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q6
-                                        _write_integer_( rs, previous_n, n );
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q7
-                                        // Empty
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q8
-                                        previous_n = n;
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q9
-                                        _write_integer_( rs, previous_n, n, samg::grcodec::toolkits::RunLengthCommon<Word>::IS_NEGATIVE );
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_SINK
-                                        // Empty
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_ERROR
-                                        throw std::runtime_error("Decoding error state!");
-                                    }
-                                };
-
                                 /**
                                  * @brief States matrix.
                                  * 
                                  */
-                                const std::array<std::array<DState,5>,12> fsm = {
-                                                    //   n!=NEG & n!=REP       n == NEG              n == REP               EOS                    ERROR
-                                    std::array<DState,5>({DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}), // DS_Q0
-                                    std::array<DState,5>({DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}), // DS_Q1
-                                    std::array<DState,5>({DState::DS_Q3,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}), // DS_Q2
-                                    std::array<DState,5>({DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}), // DS_Q3
-                                    std::array<DState,5>({DState::DS_Q5,       DState::DS_Q7,        DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}), // DS_Q4
-                                    std::array<DState,5>({DState::DS_Q6,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}), // DS_Q5
-                                    std::array<DState,5>({DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}), // DS_Q6
-                                    std::array<DState,5>({DState::DS_Q8,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}), // DS_Q7
-                                    std::array<DState,5>({DState::DS_Q9,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}), // DS_Q8
-                                    std::array<DState,5>({DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}), // DS_Q9
-                                    std::array<DState,5>({DState::DS_ERROR,    DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}), // DS_SINK
-                                    std::array<DState,5>({DState::DS_ERROR,    DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR})  // DS_ERROR
-                                };
+                                static constexpr std::array<std::array<DState,5>,12> fsm = {{
+                                    //   n!=NEG & n!=REP       n == NEG              n == REP               EOS                    ERROR
+                                    {{DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}}, // DS_Q0
+                                    {{DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}}, // DS_Q1
+                                    {{DState::DS_Q3,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}, // DS_Q2
+                                    {{DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}}, // DS_Q3
+                                    {{DState::DS_Q5,       DState::DS_Q7,        DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}, // DS_Q4
+                                    {{DState::DS_Q6,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}, // DS_Q5
+                                    {{DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}}, // DS_Q6
+                                    {{DState::DS_Q8,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}, // DS_Q7
+                                    {{DState::DS_Q9,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}, // DS_Q8
+                                    {{DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}}, // DS_Q9
+                                    {{DState::DS_ERROR,    DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}, // DS_SINK
+                                    {{DState::DS_ERROR,    DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}  // DS_ERROR
+                                }};
 
                                 /**
-                                 * @brief This function writes the output to a relative sequence vector.
+                                 * @brief This function writes the output to a relative sequence.
                                  * 
                                  * @param rs 
                                  * @param n 
                                  * @param r 
                                  * @param is_negative 
                                  */
-                                static void _write_integer_( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> rs, const Word n, const std::size_t r, const bool is_negative = false ) {
-                                    typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t x = is_negative ? ((typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t)n) * -1 : n;
+                                static inline void _write_integer_( Queue<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>& rs, const Word n, const std::size_t r, const bool is_negative = false ) {
+                                    const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t x = samg::grcodec::toolkits::RunLengthCommon<Word>::decode_rval( n, is_negative );
                                     for (std::size_t j = 0; j < r; ++j) {
-                                        // rs.push_back(x);
-                                        rs->push(x);
+                                        rs.push(x);
                                     }
                                 }
 
                                 /**
                                  * @brief This function identifies the case generated by a next FSM input. 
                                  * 
+                                 * @tparam Codec is a Rice reader; calling its `final` members avoids virtual dispatch.
                                  * @param codec 
                                  * @param n 
                                  * @return const DCase 
                                  */
-                                static const DCase _get_case_( std::shared_ptr<samg::grcodec::base::reader::CodecReader<Word>> codec, Word &n ) {
-                                    if( !codec->has_more() ) {
+                                template<typename Codec> static inline const DCase _get_case_( Codec& codec, Word &n ) {
+                                    if( !codec.has_more() ) {
                                         return DCase::DC_EOS;
-                                    }else {
-                                        n = codec->next();
-                                        if( n != samg::grcodec::toolkits::RunLengthCommon<Word>::NEGATIVE_FLAG && n != samg::grcodec::toolkits::RunLengthCommon<Word>::REPETITION_FLAG ) {
-                                            return DCase::DC_INT;
-                                        } else if( n == samg::grcodec::toolkits::RunLengthCommon<Word>::NEGATIVE_FLAG ) {
-                                            return DCase::DC_NEGFLAG;
-                                        } else if( n == samg::grcodec::toolkits::RunLengthCommon<Word>::REPETITION_FLAG ) {
-                                            return DCase::DC_REPFLAG;
-                                        } else {
-                                            return DCase::DC_ERROR;
-                                        }
                                     }
-                                }
-
-                                /**
-                                 * @brief This function initializes the FSM.
-                                 * 
-                                 * @param codec 
-                                 * @param n 
-                                 */
-                                void _init_( Word &n ) {
-                                    this->current_state = DState::DS_Q0;
+                                    n = codec.next();
+                                    if( n == samg::grcodec::toolkits::RunLengthCommon<Word>::NEGATIVE_FLAG ) {
+                                        return DCase::DC_NEGFLAG;
+                                    } else if( n == samg::grcodec::toolkits::RunLengthCommon<Word>::REPETITION_FLAG ) {
+                                        return DCase::DC_REPFLAG;
+                                    }
+                                    return DCase::DC_INT;
                                 }
 
                             public:
@@ -2448,32 +4734,45 @@ namespace samg {
                                 /**
                                  * @brief This function allows moving the FSM to the next state.
                                  * 
+                                 * @tparam Codec 
                                  * @param codec 
-                                 * @param previous_n 
                                  * @param n 
                                  * @return DState 
                                  */
-                                DState next( std::shared_ptr<samg::grcodec::base::reader::CodecReader<Word>> codec, Word &previous_n, Word &n ) {
-                                    if( !this->is_init ) {
-                                        this->_init_( n );
-                                        this->is_init = true;
-                                    }
-                                    // DCase c = FSMDecoder::_get_case_( codec, n );
-                                    // this->current_state = fsm[this->current_state][ c ];
-                                    // std::cout << "\t\t\tOfflineRiceRunsReader/FSMDecoder/next> current_state = "<< this->current_state << "; case = " << c << std::endl;
-                                    // return this->current_state;
-                                    return this->current_state = fsm[this->current_state][ FSMDecoder::_get_case_( codec, n ) ];
+                                template<typename Codec> inline DState next( Codec& codec, Word &n ) {
+                                    return this->current_state = FSMDecoder::fsm[this->current_state][ FSMDecoder::_get_case_( codec, n ) ];
                                 }
 
                                 /**
-                                 * @brief This function allows running the current state's associated function. 
+                                 * @brief This function allows running the current state's associated action. 
                                  * 
                                  * @param rs 
                                  * @param previous_n 
                                  * @param n 
                                  */
-                                void run( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> rs, Word &previous_n, const Word n ) {
-                                    this->sfunction[this->current_state]( rs, previous_n, n );
+                                inline void run( Queue<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>& rs, Word &previous_n, const Word n ) {
+                                    switch( this->current_state ) {
+                                        case DState::DS_Q1:
+                                            FSMDecoder::_write_integer_( rs, n, 1 );
+                                            break;
+                                        case DState::DS_Q3:
+                                            FSMDecoder::_write_integer_( rs, n, 1, samg::grcodec::toolkits::RunLengthCommon<Word>::IS_NEGATIVE );
+                                            break;
+                                        case DState::DS_Q5:
+                                        case DState::DS_Q8:
+                                            previous_n = n;
+                                            break;
+                                        case DState::DS_Q6:
+                                            FSMDecoder::_write_integer_( rs, previous_n, n );
+                                            break;
+                                        case DState::DS_Q9:
+                                            FSMDecoder::_write_integer_( rs, previous_n, n, samg::grcodec::toolkits::RunLengthCommon<Word>::IS_NEGATIVE );
+                                            break;
+                                        case DState::DS_ERROR:
+                                            throw std::runtime_error("Decoding error state!");
+                                        default: // DS_Q0, DS_Q2, DS_Q4, DS_Q7, and DS_SINK have no action.
+                                            break;
+                                    }
                                 }
                                 
                                 /**
@@ -2508,23 +4807,23 @@ namespace samg {
                                  * 
                                  */
                                 void restart() {
-                                    this->is_init = false;
+                                    this->current_state = DState::DS_Q0;
                                 }
                         };
 
                         // Attributes for relative-sequence traversal:
-                        std::shared_ptr<samg::grcodec::rice::reader::OfflineRCodecReader<Word>> codec;
+                        std::shared_ptr<Decoder> codec;
                         FSMDecoder                      decoding_fsm;
                         Word                            decoding_previous_n, 
                                                         decoding_n;
-                        typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t decoding_previous_relative_value;
-                        typename samg::grcodec::toolkits::RunLengthCommon<Word>::AbsoluteSequence<> decoding_next_buffer;
+                        Word                            decoding_last; // Last decoded absolute value (0 before the first one).
+                        Queue<Word> decoding_next_buffer;
+                        Queue<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t> decoding_relative_buffer; // Relative values of the token being decoded by `next()`.
                         // typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> encoding_buffer;
                         // bool    is_open,
-                        bool decoding_is_first;
 
                     public:
-                        OfflineRiceRunsReader( std::shared_ptr<samg::grcodec::rice::reader::OfflineRCodecReader<Word>> codec ):
+                        OfflineRiceRunsReader( std::shared_ptr<Decoder> codec ):
                             samg::grcodec::base::reader::CodecFileReader<Word>::CodecFileReader( codec->get_file_name() ),
                             codec ( codec )  { 
                             // this->encoding_is_first = true;
@@ -2539,58 +4838,46 @@ namespace samg {
                             //     throw std::runtime_error("Stream from file \""+this->get_file_name()+"\" is not openned!");
                             // }
                             // std::cout << "OfflineRiceRunsReader/next> decoding_previous_n = " << this->decoding_previous_n << "; decoding_n = " << this->decoding_n << std::endl;
-                            if( this->decoding_next_buffer->empty() ) {
-                                std::uint8_t s;
-                                typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> relative_sequence  = adapter::get_instance<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>( adapter::QueueAdapterType::Q_QUEUEADAPTER );
+                            if( this->decoding_next_buffer.empty() ) {
                                 do { 
-                                    s = this->decoding_fsm.next( this->codec, this->decoding_previous_n, this->decoding_n);
+                                    this->decoding_fsm.next( *(this->codec), this->decoding_n );
                                     if( this->decoding_fsm.is_error_state() ) { break; }
-                                    // std::cout << "\t\tOfflineRiceRunsReader/next> pre-run --- decoding_previous_n = " << this->decoding_previous_n << "; decoding_n = " << this->decoding_n << "; |relative_sequence| = " << relative_sequence->size() << std::endl;
-                                    this->decoding_fsm.run( relative_sequence, this->decoding_previous_n, this->decoding_n );
-                                    // std::cout << "\t\tOfflineRiceRunsReader/next> post-run --- decoding_previous_n = " << this->decoding_previous_n << "; decoding_n = " << this->decoding_n << "; |relative_sequence| = " << relative_sequence->size() << std::endl;
+                                    this->decoding_fsm.run( this->decoding_relative_buffer, this->decoding_previous_n, this->decoding_n );
                                 }while( !this->decoding_fsm.is_output_state() );
-
-                                // If it is not the first time executing `next`, then insert the previous relativized absolute value to the beginning of the just retrieved relative sequence:
-                                if( !this->decoding_is_first ) {
-                                    typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> tmp = adapter::get_instance<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>( adapter::QueueAdapterType::Q_QUEUEADAPTER );
-                                    tmp->push( this->decoding_previous_relative_value );
-                                    while( !relative_sequence->empty() ) {
-                                        tmp->push( relative_sequence->front() );
-                                        relative_sequence->pop();
-                                    }
-                                    // std::swap( tmp, relative_sequence );
-                                    adapter::QueueAdapter<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>::swap( *tmp, *relative_sequence );
+                                if( this->decoding_relative_buffer.empty() ) {
+                                    throw std::runtime_error("RiceRunsReader/next> Decoding error state!");
                                 }
 
-                                // Retrieve a transformed sequence from the relative one:
-                                this->decoding_next_buffer.reset();
-                                this->decoding_next_buffer = samg::grcodec::toolkits::RunLengthCommon<Word>::get_transformed_absolute_sequence( relative_sequence );
-                                
-                                // Back up the last relativized (transformed) absolute value:
-                                this->decoding_previous_relative_value = samg::grcodec::toolkits::RunLengthCommon<Word>::transform_rval( this->decoding_next_buffer->back() );
-                                // std::cout << "\t\tOfflineRiceRunsReader/next> decoding_previous_relative_value = " << this->decoding_previous_relative_value << std::endl;
-                                
-                                // It it is not the first time executing `next`, then remove the previously added last relativized absolute value:
-                                // (it was already used to compute the next absolute value(s))
-                                if( !this->decoding_is_first ){
-                                    this->decoding_next_buffer->pop();
+                                // Recover absolute values from the relative ones, resuming from the last recovered value:
+                                while( !this->decoding_relative_buffer.empty() ) {
+                                    this->decoding_last = samg::grcodec::toolkits::RunLengthCommon<Word>::apply_rval( this->decoding_last, this->decoding_relative_buffer.front() );
+                                    this->decoding_relative_buffer.pop();
+                                    this->decoding_next_buffer.push( this->decoding_last );
                                 }
-                                
-                                this->decoding_is_first = false;
                             }
 
-                            Word v = this->decoding_next_buffer->front();
-                            this->decoding_next_buffer->pop();
-                            // std::cout << "\t\tOfflineRiceRunsReader/next> v = " << v << "; |decoding_next_buffer| = " << this->decoding_next_buffer->size() << std::endl;
+                            Word v = this->decoding_next_buffer.front();
+                            this->decoding_next_buffer.pop();
+                            // std::cout << "\t\tOfflineRiceRunsReader/next> v = " << v << "; |decoding_next_buffer| = " << this->decoding_next_buffer.size() << std::endl;
                             return v;
                         }
 
+                        std::size_t decode_block( Word* out, const std::size_t n ) override {
+                            std::size_t i = 0;
+                            // Values left over by `next()` or by a previous block come first:
+                            while( i < n && !this->decoding_next_buffer.empty() ) {
+                                out[i++] = this->decoding_next_buffer.front();
+                                this->decoding_next_buffer.pop();
+                            }
+                            i += samg::grcodec::toolkits::RunLengthCommon<Word>::decode_tokens( *(this->codec), out + i, n - i, this->decoding_last, this->decoding_next_buffer );
+                            return i;
+                        }
+
                         void restart( ) override {
                             // std::cout << "OfflineRiceRunsReader/restart> (1) " << std::endl;
                             this->decoding_previous_n = 0;
                             this->decoding_n = 0;
-                            this->decoding_previous_relative_value = 0;
-                            this->decoding_is_first = true;
+                            this->decoding_last = 0;
 
                             // if( !(this->is_open) ) {
                             //     this->codec = std::make_shared<samg::grcodec::rice::reader::OfflineRCodecReader<Word>>( this->get_file_name() );
@@ -2609,10 +4896,12 @@ namespace samg {
 
                             // std::cout << "OfflineRiceRunsReader/restart> (4) " << std::endl;
                         
-                            if( this->decoding_next_buffer ) { 
-                                this->decoding_next_buffer.reset();
+                            while( !this->decoding_next_buffer.empty() ) {
+                                this->decoding_next_buffer.pop();
+                            }
+                            while( !this->decoding_relative_buffer.empty() ) {
+                                this->decoding_relative_buffer.pop();
                             }
-                            this->decoding_next_buffer = adapter::get_instance<Word>( adapter::QueueAdapterType::Q_QUEUEADAPTER );
 
                             // std::cout << "OfflineRiceRunsReader/restart> (5) " << std::endl;
                             // if( this->encoding_buffer ){
@@ -2625,7 +4914,7 @@ namespace samg {
                             // return this->codec.has_more();
                             return  //this->is_open && (
                                         this->codec->has_more() || 
-                                        !(this->decoding_next_buffer->empty());
+                                        !(this->decoding_next_buffer.empty());
                                     //);
                         }
 
@@ -2633,7 +4922,6 @@ namespace samg {
                             // if( this->is_open ) {
                                 this->codec->close();
                                 this->codec.reset();
-                                this->decoding_next_buffer.reset();
                                 // this->encoding_buffer.reset();
                                 // this->is_open = false;
                             // }
@@ -2663,7 +4951,14 @@ namespace samg {
                         
                 };
 
-                template<typename Word> class OnlineRiceRunsReader : public samg::grcodec::base::reader::CodecFileReader<Word>, samg::grcodec::base::MetadataKeeper {
+                /**
+                 * @brief This class represents an unsigned integer Rice-runs decoder over an online serializer. This codec uses OnlineRCodecReader class by default.
+                 * 
+                 * @tparam Word 
+                 * @tparam Queue is the FIFO type of the internal buffers; the non-virtual `adapter::RingBuffer` by default.
+                 * @tparam Decoder reads the run tokens; it must match the `Encoder` of the writer (e.g., `universal::reader::OfflineExpGolombCodecReader` for `universal::writer::OfflineExpGolombCodecWriter`).
+                 */
+                template<typename Word, template<typename> class Queue = samg::grcodec::adapter::RingBuffer, typename Decoder = samg::grcodec::rice::reader::OnlineRCodecReader<Word>> class OnlineRiceRunsReader : public samg::grcodec::base::reader::CodecFileReader<Word>, samg::grcodec::base::MetadataKeeper {
                     private:
                         /**
                          * @brief This class represents a FSM for decoding. 
@@ -2671,8 +4966,6 @@ namespace samg {
                          */
                         class FSMDecoder {
                             private:
-                                bool is_init = false;
-
                                 /**
                                  * @brief States of the FSM.
                                  * 
@@ -2690,7 +4983,7 @@ namespace samg {
                                     DS_Q9,      //9
                                     DS_SINK,    //10 Sink after a run was written.
                                     DS_ERROR    //11
-                                } current_state; // Current state.
+                                } current_state = DState::DS_Q0; // Current state.
 
                                 /**
                                  * @brief Cases generated by inputs in the FSM. 
@@ -2704,117 +4997,60 @@ namespace samg {
                                     DC_ERROR    //4
                                 };
 
-                                /**
-                                 * @brief Functions to be executed by each state.
-                                 * 
-                                 */
-                                const std::array<std::function<void( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>, Word&, const Word )>,12> sfunction = {
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q0
-                                        // Empty
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q1
-                                        _write_integer_( rs, n, 1 );
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q2
-                                        // Empty
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q3
-                                        _write_integer_( rs, n, 1, samg::grcodec::toolkits::RunLengthCommon<Word>::IS_NEGATIVE );
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_04
-                                        // Empty
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q5
-                                        previous_n = n;
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q6
-                                        _write_integer_( rs, previous_n, n );
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q7
-                                        // Empty
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q8
-                                        previous_n = n;
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_Q9
-                                        _write_integer_( rs, previous_n, n, samg::grcodec::toolkits::RunLengthCommon<Word>::IS_NEGATIVE );
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_SINK
-                                        // Empty
-                                    },
-                                    []( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<>rs, Word &previous_n,const Word n ) { // DS_ERROR
-                                        throw std::runtime_error("Decoding error state!");
-                                    }
-                                };
-
                                 /**
                                  * @brief States matrix.
                                  * 
                                  */
-                                const std::array<std::array<DState,5>,12> fsm = {
-                                                    //   n!=NEG & n!=REP       n == NEG              n == REP               EOS                    ERROR
-                                    std::array<DState,5>({DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}), // DS_Q0
-                                    std::array<DState,5>({DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}), // DS_Q1
-                                    std::array<DState,5>({DState::DS_Q3,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}), // DS_Q2
-                                    std::array<DState,5>({DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}), // DS_Q3
-                                    std::array<DState,5>({DState::DS_Q5,       DState::DS_Q7,        DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}), // DS_Q4
-                                    std::array<DState,5>({DState::DS_Q6,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}), // DS_Q5
-                                    std::array<DState,5>({DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}), // DS_Q6
-                                    std::array<DState,5>({DState::DS_Q8,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}), // DS_Q7
-                                    std::array<DState,5>({DState::DS_Q9,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}), // DS_Q8
-                                    std::array<DState,5>({DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}), // DS_Q9
-                                    std::array<DState,5>({DState::DS_ERROR,    DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}), // DS_SINK
-                                    std::array<DState,5>({DState::DS_ERROR,    DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR})  // DS_ERROR
-                                };
+                                static constexpr std::array<std::array<DState,5>,12> fsm = {{
+                                    //   n!=NEG & n!=REP       n == NEG              n == REP               EOS                    ERROR
+                                    {{DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}}, // DS_Q0
+                                    {{DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}}, // DS_Q1
+                                    {{DState::DS_Q3,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}, // DS_Q2
+                                    {{DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}}, // DS_Q3
+                                    {{DState::DS_Q5,       DState::DS_Q7,        DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}, // DS_Q4
+                                    {{DState::DS_Q6,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}, // DS_Q5
+                                    {{DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}}, // DS_Q6
+                                    {{DState::DS_Q8,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}, // DS_Q7
+                                    {{DState::DS_Q9,       DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}, // DS_Q8
+                                    {{DState::DS_Q1,       DState::DS_Q2,        DState::DS_Q4,        DState::DS_SINK,      DState::DS_ERROR}}, // DS_Q9
+                                    {{DState::DS_ERROR,    DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}, // DS_SINK
+                                    {{DState::DS_ERROR,    DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR,     DState::DS_ERROR}}  // DS_ERROR
+                                }};
 
                                 /**
-                                 * @brief This function writes the output to a relative sequence vector.
+                                 * @brief This function writes the output to a relative sequence.
                                  * 
                                  * @param rs 
                                  * @param n 
                                  * @param r 
                                  * @param is_negative 
                                  */
-                                static void _write_integer_( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> rs, const Word n, const std::size_t r, const bool is_negative = false ) {
-                                    typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t x = is_negative ? ((typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t)n) * -1 : n;
+                                static inline void _write_integer_( Queue<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>& rs, const Word n, const std::size_t r, const bool is_negative = false ) {
+                                    const typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t x = samg::grcodec::toolkits::RunLengthCommon<Word>::decode_rval( n, is_negative );
                                     for (std::size_t j = 0; j < r; ++j) {
-                                        // rs.push_back(x);
-                                        rs->push(x);
+                                        rs.push(x);
                                     }
                                 }
 
                                 /**
                                  * @brief This function identifies the case generated by a next FSM input. 
                                  * 
+                                 * @tparam Codec is a Rice reader; calling its `final` members avoids virtual dispatch.
                                  * @param codec 
                                  * @param n 
                                  * @return const DCase 
                                  */
-                                static const DCase _get_case_( std::shared_ptr<samg::grcodec::base::reader::CodecReader<Word>> codec, Word &n ) {
-                                    if( !codec->has_more() ) {
+                                template<typename Codec> static inline const DCase _get_case_( Codec& codec, Word &n ) {
+                                    if( !codec.has_more() ) {
                                         return DCase::DC_EOS;
-                                    }else {
-                                        n = codec->next();
-                                        if( n != samg::grcodec::toolkits::RunLengthCommon<Word>::NEGATIVE_FLAG && n != samg::grcodec::toolkits::RunLengthCommon<Word>::REPETITION_FLAG ) {
-                                            return DCase::DC_INT;
-                                        } else if( n == samg::grcodec::toolkits::RunLengthCommon<Word>::NEGATIVE_FLAG ) {
-                                            return DCase::DC_NEGFLAG;
-                                        } else if( n == samg::grcodec::toolkits::RunLengthCommon<Word>::REPETITION_FLAG ) {
-                                            return DCase::DC_REPFLAG;
-                                        } else {
-                                            return DCase::DC_ERROR;
-                                        }
                                     }
-                                }
-
-                                /**
-                                 * @brief This function initializes the FSM.
-                                 * 
-                                 * @param codec 
-                                 * @param n 
-                                 */
-                                void _init_( Word &n ) {
-                                    this->current_state = DState::DS_Q0;
+                                    n = codec.next();
+                                    if( n == samg::grcodec::toolkits::RunLengthCommon<Word>::NEGATIVE_FLAG ) {
+                                        return DCase::DC_NEGFLAG;
+                                    } else if( n == samg::grcodec::toolkits::RunLengthCommon<Word>::REPETITION_FLAG ) {
+                                        return DCase::DC_REPFLAG;
+                                    }
+                                    return DCase::DC_INT;
                                 }
 
                             public:
@@ -2822,32 +5058,45 @@ namespace samg {
                                 /**
                                  * @brief This function allows moving the FSM to the next state.
                                  * 
+                                 * @tparam Codec 
                                  * @param codec 
-                                 * @param previous_n 
                                  * @param n 
                                  * @return DState 
                                  */
-                                DState next( std::shared_ptr<samg::grcodec::base::reader::CodecReader<Word>> codec, Word &previous_n, Word &n ) {
-                                    if( !this->is_init ) {
-                                        this->_init_( n );
-                                        this->is_init = true;
-                                    }
-                                    // DCase c = FSMDecoder::_get_case_( codec, n );
-                                    // this->current_state = fsm[this->current_state][ c ];
-                                    // std::cout << "\t\t\tOfflineRiceRunsReader/FSMDecoder/next> current_state = "<< this->current_state << "; case = " << c << std::endl;
-                                    // return this->current_state;
-                                    return this->current_state = fsm[this->current_state][ FSMDecoder::_get_case_( codec, n ) ];
+                                template<typename Codec> inline DState next( Codec& codec, Word &n ) {
+                                    return this->current_state = FSMDecoder::fsm[this->current_state][ FSMDecoder::_get_case_( codec, n ) ];
                                 }
 
                                 /**
-                                 * @brief This function allows running the current state's associated function. 
+                                 * @brief This function allows running the current state's associated action. 
                                  * 
                                  * @param rs 
                                  * @param previous_n 
                                  * @param n 
                                  */
-                                void run( typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> rs, Word &previous_n, const Word n ) {
-                                    this->sfunction[this->current_state]( rs, previous_n, n );
+                                inline void run( Queue<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>& rs, Word &previous_n, const Word n ) {
+                                    switch( this->current_state ) {
+                                        case DState::DS_Q1:
+                                            FSMDecoder::_write_integer_( rs, n, 1 );
+                                            break;
+                                        case DState::DS_Q3:
+                                            FSMDecoder::_write_integer_( rs, n, 1, samg::grcodec::toolkits::RunLengthCommon<Word>::IS_NEGATIVE );
+                                            break;
+                                        case DState::DS_Q5:
+                                        case DState::DS_Q8:
+                                            previous_n = n;
+                                            break;
+                                        case DState::DS_Q6:
+                                            FSMDecoder::_write_integer_( rs, previous_n, n );
+                                            break;
+                                        case DState::DS_Q9:
+                                            FSMDecoder::_write_integer_( rs, previous_n, n, samg::grcodec::toolkits::RunLengthCommon<Word>::IS_NEGATIVE );
+                                            break;
+                                        case DState::DS_ERROR:
+                                            throw std::runtime_error("Decoding error state!");
+                                        default: // DS_Q0, DS_Q2, DS_Q4, DS_Q7, and DS_SINK have no action.
+                                            break;
+                                    }
                                 }
                                 
                                 /**
@@ -2882,23 +5131,23 @@ namespace samg {
                                  * 
                                  */
                                 void restart() {
-                                    this->is_init = false;
+                                    this->current_state = DState::DS_Q0;
                                 }
                         };
 
                         // Attributes for relative-sequence traversal:
-                        std::shared_ptr<samg::grcodec::rice::reader::OnlineRCodecReader<Word>> codec;
+                        std::shared_ptr<Decoder> codec;
                         FSMDecoder                      decoding_fsm;
                         Word                            decoding_previous_n, 
                                                         decoding_n;
-                        typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t decoding_previous_relative_value;
-                        typename samg::grcodec::toolkits::RunLengthCommon<Word>::AbsoluteSequence<> decoding_next_buffer;
+                        Word                            decoding_last; // Last decoded absolute value (0 before the first one).
+                        Queue<Word> decoding_next_buffer;
+                        Queue<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t> decoding_relative_buffer; // Relative values of the token being decoded by `next()`.
                         // typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> encoding_buffer;
                         // bool    is_open,
-                        bool decoding_is_first;
 
                     public:
-                        OnlineRiceRunsReader( std::shared_ptr<samg::grcodec::rice::reader::OnlineRCodecReader<Word>> codec ):
+                        OnlineRiceRunsReader( std::shared_ptr<Decoder> codec ):
                             samg::grcodec::base::reader::CodecFileReader<Word>::CodecFileReader( codec->get_file_name() ),
                             codec ( codec )  { 
                             // this->encoding_is_first = true;
@@ -2913,58 +5162,46 @@ namespace samg {
                             //     throw std::runtime_error("Stream from file \""+this->get_file_name()+"\" is not openned!");
                             // }
                             // std::cout << "OfflineRiceRunsReader/next> decoding_previous_n = " << this->decoding_previous_n << "; decoding_n = " << this->decoding_n << std::endl;
-                            if( this->decoding_next_buffer->empty() ) {
-                                std::uint8_t s;
-                                typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> relative_sequence  = adapter::get_instance<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>( adapter::QueueAdapterType::Q_QUEUEADAPTER );
+                            if( this->decoding_next_buffer.empty() ) {
                                 do { 
-                                    s = this->decoding_fsm.next( this->codec, this->decoding_previous_n, this->decoding_n);
+                                    this->decoding_fsm.next( *(this->codec), this->decoding_n );
                                     if( this->decoding_fsm.is_error_state() ) { break; }
-                                    // std::cout << "\t\tOfflineRiceRunsReader/next> pre-run --- decoding_previous_n = " << this->decoding_previous_n << "; decoding_n = " << this->decoding_n << "; |relative_sequence| = " << relative_sequence->size() << std::endl;
-                                    this->decoding_fsm.run( relative_sequence, this->decoding_previous_n, this->decoding_n );
-                                    // std::cout << "\t\tOfflineRiceRunsReader/next> post-run --- decoding_previous_n = " << this->decoding_previous_n << "; decoding_n = " << this->decoding_n << "; |relative_sequence| = " << relative_sequence->size() << std::endl;
+                                    this->decoding_fsm.run( this->decoding_relative_buffer, this->decoding_previous_n, this->decoding_n );
                                 }while( !this->decoding_fsm.is_output_state() );
-
-                                // If it is not the first time executing `next`, then insert the previous relativized absolute value to the beginning of the just retrieved relative sequence:
-                                if( !this->decoding_is_first ) {
-                                    typename samg::grcodec::toolkits::RunLengthCommon<Word>::RelativeSequence<> tmp = adapter::get_instance<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>( adapter::QueueAdapterType::Q_QUEUEADAPTER );
-                                    tmp->push( this->decoding_previous_relative_value );
-                                    while( !relative_sequence->empty() ) {
-                                        tmp->push( relative_sequence->front() );
-                                        relative_sequence->pop();
-                                    }
-                                    // std::swap( tmp, relative_sequence );
-                                    adapter::QueueAdapter<typename samg::grcodec::toolkits::RunLengthCommon<Word>::rseq_t>::swap( *tmp, *relative_sequence );
+                                if( this->decoding_relative_buffer.empty() ) {
+                                    throw std::runtime_error("RiceRunsReader/next> Decoding error state!");
                                 }
 
-                                // Retrieve a transformed sequence from the relative one:
-                                this->decoding_next_buffer.reset();
-                                this->decoding_next_buffer = samg::grcodec::toolkits::RunLengthCommon<Word>::get_transformed_absolute_sequence( relative_sequence );
-                                
-                                // Back up the last relativized (transformed) absolute value:
-                                this->decoding_previous_relative_value = samg::grcodec::toolkits::RunLengthCommon<Word>::transform_rval( this->decoding_next_buffer->back() );
-                                // std::cout << "\t\tOfflineRiceRunsReader/next> decoding_previous_relative_value = " << this->decoding_previous_relative_value << std::endl;
-                                
-                                // It it is not the first time executing `next`, then remove the previously added last relativized absolute value:
-                                // (it was already used to compute the next absolute value(s))
-                                if( !this->decoding_is_first ){
-                                    this->decoding_next_buffer->pop();
+                                // Recover absolute values from the relative ones, resuming from the last recovered value:
+                                while( !this->decoding_relative_buffer.empty() ) {
+                                    this->decoding_last = samg::grcodec::toolkits::RunLengthCommon<Word>::apply_rval( this->decoding_last, this->decoding_relative_buffer.front() );
+                                    this->decoding_relative_buffer.pop();
+                                    this->decoding_next_buffer.push( this->decoding_last );
                                 }
-                                
-                                this->decoding_is_first = false;
                             }
 
-                            Word v = this->decoding_next_buffer->front();
-                            this->decoding_next_buffer->pop();
-                            // std::cout << "\t\tOfflineRiceRunsReader/next> v = " << v << "; |decoding_next_buffer| = " << this->decoding_next_buffer->size() << std::endl;
+                            Word v = this->decoding_next_buffer.front();
+                            this->decoding_next_buffer.pop();
+                            // std::cout << "\t\tOfflineRiceRunsReader/next> v = " << v << "; |decoding_next_buffer| = " << this->decoding_next_buffer.size() << std::endl;
                             return v;
                         }
 
+                        std::size_t decode_block( Word* out, const std::size_t n ) override {
+                            std::size_t i = 0;
+                            // Values left over by `next()` or by a previous block come first:
+                            while( i < n && !this->decoding_next_buffer.empty() ) {
+                                out[i++] = this->decoding_next_buffer.front();
+                                this->decoding_next_buffer.pop();
+                            }
+                            i += samg::grcodec::toolkits::RunLengthCommon<Word>::decode_tokens( *(this->codec), out + i, n - i, this->decoding_last, this->decoding_next_buffer );
+                            return i;
+                        }
+
                         void restart( ) override {
                             // std::cout << "OfflineRiceRunsReader/restart> (1) " << std::endl;
                             this->decoding_previous_n = 0;
                             this->decoding_n = 0;
-                            this->decoding_previous_relative_value = 0;
-                            this->decoding_is_first = true;
+                            this->decoding_last = 0;
 
                             // if( !(this->is_open) ) {
                             //     this->codec = std::make_shared<samg::grcodec::rice::reader::OfflineRCodecReader<Word>>( this->get_file_name() );
@@ -2983,10 +5220,12 @@ namespace samg {
 
                             // std::cout << "OfflineRiceRunsReader/restart> (4) " << std::endl;
                         
-                            if( this->decoding_next_buffer ) { 
-                                this->decoding_next_buffer.reset();
+                            while( !this->decoding_next_buffer.empty() ) {
+                                this->decoding_next_buffer.pop();
+                            }
+                            while( !this->decoding_relative_buffer.empty() ) {
+                                this->decoding_relative_buffer.pop();
                             }
-                            this->decoding_next_buffer = adapter::get_instance<Word>( adapter::QueueAdapterType::Q_QUEUEADAPTER );
 
                             // std::cout << "OfflineRiceRunsReader/restart> (5) " << std::endl;
                             // if( this->encoding_buffer ){
@@ -2999,7 +5238,7 @@ namespace samg {
                             // return this->codec.has_more();
                             return  //this->is_open && (
                                         this->codec->has_more() || 
-                                        !(this->decoding_next_buffer->empty());
+                                        !(this->decoding_next_buffer.empty());
                                     //);
                         }
 
@@ -3007,7 +5246,6 @@ namespace samg {
                             // if( this->is_open ) {
                                 this->codec->close();
                                 this->codec.reset();
-                                this->decoding_next_buffer.reset();
                                 // this->encoding_buffer.reset();
                                 // this->is_open = false;
                             // }
@@ -3036,6 +5274,278 @@ namespace samg {
                         }
                         
                 };
+
+                /**
+                 * @brief This class represents a decoder of sequences written by `OfflineBlockedRiceRunsWriter`. Values can be streamed with `next()`/`decode_block()`, or whole block ranges can be decoded in parallel with `decode_blocks()`/`decode_all()`.
+                 * 
+                 * @tparam Word 
+                 */
+                template<typename Word> class OfflineBlockedRiceRunsReader : public samg::grcodec::base::reader::CodecFileReader<Word>, public samg::grcodec::base::MetadataSaver {
+                    private:
+                        struct Entry {
+                            std::size_t byte_offset,
+                                        bit_length,
+                                        token_count,
+                                        k;
+                        };
+
+                        /**
+                         * @brief Decoding state of a single thread: its own file handle, bit buffer, token scratch and Rice tables.
+                         * 
+                         */
+                        class BlockDecoder {
+                            private:
+                                /**
+                                 * @brief Feeds decoded tokens to `RunLengthCommon::decode_tokens`.
+                                 * 
+                                 */
+                                struct TokenCursor {
+                                    const Word* token;
+                                    const Word* end;
+                                    inline const Word next() {
+                                        return *(this->token++);
+                                    }
+                                    inline const bool has_more() const {
+                                        return this->token < this->end;
+                                    }
+                                };
+
+                                static constexpr std::size_t TOKEN_SLACK = 3ZU; // A truncated token may read up to 3 tokens past the end.
+                                std::unique_ptr<samg::serialization::OfflineWordReader<Word>> serializer;
+                                samg::grcodec::toolkits::BitBuffer<samg::serialization::OfflineWordReader<Word>> bits;
+                                std::array<std::unique_ptr<samg::grcodec::toolkits::RiceTable<>>, samg::grcodec::toolkits::RiceTable<>::MAX_K + 1ZU> tables; // Built on first use.
+                                std::vector<Word> tokens;
+                                samg::grcodec::adapter::RingBuffer<Word> overflow;
+
+                            public:
+                                BlockDecoder( const std::string file_name ) :
+                                    serializer ( std::make_unique<samg::serialization::OfflineWordReader<Word>>( file_name ) ) {}
+
+                                /**
+                                 * @brief Decodes the `n` values of the block described by `entry` into `out`.
+                                 * 
+                                 * @param entry 
+                                 * @param out 
+                                 * @param n 
+                                 */
+                                void decode( const Entry& entry, Word* out, const std::size_t n ) {
+                                    const samg::grcodec::toolkits::RiceTable<>* table = nullptr;
+                                    if( entry.k <= samg::grcodec::toolkits::RiceTable<>::MAX_K ) {
+                                        if( !this->tables[ entry.k ] ) {
+                                            this->tables[ entry.k ] = std::make_unique<samg::grcodec::toolkits::RiceTable<>>( entry.k );
+                                        }
+                                        table = this->tables[ entry.k ].get();
+                                    }
+                                    this->tokens.assign( entry.token_count + BlockDecoder::TOKEN_SLACK, 0 );
+                                    this->serializer->seek( entry.byte_offset, std::ios_base::beg );
+                                    this->bits.reset( this->serializer.get(), entry.byte_offset * 8ZU );
+                                    const std::size_t decoded = this->bits.template read_rice_block<Word>( this->tokens.data(), entry.token_count, entry.k, entry.byte_offset * 8ZU + entry.bit_length, table );
+                                    if( decoded != entry.token_count ) {
+                                        throw std::runtime_error("OfflineBlockedRiceRunsReader/decode> Truncated block: "+std::to_string(decoded)+" of "+std::to_string(entry.token_count)+" tokens.");
+                                    }
+                                    TokenCursor cursor { this->tokens.data(), this->tokens.data() + entry.token_count };
+                                    Word last = 0;
+                                    const std::size_t m = samg::grcodec::toolkits::RunLengthCommon<Word>::decode_tokens( cursor, out, n, last, this->overflow );
+                                    if( m != n || cursor.has_more() || !this->overflow.empty() ) {
+                                        throw std::runtime_error("OfflineBlockedRiceRunsReader/decode> Corrupted block: it does not hold "+std::to_string(n)+" values.");
+                                    }
+                                }
+                        };
+
+                        std::vector<Entry> directory;
+                        std::size_t block_values,
+                                    value_count, // Number of encoded values.
+                                    value_counter, // Number of decoded values.
+                                    block_index, // Next block to be loaded.
+                                    block_head, // Next value within `block`.
+                                    block_fill; // Values in `block`.
+                        std::vector<Word> block; // Values of the current block.
+                        std::unique_ptr<BlockDecoder> decoder;
+
+                        void _retrieve_metadata_() {
+                            // block_values, value_count, blocks, directory, ..., metadata_size
+                            samg::serialization::OfflineWordReader<Word> serializer( this->get_file_name() );
+                            std::size_t nbytes = serializer.size();
+                            serializer.seek( nbytes - sizeof(std::size_t) , std::ios_base::beg );
+                            std::size_t metadata_size = serializer.template next<std::size_t>();
+                            serializer.seek( nbytes - ((metadata_size + 1) * sizeof(std::size_t)), std::ios_base::beg );
+                            for (std::size_t i = 0; i < metadata_size; i++) {
+                                this->add_metadata( serializer.template next<std::size_t>() );
+                            }
+                            serializer.close();
+                        }
+
+                        /**
+                         * @brief Decodes the next block into `block`.
+                         * 
+                         */
+                        void _load_block_() {
+                            this->block_fill = this->get_block_length( this->block_index );
+                            this->decoder->decode( this->directory[ this->block_index ], this->block.data(), this->block_fill );
+                            this->block_head = 0ZU;
+                            ++(this->block_index);
+                        }
+
+                    public:
+                        /**
+                         * @brief Construct a new Offline Blocked Rice Runs Reader object
+                         * 
+                         * @param file_name 
+                         */
+                        OfflineBlockedRiceRunsReader( const std::string file_name ) :
+                            samg::grcodec::base::reader::CodecFileReader<Word>::CodecFileReader( file_name ) {
+                            // Loading metadata:
+                            this->_retrieve_metadata_();
+                            if( this->metadata.size() < 3ZU ) {
+                                throw std::runtime_error("OfflineBlockedRiceRunsReader> Missing block directory in \""+file_name+"\".");
+                            }
+                            this->block_values = this->metadata[0];
+                            this->value_count = this->metadata[1];
+                            const std::size_t blocks = this->metadata[2],
+                                              L = samg::grcodec::runlength::writer::OfflineBlockedRiceRunsWriter<Word>::DIRECTORY_ENTRY_LENGTH;
+                            if( this->metadata.size() < 3ZU + L * blocks || this->block_values == 0ZU || ( this->value_count + this->block_values - 1ZU ) / this->block_values != blocks ) {
+                                throw std::runtime_error("OfflineBlockedRiceRunsReader> Corrupted block directory in \""+file_name+"\".");
+                            }
+                            this->directory.resize( blocks );
+                            for( std::size_t b = 0; b < blocks; ++b ) {
+                                const std::size_t* e = this->metadata.data() + 3ZU + L * b;
+                                this->directory[b] = Entry { e[0], e[1], e[2], e[3] };
+                            }
+                            this->metadata.erase( this->metadata.begin(), this->metadata.begin() + 3ZU + L * blocks ); // Erasing header and directory from metadata.
+                            this->block.resize( std::min( this->block_values, this->value_count ) );
+                            this->restart();
+                        }
+
+                        const std::size_t get_block_values() const {
+                            return this->block_values;
+                        }
+
+                        const std::size_t get_number_of_blocks() const {
+                            return this->directory.size();
+                        }
+
+                        const std::size_t get_value_count() const {
+                            return this->value_count;
+                        }
+
+                        /**
+                         * @brief Returns the number of values in block `b`; only the last block may be shorter than `block_values`.
+                         * 
+                         * @param b 
+                         * @return const std::size_t 
+                         */
+                        const std::size_t get_block_length( const std::size_t b ) const {
+                            return std::min( this->block_values, this->value_count - b * this->block_values );
+                        }
+
+                        const Word next( ) override final {
+                            if( this->block_head == this->block_fill ) {
+                                this->_load_block_();
+                            }
+                            ++(this->value_counter);
+                            return this->block[ this->block_head++ ];
+                        }
+
+                        const bool has_more( ) const override final {
+                            return this->value_counter < this->value_count;
+                        }
+
+                        std::size_t decode_block( Word* out, const std::size_t n ) override {
+                            std::size_t i = 0;
+                            while( i < n && this->has_more() ) {
+                                if( this->block_head == this->block_fill ) {
+                                    const std::size_t length = this->get_block_length( this->block_index );
+                                    if( n - i >= length ) { // Whole blocks are decoded straight into `out`.
+                                        this->decoder->decode( this->directory[ this->block_index ], out + i, length );
+                                        ++(this->block_index);
+                                        i += length;
+                                        this->value_counter += length;
+                                        continue;
+                                    }
+                                    this->_load_block_();
+                                }
+                                const std::size_t m = std::min( n - i, this->block_fill - this->block_head );
+                                std::copy( this->block.begin() + this->block_head, this->block.begin() + this->block_head + m, out + i );
+                                this->block_head += m;
+                                this->value_counter += m;
+                                i += m;
+                            }
+                            return i;
+                        }
+
+                        /**
+                         * @brief Decodes blocks [first, last) into `out` (the first value of block `first` lands at `out[0]`), spreading them over `nthreads` threads. It does not move the streaming cursor.
+                         * 
+                         * @param first 
+                         * @param last 
+                         * @param out must hold the values of all the blocks in the range.
+                         * @param nthreads 
+                         */
+                        void decode_blocks( const std::size_t first, const std::size_t last, Word* out, const std::size_t nthreads = std::thread::hardware_concurrency() ) const {
+                            if( first > last || last > this->directory.size() ) {
+                                throw std::invalid_argument("OfflineBlockedRiceRunsReader/decode_blocks> Invalid block range ["+std::to_string(first)+","+std::to_string(last)+") out of "+std::to_string(this->directory.size())+" blocks.");
+                            }
+                            std::atomic<std::size_t> next_block ( first );
+                            auto worker = [&]( std::exception_ptr& error ) {
+                                try {
+                                    BlockDecoder decoder( this->get_file_name() );
+                                    for( std::size_t b = next_block++; b < last; b = next_block++ ) {
+                                        decoder.decode( this->directory[b], out + ( b - first ) * this->block_values, this->get_block_length( b ) );
+                                    }
+                                } catch( ... ) {
+                                    error = std::current_exception();
+                                    next_block = last; // Stop the other workers early.
+                                }
+                            };
+                            const std::size_t workers_count = std::max<std::size_t>( 1ZU, std::min( nthreads, last - first ) );
+                            std::vector<std::exception_ptr> errors( workers_count );
+                            if( workers_count == 1ZU ) {
+                                worker( errors[0] );
+                            } else {
+                                std::vector<std::thread> workers;
+                                workers.reserve( workers_count );
+                                for( std::size_t t = 0; t < workers_count; ++t ) {
+                                    workers.emplace_back( worker, std::ref( errors[t] ) );
+                                }
+                                for( auto& w : workers ) {
+                                    w.join();
+                                }
+                            }
+                            for( const auto& error : errors ) {
+                                if( error ) {
+                                    std::rethrow_exception( error );
+                                }
+                            }
+                        }
+
+                        /**
+                         * @brief Decodes the whole sequence in parallel.
+                         * 
+                         * @param nthreads 
+                         * @return std::vector<Word> 
+                         */
+                        std::vector<Word> decode_all( const std::size_t nthreads = std::thread::hardware_concurrency() ) const {
+                            std::vector<Word> out( this->value_count );
+                            this->decode_blocks( 0ZU, this->directory.size(), out.data(), nthreads );
+                            return out;
+                        }
+
+                        void restart() override {
+                            this->decoder = std::make_unique<BlockDecoder>( this->get_file_name() );
+                            this->value_counter = 0ZU;
+                            this->block_index = 0ZU;
+                            this->block_head = 0ZU;
+                            this->block_fill = 0ZU;
+                        }
+
+                        const std::vector<std::size_t> get_metadata() const override {
+                            return this->metadata;
+                        }
+
+                        void close( ) override {
+                            this->decoder.reset();
+                        }
+                };
             }
         }
     }
@@ -12,6 +12,8 @@
 #include <type_traits>
 #include <typeinfo>
 #include <cmath>
+#include <cstring>
+#include <algorithm>
 // #include <set>
 #include <boost/algorithm/string.hpp>
 // #include <boost/range.hpp>
@@ -206,7 +208,7 @@ namespace samg {
          * @param n 
          * @return std::string 
          */
-        std::string number_to_comma_separated_string( const double n, const std::size_t precision = 0 ) {
+        inline std::string number_to_comma_separated_string( const double n, const std::size_t precision = 0 ) {
             std::stringstream ss;
             // ss.imbue(std::locale("en_US.UTF-8"));  // Use the appropriate locale for your system
             ss.imbue(std::locale("C"));  // Use the appropriate locale for your system
@@ -220,7 +222,7 @@ namespace samg {
          * @param file_name 
          * @return std::size_t 
          */
-        std::size_t get_file_size( const std::string file_name ) {
+        inline std::size_t get_file_size( const std::string file_name ) {
             // Open the file in read mode:
             std::ifstream file(file_name, std::ios::binary);
             // Checking if file is opened:
@@ -262,7 +264,7 @@ namespace samg {
          * @param base 
          * @return std::uint64_t 
          */
-        std::uint64_t from_base(std::string str, int base = 10) {
+        inline std::uint64_t from_base(std::string str, int base = 10) {
             if (base < 2 or base > 36) {
                 throw std::invalid_argument("base " + std::to_string(base) + " is not between 2 and 36");
             }
@@ -295,7 +297,7 @@ namespace samg {
          * @param length 
          * @return std::string 
          */
-        const std::string to_base(std::uint64_t number, const int base, const std::size_t length = 0 ) {
+        inline const std::string to_base(std::uint64_t number, const int base, const std::size_t length = 0 ) {
             if (base < 2 or base > 36) {
                 throw std::invalid_argument("base " + std::to_string(base) + " is not between 2 and 36");
             }
@@ -395,6 +397,27 @@ namespace samg {
                     return zv;
                 }
 
+                /**
+                 * @brief Converts from n-dimensional coordinates stored in a raw array C to z-order, avoiding any temporary allocation.
+                 * 
+                 * @tparam UINT_T 
+                 * @param C points to the first of the n components.
+                 * @param n are the number of dimensions of the hyper-space.
+                 * @param b is the number of bits per coordinate component considered for Z-ordering.
+                 * @param d is the number of digits to encode a component considered for Z-ordering.
+                 * @param M is the initial mask to retrieve bits from each coordinate component.
+                 * @return std::uint64_t 
+                 */
+                template<typename UINT_T> static std::uint64_t _to_zvalue_( const UINT_T* C, const std::size_t n, const std::size_t b, const std::size_t d, const std::size_t M ) {
+                    std::uint64_t zv = 0ULL;
+                    for (int i = d - 1; i >= 0; --i) {
+                        for (std::size_t j = 0; j < n; ++j) {
+                            zv = ( zv << b ) | ( ( static_cast<std::uint64_t>(C[j]) >> (i * b) ) & M );
+                        }
+                    }
+                    return zv;
+                }
+
                 /**
                  * @brief Converts from z-order to n-dimensional coordinates.
                  * 
@@ -442,7 +465,23 @@ namespace samg {
                     return this->_to_zvalue_( C, this->n, this->b, this->d, this->bd, this->initial_M );
                 }
                 const std::uint64_t to_zvalue( const unsigned long long int* C ) {
-                    return this->to_zvalue(  std::vector<std::uint64_t>( C, C + this->n ) );
+                    return this->_to_zvalue_( C, this->n, this->b, this->d, this->initial_M );
+                }
+
+                /**
+                 * @brief Converts a batch of `length` n-dimensional coordinates stored contiguously in C (i.e., C[i*n+j] is the j-th component of the i-th coordinate) into z-values.
+                 * @note It does not allocate memory; `Z` must have room for at least `length` z-values.
+                 * 
+                 * @tparam UINT_T 
+                 * @tparam ZV_T 
+                 * @param C The contiguous coordinates to convert.
+                 * @param length The number of coordinates in C.
+                 * @param Z The output z-values.
+                 */
+                template<typename UINT_T, typename ZV_T> void to_zvalues( const UINT_T* C, const std::size_t length, ZV_T* Z ) {
+                    for (std::size_t i = 0; i < length; ++i) {
+                        Z[i] = this->_to_zvalue_( C + ( i * this->n ), this->n, this->b, this->d, this->initial_M );
+                    }
                 }
 
                 /** 
@@ -524,7 +563,7 @@ namespace samg {
          * @param new_ext 
          * @return std::string 
          */
-        std::string append_info_and_extension(const std::string file_name, const std::string to_append, std::string new_ext) {
+        inline std::string append_info_and_extension(const std::string file_name, const std::string to_append, std::string new_ext) {
             std::size_t position = new_ext.find(".");
             if (position == std::string::npos) {
                 new_ext = "." + new_ext;
@@ -547,7 +586,7 @@ namespace samg {
          * @param new_ext 
          * @return std::string 
          */
-        std::string change_extension(const std::string file_name, std::string new_ext) {
+        inline std::string change_extension(const std::string file_name, std::string new_ext) {
             std::size_t position = new_ext.find(".");
             if (position == std::string::npos) {
                 new_ext = "." + new_ext;
@@ -568,7 +607,7 @@ namespace samg {
          * @param file_name 
          * @return std::string 
          */
-        std::string get_file_basename(const std::string file_name) {
+        inline std::string get_file_basename(const std::string file_name) {
             std::string new_file_name = file_name;
             std::size_t position = new_file_name.find_last_of(".");
             if (position != std::string::npos) {
@@ -586,7 +625,7 @@ namespace samg {
          * @param to_append 
          * @return std::string 
          */
-        std::string change_extension(const std::string file_name, std::string old_ext, std::string new_ext, const std::string to_append="") {
+        inline std::string change_extension(const std::string file_name, std::string old_ext, std::string new_ext, const std::string to_append="") {
             std::size_t position = old_ext.find(".");
             if (position == std::string::npos) {
                 old_ext = "." + old_ext;
@@ -777,6 +816,21 @@ namespace samg {
                     // std::cout << "OfflineWordWriter/add_values> (4)" << std::endl;
                 }
 
+                /**
+                 * @brief Writes `length` raw bytes with a single call. 
+                 * @note `length` should be a multiple of `sizeof(Type)` to keep the word counter exact.
+                 * 
+                 * @param v 
+                 * @param length 
+                 */
+                void add_bytes(const std::uint8_t *v, const std::size_t length) {
+                    if ( !this->file.is_open() ) {
+                        throw std::runtime_error("Failed to write to file!");
+                    }
+                    this->file.write(reinterpret_cast<const char*>(v), length);
+                    this->type_word_counter += length / sizeof(Type);
+                }
+
                 /**
                  * @brief Adds a collection of unsigned integer values. 
                  * 
@@ -940,6 +994,7 @@ namespace samg {
 
                 void seek( const std::streampos index, const std::ios_base::seekdir pos ) {
                     // if( index < this->serialization_length ) {
+                        this->file.clear(); // A short read at the end of the file sets failbit, which would make seekg a no-op.
                         this->file.seekg( index, pos );
                     // } else {
                     //     throw std::runtime_error("Index \""+std::to_string(index)+"\" is out of bounds!");
@@ -984,6 +1039,21 @@ namespace samg {
                     return OfflineWordReader<Type>::_read_<TypeTrg>( this->file, length );
                 }
 
+                /**
+                 * @brief Reads up to `length` raw bytes into `out` without allocating. 
+                 * 
+                 * @param out 
+                 * @param length 
+                 * @return std::size_t is the number of bytes actually read (less than `length` only at the end of the file).
+                 */
+                std::size_t read_bytes( std::uint8_t* out, const std::size_t length ) {
+                    if ( !this->file.is_open() ) {
+                        throw std::runtime_error("The file is closed!");
+                    }
+                    this->file.read( reinterpret_cast<char*>(out), length );
+                    return (std::size_t) this->file.gcount();
+                }
+
                 /**
                  * @brief Allows getting all the remaining values from the serialization. 
                  * 
@@ -1133,10 +1203,8 @@ namespace samg {
                     byte_map = (std::uint8_t*) std::malloc( this->serialization_length );
                     
                     // std::cout << "### file_name = " << file_name << " this->serialization_length = " << this->serialization_length << std::endl; 
-                    std::size_t i = 0;
-                    while( reader.has_more() ) {
-                        byte_map[ i++ ] = reader.next<std::uint8_t>();
-                        // std::cout << "### byte_map[ i : " << (i-1) << " ] = " << ((std::uint16_t)byte_map[ i-1 ]) << std::endl; 
+                    if( reader.read_bytes( byte_map, this->serialization_length ) != this->serialization_length ) {
+                        throw std::runtime_error("Failed to load file \""+file_name+"\"!");
                     }
                     reader.close();
 
@@ -1194,6 +1262,20 @@ namespace samg {
                     return V;
                 }
 
+                /**
+                 * @brief Copies up to `length` raw bytes into `out` without allocating. 
+                 * 
+                 * @param out 
+                 * @param length 
+                 * @return std::size_t is the number of bytes actually copied (less than `length` only at the end of the serialization).
+                 */
+                std::size_t read_bytes( std::uint8_t* out, const std::size_t length ) {
+                    const std::size_t n = std::min( length, this->serialization_length - std::min( this->index, this->serialization_length ) );
+                    std::memcpy( out, this->byte_map + this->index, n );
+                    this->index += n;
+                    return n;
+                }
+
                 /**
                  * @brief Allows getting all the remaining values from the serialization. 
                  * 
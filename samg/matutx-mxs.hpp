@@ -228,6 +228,39 @@ namespace samg {
                         return c;
                     }
 
+                    /**
+                     * @brief Decodes the coordinate following the current one into `Pi`.
+                     */
+                    void _advance_( ) {
+                        this->I[ this->Ii[ this->j ] ]--;
+
+                        if( this->I[ this->Ii[ this->j ] ] > 0ZU ){
+                            this->Pi[ this->j ] = this->serializer->next<std::uint64_t>();
+                        } else {
+                            // Checking backward:
+                            while( this->I[ this->Ii[ this->j ] ] == 0ZU ){
+                                this->j--;
+                                this->I[ this->Ii[ this->j ] ]--;
+                                if( this->j == 0 && this->I[ this->Ii[ this->j ] ] == 0ZU ){
+                                    this->current_entry++;
+                                    return;// Decoding completed!
+                                }
+                            }
+                            
+                            // Checking forward:
+                            while( this->j < this->maxs.size() ) {
+                                this->Pi[ this->j++ ] = this->serializer->next<std::uint64_t>();
+                                // this->j++;
+                                if( this->j < this->maxs.size() ) {
+                                    this->Ii[ this->j ] = this->ip;
+                                    this->ip++;
+                                }
+                            }
+                            this->j--;
+                        }
+                        this->current_entry++;
+                    }
+
                 public:
                     MXSReader(const std::string input_file_name, const std::size_t k = 2UL):
                         Reader(input_file_name),
@@ -326,45 +359,58 @@ namespace samg {
                             throw std::runtime_error("No more entries!");
                         }
                         std::vector<std::uint64_t> C = this->_gen_coord_( this->Pi );
-                        this->I[ this->Ii[ this->j ] ]--;
+                        this->_advance_( );
+                        return C;
+                    }
 
-                        if( this->I[ this->Ii[ this->j ] ] > 0ZU ){
-                            this->Pi[ this->j ] = this->serializer->next<std::uint64_t>();
-                        } else {
-                            // Checking backward:
-                            while( this->I[ this->Ii[ this->j ] ] == 0ZU ){
-                                this->j--;
-                                this->I[ this->Ii[ this->j ] ]--;
-                                if( this->j == 0 && this->I[ this->Ii[ this->j ] ] == 0ZU ){
-                                    this->current_entry++;
-                                    return C;// Decoding completed!
-                                }
-                            }
-                            
-                            // Checking forward:
-                            while( this->j < this->maxs.size() ) {
-                                this->Pi[ this->j++ ] = this->serializer->next<std::uint64_t>();
-                                // this->j++;
-                                if( this->j < this->maxs.size() ) {
-                                    this->Ii[ this->j ] = this->ip;
-                                    this->ip++;
-                                }
-                            }
-                            this->j--;
+                    /**
+                     * @brief Returns the current coordinate without copying it. It is valid while `has_next()` is true and until the next call to `advance()`/`next()`.
+                     */
+                    const std::uint64_t* current() const {
+                        return this->Pi.data();
+                    }
+
+                    /**
+                     * @brief Moves the cursor to the next coordinate.
+                     * 
+                     * @return true if `current()` holds a valid coordinate afterwards.
+                     */
+                    bool advance() {
+                        if( !this->has_next() ){
+                            throw std::runtime_error("No more entries!");
+                        }
+                        this->_advance_( );
+                        return this->has_next();
+                    }
+
+                    /**
+                     * @brief Visits every remaining coordinate as f(const std::uint64_t* coord) without allocating memory.
+                     */
+                    template<typename F> void for_each( F&& f ) {
+                        while( this->has_next() ) {
+                            f( static_cast<const std::uint64_t*>( this->Pi.data() ) );
+                            this->_advance_( );
                         }
-                        this->current_entry++;
-                        return C;
                     }
 
                     const std::uint64_t next_zvalue() override {
                         // return samg::utils::to_zvalue3( this->next(), this->n, this->b, this->digits, this->bd, this->initial_M );
-                        return this->z_converter.to_zvalue( this->next() );
+                        if( !this->has_next() ){
+                            throw std::runtime_error("No more entries!");
+                        }
+                        std::uint64_t zvalue;
+                        this->z_converter.to_zvalues( this->Pi.data(), 1ZU, &zvalue );
+                        this->_advance_( );
+                        return zvalue;
                     }
                     const std::vector<std::uint64_t> get_zvalues() override {
                         std::vector<std::uint64_t> ans;
-                        while( this->has_next() ) {
-                            ans.push_back( this->next_zvalue() );
-                        }
+                        ans.reserve( this->e - this->current_entry );
+                        this->for_each( [this, &ans]( const std::uint64_t* C ) {
+                            std::uint64_t zvalue;
+                            this->z_converter.to_zvalues( C, 1ZU, &zvalue );
+                            ans.push_back( zvalue );
+                        } );
                         return ans;
                     }
             };
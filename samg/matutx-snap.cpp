@@ -1,7 +1,7 @@
 /**
  * @file matutx-snap.cpp
  * @author Sebastián AMG (@sebastianamg)
- * @brief Static library implemented using C++-98 standard that allows to read data from Snap format.  
+ * @brief Static library that allows to read data from Snap format through the `samg::matutx::reader::Reader` interface.  
  * @version 0.1
  * @date 2024-06-26
  * @note This code uses [link https://github.com/snap-stanford/snap snap]
@@ -38,101 +38,142 @@
 // #include <samg/matutx-snap.hpp>
 #include "matutx-snap.hpp"
 #include <samg/commons.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
 
 namespace samg {
     namespace matutx {
         namespace reader {
 
-            // void SnapReader::_update( ) {
-
-            // }
-
-            SnapReader::SnapReader( const char *file_name, const unsigned int src_col_id, const unsigned int dst_col_id, const unsigned int k=2ULL ) :
-                FILE_NAME ( TStr(file_name) ),
-                graph ( TSnap::LoadEdgeList<PNGraph>(file_name, src_col_id, dst_col_id) ) {
-                    this->graph->GetNIdV(this->v);
-                    this->v.Sort();
-                    this->nid = 0ULL;
-                    this->ntrg = 0ULL;
-                    this->NI = this->graph->GetNI((int)this->v[this->nid]);
-                    this->NI.SortNIdV();
-                    // this->b = samg::utils::get_required_bits( k );//(k == 1UL ? 0UL : std::bit_width(k - 1UL)), // Number of bits per coordinate component considered for Z-ordering.
-                    // this->d = samg::utils::get_required_digits( static_cast<std::size_t>(this->get_matrix_side_size()), this->b );//(s == 0) ? 0 : static_cast<std::size_t>(std::ceil(std::log2(s) / static_cast<double>(b))), // Number of digits to encode a component considered for Z-ordering.
-                    // this->n = this->get_number_of_dimensions(); // Number of dimensions of the matrix.
-                    // this->initial_M = samg::utils::get_initial_mask( b );
-                    // this->bd = this->b * this->d;
+            void SnapReader::_set_node_( ) {
+                this->NI = this->graph->GetNI( (int) this->v[ this->nid ] );
+                this->src = (std::uint64_t) this->v[ this->nid ];
+                this->out_deg = (std::uint64_t) this->NI.GetOutDeg();
+                this->ntrg = 0ULL;
+            }
+
+            void SnapReader::_load_edge_list_( const std::string& file_name ) {
+                std::size_t file_size = samg::utils::get_file_size( file_name );
+                if( file_size % ( 2ZU * sizeof(std::uint64_t) ) != 0ZU ) {
+                    throw std::runtime_error("SnapReader/_load_edge_list_> Malformed binary edge list \""+file_name+"\"!");
+                }
+                this->edges.resize( file_size / sizeof(std::uint64_t) );
+                std::FILE* fp = std::fopen( file_name.c_str(), "rb" );
+                if( fp == nullptr ) {
+                    throw std::runtime_error("SnapReader/_load_edge_list_> Unable to open \""+file_name+"\"!");
+                }
+                std::size_t read = std::fread( this->edges.data(), sizeof(std::uint64_t), this->edges.size(), fp );
+                std::fclose( fp );
+                if( read != this->edges.size() ) {
+                    throw std::runtime_error("SnapReader/_load_edge_list_> Unable to read \""+file_name+"\"!");
+                }
+                this->max_node_id = 0ULL;
+                for( std::size_t i = 0ZU; i < this->edges.size(); i += 2ZU ) {
+                    if( i > 0ZU && ( this->edges[ i ] < this->edges[ i - 2ZU ] || ( this->edges[ i ] == this->edges[ i - 2ZU ] && this->edges[ i + 1ZU ] < this->edges[ i - 1ZU ] ) ) ) {
+                        throw std::runtime_error("SnapReader/_load_edge_list_> Binary edge list \""+file_name+"\" is not sorted!");
+                    }
+                    this->max_node_id = std::max( this->max_node_id, std::max( this->edges[ i ], this->edges[ i + 1ZU ] ) );
+                }
+                this->number_of_entries = this->edges.size() / 2ZU;
+            }
+
+            SnapReader::SnapReader( const std::string file_name, const int src_col_id, const int dst_col_id, const std::size_t k ) :
+                Reader( file_name ),
+                nid( 0ULL ),
+                ntrg( 0ULL ),
+                src( 0ULL ),
+                out_deg( 0ULL ),
+                edges_index( 0ZU ),
+                from_edge_list( file_name.ends_with(".bel") ),
+                max_node_id( 0ULL ),
+                number_of_entries( 0ULL ) {
+                    if( this->from_edge_list ) {
+                        this->_load_edge_list_( file_name );
+                    } else {
+                        if( file_name.ends_with(".snap") ) {
+                            TFIn in( TStr( file_name.c_str() ) );
+                            this->graph = TNGraph::Load( in );
+                        } else {
+                            this->graph = TSnap::LoadEdgeList<PNGraph>( TStr( file_name.c_str() ), src_col_id, dst_col_id );
+                        }
+                        // NOTE: Adjacency lists are sorted once here rather than every time the traversal moves to a new node.
+                        this->graph->SortNodeAdjV();
+                        this->graph->GetNIdV(this->v);
+                        this->v.Sort();
+                        this->number_of_entries = this->graph->GetEdges();
+                        if( this->v.Len() > 0 ) {
+                            this->max_node_id = (std::uint64_t) this->v[ this->v.Len()-1 ];
+                            this->_set_node_( );
+                        }
+                    }
                     this->z_converter = samg::utils::ZValueConverter( this->get_matrix_side_size(), this->get_number_of_dimensions(), k );
                 }
 
             SnapReader::~SnapReader() {
             }
 
-            const char* SnapReader::get_input_file_name() {
-                return this->FILE_NAME.CStr();
-            }
-
-            const unsigned long long int SnapReader::get_number_of_dimensions() {
-                return 2ULL;
+            const std::size_t SnapReader::get_number_of_dimensions() const {
+                return 2ZU;
             }
 
-            unsigned long long int* SnapReader::get_max_per_dimension() {
-                static unsigned long long int maxd[2];
-                maxd[ 0 ] = maxd[ 1 ] = this->v[ this->v.Len()-1 ];
-                return maxd;
+            const std::vector<std::uint64_t> SnapReader::get_max_per_dimension() const {
+                return { this->max_node_id, this->max_node_id };
             }
 
-            const unsigned long long int SnapReader::get_number_of_entries() {
-                return this->graph->GetEdges();
+            const std::uint64_t SnapReader::get_number_of_entries() const {
+                return this->number_of_entries;
             }
 
-            const unsigned long long int SnapReader::get_matrix_side_size() {
-                return this->v[ this->v.Len()-1 ];
+            const std::uint64_t SnapReader::get_matrix_side_size() const {
+                return this->max_node_id;
             }
 
-            const unsigned long long int SnapReader::get_matrix_size() {
-                return ( (unsigned long long int) this->v[ this->v.Len()-1 ] ) * ( (unsigned long long int) this->v[ this->v.Len()-1 ] );
+            const std::uint64_t SnapReader::get_matrix_size() const {
+                return this->max_node_id * this->max_node_id;
             }
 
-            const float SnapReader::get_matrix_expected_density() {
-                return ( (float) this->graph->GetEdges() ) / ( (float) this->get_matrix_size() );
+            const std::float_t SnapReader::get_matrix_expected_density() const {
+                return ( (std::float_t) this->number_of_entries ) / ( (std::float_t) this->get_matrix_size() );
             }
 
-            const float SnapReader::get_matrix_actual_density() {
+            const std::float_t SnapReader::get_matrix_actual_density() const {
                 return this->get_matrix_expected_density();
             }
             
-            const char* SnapReader::get_matrix_distribution() {
+            const std::string SnapReader::get_matrix_distribution() const {
                 return "unknown";
             }
 
-            const float SnapReader::get_gauss_mu() {
+            const std::float_t SnapReader::get_gauss_mu() const {
                 return 0.0F;
             }
 
-            const float SnapReader::get_gauss_sigma() {
+            const std::float_t SnapReader::get_gauss_sigma() const {
                 return 0.0F;
             }
 
-            const unsigned long long int SnapReader::get_clustering() {
+            const std::uint64_t SnapReader::get_clustering() const {
                 return 0ULL;
             }
 
-            const float SnapReader::get_clustering_distance_error() {
+            const std::float_t SnapReader::get_clustering_distance_error() const {
                 return 0.0F;
             }
 
             const bool SnapReader::has_next() {
+                if( this->from_edge_list ) {
+                    return this->edges_index < this->edges.size();
+                }
+
                 if( ( (int) this->nid ) >= this->v.Len() ) {
                     return false;
                 }
 
-                while( this->NI.GetOutDeg() == 0 || ( ( (int) this->ntrg ) >= this->NI.GetOutDeg() ) ) {
+                while( this->ntrg >= this->out_deg ) {
                     this->nid++;
-                    if( ( (int) this->nid ) < v.Len() ) {
-                        this->NI = this->graph->GetNI( (int)this->v[ this->nid ] );
-                        this->NI.SortNIdV( );
-                        this->ntrg = 0ULL;
-                        // break;
+                    if( ( (int) this->nid ) < this->v.Len() ) {
+                        this->_set_node_( );
                     } else {
                         return false;
                     }
@@ -141,30 +182,119 @@ namespace samg {
                 return  true;
             }
 
-            const unsigned long long int* SnapReader::next() {
-                if( this->has_next() ) {
-                    // if( ( (int) this->ntrg ) < this->NI.GetOutDeg() ) {
-                    unsigned long long int* edge = new unsigned long long int[ 2 ];
-                    // NOTE: Perhaps, encoding must be the opposite; this->[this->nid] must be at 1, and this->NI.GetOutNId( this->ntrg ) at 0.
-                    edge[ 0 ] = (unsigned long long int) this->v[ this->nid ];
-                    edge[ 1 ] = this->NI.GetOutNId( this->ntrg );
-                    this->ntrg++;
-                    return edge;
+            const std::vector<std::uint64_t> SnapReader::next() {
+                std::uint64_t edge[ 2 ];
+                if( this->next_edges( edge, 1ULL ) == 0ULL ) {
+                    throw std::runtime_error("SnapReader/next> No more entries!");
+                }
+                // NOTE: Perhaps, encoding must be the opposite; this->[this->nid] must be at 1, and this->NI.GetOutNId( this->ntrg ) at 0.
+                return { edge[ 0 ], edge[ 1 ] };
+            }
+
+            const std::uint64_t SnapReader::next_edges( std::uint64_t* edges, const std::uint64_t max_edges ) {
+                if( this->from_edge_list ) {
+                    std::uint64_t m = std::min<std::uint64_t>( max_edges, ( this->edges.size() - this->edges_index ) / 2ZU );
+                    std::copy_n( this->edges.data() + this->edges_index, 2ULL * m, edges );
+                    this->edges_index += 2ULL * m;
+                    return m;
+                }
+                std::uint64_t l = 0ULL;
+                while( l < max_edges && this->has_next() ) {
+                    // Drain the current node's adjacency list without re-checking the traversal state per edge.
+                    std::uint64_t m = std::min( this->out_deg - this->ntrg, max_edges - l );
+                    for( std::uint64_t i = 0ULL; i < m; ++i, ++l ) {
+                        edges[ 2ULL * l ] = this->src;
+                        edges[ 2ULL * l + 1ULL ] = this->NI.GetOutNId( (int) ( this->ntrg + i ) );
+                    }
+                    this->ntrg += m;
                 }
-                throw 123; // NOTE No more entries!
+                return l;
             }
 
-            const unsigned long long int SnapReader::next_zvalue() {
-                // unsigned long long int* edge = this->next( );
-                return this->z_converter.to_zvalue( this->next( ) );
+            const std::uint64_t SnapReader::next_zvalue() {
+                std::uint64_t edge[ 2 ];
+                if( this->next_edges( edge, 1ULL ) == 0ULL ) {
+                    throw std::runtime_error("SnapReader/next_zvalue> No more entries!");
+                }
+                std::uint64_t zvalue;
+                this->z_converter.to_zvalues( edge, 1ZU, &zvalue );
+                return zvalue;
+            }
+
+            const std::uint64_t SnapReader::next_zvalues( std::uint64_t* zvalues, const std::uint64_t max_values ) {
+                if( this->from_edge_list ) {
+                    // Pairs are already contiguous; convert them in place without staging.
+                    std::uint64_t m = std::min<std::uint64_t>( max_values, ( this->edges.size() - this->edges_index ) / 2ZU );
+                    this->z_converter.to_zvalues( this->edges.data() + this->edges_index, m, zvalues );
+                    this->edges_index += 2ULL * m;
+                    return m;
+                }
+                std::uint64_t edges[ 2ULL * BATCH_SIZE ];
+                std::uint64_t l = 0ULL, m;
+                while( l < max_values ) {
+                    m = this->next_edges( edges, std::min( max_values - l, BATCH_SIZE ) );
+                    if( m == 0ULL ) {
+                        break;
+                    }
+                    this->z_converter.to_zvalues( edges, m, zvalues + l );
+                    l += m;
+                }
+                return l;
             }
 
-            const unsigned long long int* SnapReader::get_zvalues() {
-                std::vector<unsigned long long int> zvalues;
-                while (this->has_next()) {
-                    zvalues.push_back(this->next_zvalue());
+            const std::vector<std::uint64_t> SnapReader::get_zvalues() {
+                std::vector<std::uint64_t> zvalues;
+                zvalues.reserve( this->get_number_of_entries() );
+                std::uint64_t l = 0ULL;
+                do {
+                    zvalues.resize( l + BATCH_SIZE );
+                    l += this->next_zvalues( zvalues.data() + l, BATCH_SIZE );
+                } while( l == zvalues.size() );
+                zvalues.resize( l );
+                return zvalues;
+            }
+
+            void SnapReader::save( const std::string& file_name ) const {
+                if( file_name.ends_with(".snap") ) {
+                    if( this->from_edge_list ) {
+                        throw std::runtime_error("SnapReader/save> A binary edge list cannot be saved in SNAP binary graph format!");
+                    }
+                    TFOut out( TStr( file_name.c_str() ) );
+                    this->graph->Save( out );
+                    return;
+                }
+                std::FILE* fp = std::fopen( file_name.c_str(), "wb" );
+                if( fp == nullptr ) {
+                    throw std::runtime_error("SnapReader/save> Unable to open \""+file_name+"\"!");
+                }
+                // A short write (e.g., a full disk) would otherwise leave a truncated edge list behind:
+                auto write = [&]( const std::uint64_t* data, const std::size_t n ) {
+                    if( std::fwrite( data, sizeof(std::uint64_t), n, fp ) != n ) {
+                        std::fclose( fp );
+                        throw std::runtime_error("SnapReader/save> Unable to write \""+file_name+"\"!");
+                    }
+                };
+                if( this->from_edge_list ) {
+                    write( this->edges.data(), this->edges.size() );
+                } else {
+                    std::vector<std::uint64_t> buffer;
+                    buffer.reserve( 2ULL * BATCH_SIZE );
+                    for( int i = 0; i < this->v.Len(); ++i ) {
+                        TNGraph::TNodeI N = this->graph->GetNI( (int) this->v[ i ] );
+                        for( int j = 0; j < N.GetOutDeg(); ++j ) {
+                            buffer.push_back( (std::uint64_t) this->v[ i ] );
+                            buffer.push_back( (std::uint64_t) N.GetOutNId( j ) );
+                            if( buffer.size() == buffer.capacity() ) {
+                                write( buffer.data(), buffer.size() );
+                                buffer.clear();
+                            }
+                        }
+                    }
+                    write( buffer.data(), buffer.size() );
+                }
+                if( std::fclose( fp ) != 0 ) {
+                    throw std::runtime_error("SnapReader/save> Unable to close \""+file_name+"\"!");
                 }
-                return zvalues.data();
             }
         }
     }
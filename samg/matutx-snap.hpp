@@ -1,13 +1,13 @@
 /**
  * @file matutx-snap.cpp
  * @author Sebastián AMG (@sebastianamg)
- * @brief Static library implemented using C++-98 standard that allows to read data from Snap format.  
+ * @brief Static library that allows to read data from Snap format through the `samg::matutx::reader::Reader` interface.  
  * @version 0.1
  * @date 2024-06-26
  * @note This code uses [link https://github.com/snap-stanford/snap snap]
- * @note compilation to generate the static library for debugging: g++-13 -std=c++98 -ggdb -g -O0 -Wall -DNDEBUG -fopenmp -I ~/include/Snap-6.0/snap-core/ -I ~/include/Snap-
+ * @note compilation to generate the static library for debugging: g++-13 -std=c++2b -ggdb -g -O0 -Wall -DNDEBUG -fopenmp -I ~/include/Snap-6.0/snap-core/ -I ~/include/Snap-
 6.0/glib-core/ -I ~/include/samg/ -c ./samg/matutx-snap.cpp -o ./samg/matutx-snap.o -lsnap -lrt && ar rcs samg/libmatutx-snap.a samg/matutx-snap.o
- * @note compilation to generate the static library for production: g++-13 -std=c++98 -O3 -DNDEBUG -fopenmp -I ~/include/Snap-6.0/snap-core/ -I ~/include/Snap-
+ * @note compilation to generate the static library for production: g++-13 -std=c++2b -O3 -DNDEBUG -fopenmp -I ~/include/Snap-6.0/snap-core/ -I ~/include/Snap-
 6.0/glib-core/ -I ~/include/samg/ -c ./samg/matutx-snap.cpp -o ./samg/matutx-snap.o -lsnap -lrt && ar rcs samg/libmatutx-snap.a samg/matutx-snap.o
  * 
  * @copyright (c) 2024 Sebastián AMG (@sebastianamg)
@@ -43,47 +43,80 @@
 #define MATUTX_SNAP_H
 
 #include <Snap.h>
+#include <samg/commons.hpp>
+#include <samg/mmm-interface.hpp>
 
 namespace samg {
     namespace matutx {
         namespace reader {
-            class SnapReader {
+            /**
+             * @brief Reader of directed graphs supported by SNAP. The input format is selected by the file extension:
+             *  - `.snap`: SNAP binary graph format, i.e., a `TNGraph` saved with `TNGraph::Save( TFOut& )`.
+             *  - `.bel`: binary edge list, i.e., a sequence of (src,dst) pairs of `std::uint64_t` sorted lexicographically.
+             *  - any other extension: plain-text edge list parsed with `TSnap::LoadEdgeList`.
+             * 
+             * @note Binary formats skip text parsing; use `save(...)` to convert a plain-text edge list once.
+             */
+            class SnapReader : public Reader {
                 private:
-                    const TStr FILE_NAME;
                     PNGraph graph;
                     TIntV v;
-                    unsigned long long int nid, ntrg;
+                    std::uint64_t nid, ntrg;
                     TNGraph::TNodeI NI;
-                    // void _update_( );
-                    // unsigned long long int n;
-                    // unsigned long long int b;
-                    // unsigned long long int d;
-                    // unsigned long long int initial_M;
-                    // unsigned long long int bd;
+                    std::uint64_t src, out_deg; // Cached source identifier and out-degree of the current node.
+                    std::vector<std::uint64_t> edges; // (src,dst) pairs when loading from a binary edge list.
+                    std::size_t edges_index;
+                    bool from_edge_list;
+                    std::uint64_t max_node_id, number_of_entries;
                     samg::utils::ZValueConverter z_converter;
 
+                    void _set_node_( );
+                    void _load_edge_list_( const std::string& file_name );
+
                 public:
-                    SnapReader( const char *file_name, const unsigned int src_col_id = 0U, const unsigned int dst_col_id = 1U, const unsigned int k=2ULL  );
-                    const char* get_input_file_name();
-                    const unsigned long long int get_number_of_dimensions();
-                    unsigned long long int* get_max_per_dimension();
-                    const unsigned long long int get_number_of_entries();
-                    const unsigned long long int get_matrix_side_size();
-                    const unsigned long long int get_matrix_size();
-                    const float get_matrix_expected_density();
-                    const float get_matrix_actual_density();
-                    const char* get_matrix_distribution();
-                    const float get_gauss_mu();
-                    const float get_gauss_sigma();
-                    const unsigned long long int get_clustering();
-                    const float get_clustering_distance_error();
-                    const bool has_next();
-                    const unsigned long long int* next();
-                    const unsigned long long int next_zvalue();
-                    const unsigned long long int* get_zvalues();
+                    static constexpr std::uint64_t BATCH_SIZE = 4096ULL; // Number of edges processed per batch by get_zvalues().
+
+                    SnapReader( const std::string file_name, const int src_col_id = 0, const int dst_col_id = 1, const std::size_t k = 2ZU );
+                    ~SnapReader();
+                    const std::size_t get_number_of_dimensions() const override;
+                    const std::vector<std::uint64_t> get_max_per_dimension() const override;
+                    const std::uint64_t get_number_of_entries() const override;
+                    const std::uint64_t get_matrix_side_size() const override;
+                    const std::uint64_t get_matrix_size() const override;
+                    const std::float_t get_matrix_expected_density() const override;
+                    const std::float_t get_matrix_actual_density() const override;
+                    const std::string get_matrix_distribution() const override;
+                    const std::float_t get_gauss_mu() const override;
+                    const std::float_t get_gauss_sigma() const override;
+                    const std::uint64_t get_clustering() const override;
+                    const std::float_t get_clustering_distance_error() const override;
+                    const bool has_next() override;
+                    const std::vector<std::uint64_t> next() override;
+                    /**
+                     * @brief Copies up to `max_edges` edges into `edges` as consecutive (src,dst) pairs; `edges` must have room for 2*max_edges values.
+                     * 
+                     * @return The number of edges written; 0 means there are no more edges.
+                     */
+                    const std::uint64_t next_edges( std::uint64_t* edges, const std::uint64_t max_edges );
+                    const std::uint64_t next_zvalue() override;
+                    /**
+                     * @brief Writes up to `max_values` z-values of the next edges into `zvalues`.
+                     * 
+                     * @return The number of z-values written; 0 means there are no more edges.
+                     */
+                    const std::uint64_t next_zvalues( std::uint64_t* zvalues, const std::uint64_t max_values );
+                    /**
+                     * @brief Computes the z-values of all remaining edges.
+                     */
+                    const std::vector<std::uint64_t> get_zvalues() override;
+                    /**
+                     * @brief Saves the whole graph either in SNAP binary graph format (`.snap`) or as a binary edge list (any other extension, `.bel` recommended).
+                     * @note It does not alter the traversal state of the reader.
+                     */
+                    void save( const std::string& file_name ) const;
             };
         }
     }
 }
 
-#endif
\ No newline at end of file
+#endif
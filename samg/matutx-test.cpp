@@ -0,0 +1,827 @@
+#include <gtest/gtest.h>
+#define MATUTX_WITH_SNAP
+#include <samg/matutx.hpp>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <set>
+
+// To compile: g++-13 -std=c++2b -ggdb -g3 -fopenmp -I ~/include/Snap-6.0/snap-core/ -I ~/include/Snap-6.0/glib-core/ -I ~/include/ -I .. -L ~/lib/ -L . matutx-test.cpp -o matutx-test -lmatutx-snap -lsnap -lgtest -pthread -lrt
+namespace matutx {
+    namespace test {
+
+        using Coordinates = std::vector<std::vector<std::uint64_t>>;
+
+        static std::string temp_file( const std::string name ) {
+            return ( std::filesystem::temp_directory_path() / ( "matutx-test-" + name ) ).string();
+        }
+
+        /**
+         * @brief Generates `count` random coordinates of `n` components in [0,max), sorted lexicographically and without duplicates.
+         */
+        static Coordinates random_coordinates( const std::size_t n, const std::uint64_t max, const std::size_t count, const std::uint64_t seed ) {
+            std::mt19937_64 gen( seed );
+            std::set<std::vector<std::uint64_t>> coordinates;
+            for( std::size_t i = 0ZU; i < count; ++i ) {
+                std::vector<std::uint64_t> c( n );
+                for( auto& x : c ) {
+                    x = gen() % max;
+                }
+                coordinates.insert( c );
+            }
+            return Coordinates( coordinates.begin(), coordinates.end() );
+        }
+
+        static void write_edge_list( const std::string file_name, const Coordinates& edges ) {
+            std::ofstream out( file_name );
+            out << "# Directed graph" << std::endl;
+            for( const auto& e : edges ) {
+                out << e[ 0 ] << "\t" << e[ 1 ] << std::endl;
+            }
+        }
+
+        static Coordinates read_edges( samg::matutx::reader::Reader& reader ) {
+            Coordinates edges;
+            while( reader.has_next() ) {
+                edges.push_back( reader.next() );
+            }
+            return edges;
+        }
+
+        static std::vector<std::uint64_t> read_zvalues( samg::matutx::reader::Reader& reader ) {
+            std::vector<std::uint64_t> zvalues;
+            while( reader.has_next() ) {
+                zvalues.push_back( reader.next_zvalue() );
+            }
+            return zvalues;
+        }
+
+        static Coordinates read_csmr( samg::matutx::streamer::CSMR& csmr ) {
+            Coordinates coordinates;
+            while( csmr.has_next() ) {
+                coordinates.push_back( csmr.next() );
+            }
+            return coordinates;
+        }
+
+        /**
+         * @brief Mixes stored coordinates, coordinates differing in one component and components beyond the largest stored value.
+         */
+        static Coordinates random_queries( const Coordinates& coordinates, const std::size_t n, const std::uint64_t max, const std::size_t count, const std::uint64_t seed ) {
+            std::mt19937_64 gen( seed );
+            Coordinates queries;
+            for( std::size_t i = 0ZU; i < count; ++i ) {
+                std::vector<std::uint64_t> q( n );
+                if( !coordinates.empty() && i % 3ZU != 2ZU ) {
+                    q = coordinates[ gen() % coordinates.size() ];
+                    if( i % 3ZU == 1ZU ) {
+                        q[ gen() % n ] += 1ULL;
+                    }
+                } else {
+                    for( auto& x : q ) {
+                        x = gen() % ( max + 2ULL );
+                    }
+                    if( i % 7ZU == 0ZU ) {
+                        q[ gen() % n ] = ~0ULL;
+                    }
+                }
+                queries.push_back( q );
+            }
+            return queries;
+        }
+
+        /**
+         * @brief Reader that delivers a given list of coordinates in the given order.
+         */
+        class CoordinatesReader : public samg::matutx::reader::Reader {
+            private:
+                const Coordinates coordinates;
+                const std::size_t n;
+                std::size_t i;
+
+            public:
+                CoordinatesReader( const Coordinates coordinates, const std::size_t n ) : Reader( "" ), coordinates( coordinates ), n( n ), i( 0ZU ) {}
+                const std::size_t get_number_of_dimensions() const override { return this->n; }
+                const std::vector<std::uint64_t> get_max_per_dimension() const override { return {}; }
+                const std::uint64_t get_number_of_entries() const override { return this->coordinates.size(); }
+                const std::uint64_t get_matrix_side_size() const override { return 0ULL; }
+                const std::uint64_t get_matrix_size() const override { return 0ULL; }
+                const std::float_t get_matrix_expected_density() const override { return 0.0F; }
+                const std::float_t get_matrix_actual_density() const override { return 0.0F; }
+                const std::string get_matrix_distribution() const override { return "unknown"; }
+                const std::float_t get_gauss_mu() const override { return 0.0F; }
+                const std::float_t get_gauss_sigma() const override { return 0.0F; }
+                const std::uint64_t get_clustering() const override { return 0ULL; }
+                const std::float_t get_clustering_distance_error() const override { return 0.0F; }
+                const bool has_next() override { return this->i < this->coordinates.size(); }
+                const std::vector<std::uint64_t> next() override { return this->coordinates[ this->i++ ]; }
+                const std::uint64_t next_zvalue() override { throw std::runtime_error("CoordinatesReader/next_zvalue> Not supported!"); }
+                const std::vector<std::uint64_t> get_zvalues() override { throw std::runtime_error("CoordinatesReader/get_zvalues> Not supported!"); }
+        };
+
+        static std::vector<std::uint64_t> flatten( const Coordinates& coordinates ) {
+            std::vector<std::uint64_t> flat;
+            for( const auto& c : coordinates ) {
+                flat.insert( flat.end(), c.begin(), c.end() );
+            }
+            return flat;
+        }
+
+        TEST( SnapReader, BatchedEdgesMatchNext ) {
+            using samg::matutx::reader::SnapReader;
+            const std::string file_name = temp_file( "graph.txt" );
+            const Coordinates edges = random_coordinates( 2ZU, 500ULL, 3000ZU, 1ULL );
+            write_edge_list( file_name, edges );
+            {
+                SnapReader reader( file_name );
+                EXPECT_EQ( reader.get_number_of_entries(), edges.size() );
+                EXPECT_EQ( read_edges( reader ), edges );
+                EXPECT_THROW( reader.next(), std::runtime_error );
+            }
+            for( const std::uint64_t batch : { 1ULL, 7ULL, 4096ULL, 5000ULL } ) {
+                SnapReader reader( file_name );
+                std::vector<std::uint64_t> buffer( 2ULL * batch );
+                Coordinates batched;
+                std::uint64_t m;
+                while( ( m = reader.next_edges( buffer.data(), batch ) ) > 0ULL ) {
+                    for( std::uint64_t i = 0ULL; i < m; ++i ) {
+                        batched.push_back( { buffer[ 2ULL * i ], buffer[ 2ULL * i + 1ULL ] } );
+                    }
+                }
+                EXPECT_EQ( batched, edges ) << "batch=" << batch;
+                EXPECT_FALSE( reader.has_next() );
+            }
+            std::filesystem::remove( file_name );
+        }
+
+        TEST( SnapReader, BatchedZValuesMatchNextZValue ) {
+            using samg::matutx::reader::SnapReader;
+            const std::string file_name = temp_file( "graph.txt" );
+            write_edge_list( file_name, random_coordinates( 2ZU, 1000ULL, 10000ZU, 2ULL ) );
+            SnapReader baseline( file_name );
+            const std::vector<std::uint64_t> expected = read_zvalues( baseline );
+            EXPECT_THROW( baseline.next_zvalue(), std::runtime_error );
+            {
+                SnapReader reader( file_name );
+                EXPECT_EQ( reader.get_zvalues(), expected );
+                EXPECT_TRUE( reader.get_zvalues().empty() );
+            }
+            for( const std::uint64_t batch : { 1ULL, 13ULL, 4096ULL, 4097ULL } ) {
+                SnapReader reader( file_name );
+                std::vector<std::uint64_t> zvalues( expected.size() + batch );
+                std::uint64_t l = 0ULL, m;
+                while( ( m = reader.next_zvalues( zvalues.data() + l, batch ) ) > 0ULL ) {
+                    l += m;
+                }
+                zvalues.resize( l );
+                EXPECT_EQ( zvalues, expected ) << "batch=" << batch;
+            }
+            {
+                // Mixing single and batched calls keeps the traversal consistent.
+                SnapReader reader( file_name );
+                std::vector<std::uint64_t> zvalues, buffer( 100ZU );
+                while( reader.has_next() ) {
+                    zvalues.push_back( reader.next_zvalue() );
+                    const std::uint64_t m = reader.next_zvalues( buffer.data(), 100ULL );
+                    zvalues.insert( zvalues.end(), buffer.begin(), buffer.begin() + m );
+                }
+                EXPECT_EQ( zvalues, expected );
+            }
+            std::filesystem::remove( file_name );
+        }
+
+        TEST( SnapReader, SavedFormatsRoundTrip ) {
+            using samg::matutx::reader::SnapReader;
+            const std::string text_file = temp_file( "graph.txt" ),
+                              bel_file = temp_file( "graph.bel" ),
+                              snap_file = temp_file( "graph.snap" );
+            const Coordinates edges = random_coordinates( 2ZU, 700ULL, 5000ZU, 3ULL );
+            write_edge_list( text_file, edges );
+            SnapReader text( text_file );
+            const std::vector<std::uint64_t> zvalues = SnapReader( text_file ).get_zvalues();
+            // Saving halfway through must not alter the traversal state.
+            Coordinates traversed;
+            for( std::size_t i = 0ZU; i < edges.size() / 2ZU; ++i ) {
+                traversed.push_back( text.next() );
+            }
+            text.save( bel_file );
+            text.save( snap_file );
+            while( text.has_next() ) {
+                traversed.push_back( text.next() );
+            }
+            EXPECT_EQ( traversed, edges );
+
+            for( const std::string& file_name : { bel_file, snap_file } ) {
+                SnapReader reader( file_name );
+                EXPECT_EQ( reader.get_number_of_entries(), edges.size() ) << file_name;
+                EXPECT_EQ( reader.get_max_per_dimension(), text.get_max_per_dimension() ) << file_name;
+                EXPECT_EQ( read_edges( reader ), edges ) << file_name;
+                EXPECT_EQ( SnapReader( file_name ).get_zvalues(), zvalues ) << file_name;
+                SnapReader single( file_name );
+                EXPECT_EQ( read_zvalues( single ), zvalues ) << file_name;
+            }
+
+            // A binary edge list saves to an identical binary edge list, but not to the SNAP format.
+            const std::string copy_file = temp_file( "copy.bel" );
+            SnapReader bel( bel_file );
+            bel.save( copy_file );
+            EXPECT_EQ( samg::utils::get_file_size( copy_file ), edges.size() * 2ZU * sizeof( std::uint64_t ) );
+            EXPECT_EQ( read_edges( bel ), edges );
+            EXPECT_EQ( read_edges( *std::make_unique<SnapReader>( copy_file ) ), edges );
+            EXPECT_THROW( bel.save( snap_file ), std::runtime_error );
+
+            for( const std::string& file_name : { text_file, bel_file, snap_file, copy_file } ) {
+                std::filesystem::remove( file_name );
+            }
+        }
+
+        TEST( SnapReader, MalformedEdgeListsAreRejected ) {
+            using samg::matutx::reader::SnapReader;
+            const std::string file_name = temp_file( "bad.bel" );
+            auto write = [&file_name]( const std::vector<std::uint64_t> values ) {
+                std::ofstream out( file_name, std::ios::binary | std::ios::trunc );
+                out.write( reinterpret_cast<const char*>( values.data() ), values.size() * sizeof( std::uint64_t ) );
+            };
+            write( { 1ULL, 2ULL, 1ULL, 1ULL } ); // Not sorted.
+            EXPECT_THROW( SnapReader{ file_name }, std::runtime_error );
+            write( { 1ULL, 2ULL, 3ULL } ); // Odd number of values.
+            EXPECT_THROW( SnapReader{ file_name }, std::runtime_error );
+            write( { 1ULL, 2ULL, 1ULL, 2ULL, 4ULL, 0ULL } ); // Sorted, with a repeated edge.
+            SnapReader reader( file_name );
+            EXPECT_EQ( read_edges( reader ), Coordinates( { { 1ULL, 2ULL }, { 1ULL, 2ULL }, { 4ULL, 0ULL } } ) );
+            EXPECT_EQ( reader.get_max_per_dimension(), std::vector<std::uint64_t>( { 4ULL, 4ULL } ) );
+            std::filesystem::remove( file_name );
+        }
+
+        TEST( SnapReader, DestroyedThroughTheReaderInterface ) {
+            using samg::matutx::reader::SnapReader;
+            const std::string text_file = temp_file( "graph.txt" ), bel_file = temp_file( "graph.bel" );
+            write_edge_list( text_file, random_coordinates( 2ZU, 100ULL, 500ZU, 4ULL ) );
+            SnapReader( text_file ).save( bel_file );
+            for( const std::string& file_name : { text_file, bel_file } ) {
+                samg::matutx::reader::Reader* reader = new SnapReader( file_name );
+                EXPECT_EQ( read_edges( *reader ).size(), reader->get_number_of_entries() );
+                samg::matutx::reader::destroy_instance( *reader ); // Must release the graph and the edge list.
+            }
+            std::filesystem::remove( text_file );
+            std::filesystem::remove( bel_file );
+        }
+
+        TEST( PackedArray, EveryWidthMatchesTheInput ) {
+            std::mt19937_64 gen( 28ULL );
+            for( std::size_t width = 0ZU; width <= 64ZU; ++width ) {
+                const std::uint64_t mask = width == 64ZU ? ~0ULL : ( ( 1ULL << width ) - 1ULL );
+                for( const std::size_t length : { 0ZU, 1ZU, 63ZU, 1000ZU } ) {
+                    std::vector<std::uint64_t> values( length );
+                    for( std::size_t i = 0ZU; i < length; ++i ) {
+                        // Extreme values make every straddling read visible.
+                        values[ i ] = i % 5ZU == 0ZU ? mask : ( gen() & mask );
+                    }
+                    samg::matutx::streamer::PackedArray packed( values, static_cast<std::uint8_t>( width ) );
+                    ASSERT_EQ( packed.size(), length );
+                    EXPECT_EQ( packed.get_width(), width );
+                    for( std::size_t i = 0ZU; i < length; ++i ) {
+                        ASSERT_EQ( packed[ i ], values[ i ] ) << "width=" << width << " i=" << i;
+                    }
+                    std::sort( values.begin(), values.end() );
+                    samg::matutx::streamer::PackedArray sorted( values, static_cast<std::uint8_t>( width ) );
+                    for( std::size_t q = 0ZU; q < 50ZU; ++q ) {
+                        const std::uint64_t value = q == 0ZU ? 0ULL : ( q == 1ZU ? mask : ( gen() & mask ) );
+                        const std::size_t first = length == 0ZU ? 0ZU : gen() % length,
+                                          last = first + ( length == first ? 0ZU : gen() % ( length - first + 1ZU ) );
+                        EXPECT_EQ( sorted.lower_bound( first, last, value ), std::lower_bound( values.begin() + first, values.begin() + last, value ) - values.begin() );
+                    }
+                }
+            }
+            const std::vector<std::uint64_t> values = { 1ULL };
+            EXPECT_THROW( ( samg::matutx::streamer::PackedArray{ values, 65 } ), std::invalid_argument );
+        }
+
+        TEST( EliasFano, MatchesTheInput ) {
+            using samg::matutx::streamer::EliasFano;
+            std::mt19937_64 gen( 29ULL );
+            std::vector<std::vector<std::uint64_t>> sequences = { {}, { 0ULL }, { 5ULL }, { 7ULL, 7ULL, 7ULL }, { 0ULL, 0ULL, 1ULL, 1ULL << 40 } };
+            for( const std::size_t length : { 63ZU, 64ZU, 65ZU, 1000ZU } ) {
+                for( const std::uint64_t gap : { 1ULL, 3ULL, 1000ULL, 1ULL << 30 } ) {
+                    std::vector<std::uint64_t> s( length );
+                    std::uint64_t v = 0ULL;
+                    for( auto& x : s ) {
+                        v += gen() % gap; // Zero gaps repeat values.
+                        x = v;
+                    }
+                    sequences.push_back( s );
+                }
+            }
+            for( const auto& s : sequences ) {
+                EliasFano ef( s );
+                ASSERT_EQ( ef.size(), s.size() );
+                for( std::size_t i = 0ZU; i < s.size(); ++i ) {
+                    ASSERT_EQ( ef[ i ], s[ i ] ) << "|s|=" << s.size() << " i=" << i;
+                }
+                for( std::size_t i = 0ZU; i + 1ZU < s.size(); ++i ) {
+                    std::uint64_t a, b;
+                    ef.get_pair( i, a, b );
+                    ASSERT_EQ( a, s[ i ] );
+                    ASSERT_EQ( b, s[ i + 1ZU ] );
+                }
+            }
+            const std::vector<std::uint64_t> decreasing = { 1ULL, 3ULL, 2ULL };
+            EXPECT_THROW( EliasFano{ decreasing }, std::invalid_argument );
+        }
+
+        TEST( CompactCSMR, MatchesCSMR ) {
+            using samg::matutx::streamer::CSMR;
+            using samg::matutx::streamer::CompactCSMR;
+            struct Case { std::size_t n; std::uint64_t max; std::size_t count; };
+            for( const Case c : { Case{ 1ZU, 10ZU, 5ZU }, Case{ 2ZU, 1000ZU, 20000ZU }, Case{ 3ZU, 50ZU, 5000ZU }, Case{ 4ZU, 8ZU, 3000ZU }, Case{ 2ZU, 1ULL << 40, 2000ZU }, Case{ 3ZU, 10ZU, 0ZU } } ) {
+                const Coordinates coordinates = random_coordinates( c.n, c.max, c.count, c.n + c.count );
+                CSMR baseline( c.n, coordinates );
+                CompactCSMR compact( baseline );
+                EXPECT_EQ( compact.get_sequence(), coordinates ) << "n=" << c.n;
+                EXPECT_EQ( compact.get_number_of_edges(), baseline.get_number_of_edges() );
+                EXPECT_EQ( compact.get_number_of_nodes(), baseline.get_number_of_nodes() );
+                for( const auto& q : random_queries( coordinates, c.n, c.max, 3000ZU, c.n ) ) {
+                    ASSERT_EQ( compact.contains( q ), baseline.contains( q ) ) << "n=" << c.n;
+                }
+                compact.restart();
+                Coordinates traversed;
+                while( compact.has_next() ) {
+                    traversed.push_back( compact.next() );
+                }
+                EXPECT_EQ( traversed, coordinates );
+            }
+        }
+
+        /**
+         * @brief Compares a CSMR against the one built by inserting `coordinates` one by one.
+         */
+        static void expect_same_csmr( samg::matutx::streamer::CSMR& csmr, const Coordinates& coordinates, const std::size_t n ) {
+            samg::matutx::streamer::CSMR baseline( n, coordinates );
+            EXPECT_EQ( csmr.get_sequence(), baseline.get_sequence() );
+            EXPECT_EQ( csmr.get_number_of_edges(), baseline.get_number_of_edges() );
+            EXPECT_EQ( csmr.get_number_of_nodes(), baseline.get_number_of_nodes() );
+            for( const auto& q : random_queries( coordinates, n, csmr.get_number_of_nodes(), 1000ZU, n ) ) {
+                ASSERT_EQ( csmr.contains( q ), baseline.contains( q ) );
+            }
+        }
+
+        struct Shape { std::size_t n; std::uint64_t max; std::size_t count; };
+        static const Shape SHAPES[] = { { 1ZU, 10ULL, 1ZU }, { 1ZU, 5ULL, 50ZU }, { 2ZU, 1000ULL, 20000ZU }, { 3ZU, 50ULL, 5000ZU }, { 4ZU, 6ULL, 3000ZU }, { 2ZU, 1ULL << 40, 3000ZU }, { 3ZU, ~0ULL, 1000ZU }, { 2ZU, 10ULL, 0ZU } };
+
+        TEST( BulkLoad, PointerConstructorMatchesInsertion ) {
+            using samg::matutx::streamer::CSMR;
+            for( const Shape s : SHAPES ) {
+                const Coordinates coordinates = random_coordinates( s.n, s.max, s.count, s.count );
+                // Repeated rows are ignored, as add() does.
+                Coordinates repeated;
+                for( const auto& c : coordinates ) {
+                    repeated.insert( repeated.end(), 1ZU + c[ 0 ] % 2ZU, c );
+                }
+                for( const std::size_t nthreads : { 1ZU, 3ZU } ) {
+                    SCOPED_TRACE( "n=" + std::to_string( s.n ) + " count=" + std::to_string( s.count ) + " nthreads=" + std::to_string( nthreads ) );
+                    const std::vector<std::uint64_t> flat = flatten( repeated );
+                    CSMR csmr( s.n, flat.data(), repeated.size(), nthreads );
+                    expect_same_csmr( csmr, coordinates, s.n );
+                }
+            }
+            const std::vector<std::uint64_t> unsorted = { 2ULL, 1ULL };
+            EXPECT_THROW( ( CSMR{ 1ZU, unsorted.data(), 2ZU, 2ZU } ), std::invalid_argument );
+        }
+
+        TEST( BulkLoad, ReaderConstructorSortsItsInput ) {
+            using samg::matutx::streamer::CSMR;
+            for( const Shape s : SHAPES ) {
+                const Coordinates coordinates = random_coordinates( s.n, s.max, s.count, s.count + 1ZU );
+                Coordinates shuffled = coordinates;
+                if( !coordinates.empty() ) {
+                    shuffled.insert( shuffled.end(), coordinates.begin(), coordinates.begin() + ( coordinates.size() + 1ZU ) / 2ZU );
+                }
+                std::shuffle( shuffled.begin(), shuffled.end(), std::mt19937_64( s.count ) );
+                for( const std::size_t nthreads : { 1ZU, 3ZU } ) {
+                    SCOPED_TRACE( "n=" + std::to_string( s.n ) + " count=" + std::to_string( s.count ) + " nthreads=" + std::to_string( nthreads ) );
+                    CoordinatesReader sorted_reader( coordinates, s.n ), shuffled_reader( shuffled, s.n );
+                    CSMR sorted( sorted_reader, nthreads ), radix_sorted( shuffled_reader, nthreads );
+                    expect_same_csmr( sorted, coordinates, s.n );
+                    expect_same_csmr( radix_sorted, coordinates, s.n );
+                }
+            }
+            CoordinatesReader mismatch( { { 1ULL, 2ULL }, { 3ULL } }, 2ZU );
+            EXPECT_THROW( CSMR{ mismatch }, std::invalid_argument );
+        }
+
+        TEST( CSMR, ContainsBatchMatchesContains ) {
+            using samg::matutx::streamer::CSMR;
+            for( const Shape s : SHAPES ) {
+                const Coordinates coordinates = random_coordinates( s.n, s.max, s.count, s.count + 2ZU );
+                CSMR csmr( s.n, coordinates );
+                for( const std::size_t count : { 0ZU, 1ZU, 5ZU, 3000ZU } ) {
+                    SCOPED_TRACE( "n=" + std::to_string( s.n ) + " count=" + std::to_string( s.count ) + " queries=" + std::to_string( count ) );
+                    const Coordinates queries = random_queries( coordinates, s.n, s.max, count, count );
+                    const std::vector<std::uint64_t> flat = flatten( queries );
+                    std::unique_ptr<bool[]> out( new bool[ count + 1ZU ] );
+                    csmr.contains_batch( flat.data(), count, out.get() );
+                    for( std::size_t q = 0ZU; q < count; ++q ) {
+                        ASSERT_EQ( out[ q ], csmr.contains( queries[ q ] ) ) << "q=" << q;
+                    }
+                }
+            }
+            {
+                // The largest representable component must not overflow the clamping of out-of-range queries.
+                const Coordinates coordinates = { { 0ULL, ~0ULL }, { ~0ULL, 1ULL } };
+                CSMR csmr( 2ZU, coordinates );
+                const Coordinates queries = { { ~0ULL, 1ULL }, { 0ULL, ~0ULL }, { ~0ULL, 0ULL }, { 1ULL, ~0ULL }, { 0ULL, ~0ULL } };
+                const std::vector<std::uint64_t> flat = flatten( queries );
+                bool out[ 5 ];
+                csmr.contains_batch( flat.data(), queries.size(), out );
+                EXPECT_TRUE( out[ 0 ] && out[ 1 ] && out[ 4 ] );
+                for( std::size_t q = 0ZU; q < queries.size(); ++q ) {
+                    EXPECT_EQ( out[ q ], csmr.contains( queries[ q ] ) ) << "q=" << q;
+                }
+            }
+            CSMR unsealed( 2ZU );
+            unsealed.add( { 1ULL, 2ULL } );
+            const std::uint64_t query[ 2 ] = { 1ULL, 2ULL };
+            bool out;
+            EXPECT_THROW( unsealed.contains_batch( query, 1ZU, &out ), std::logic_error );
+        }
+
+        TEST( CSMR, SaveAndMapRoundTrip ) {
+            using samg::matutx::streamer::CSMR;
+            const std::string file_name = temp_file( "csmr.bin" );
+            for( const Shape s : SHAPES ) {
+                SCOPED_TRACE( "n=" + std::to_string( s.n ) + " count=" + std::to_string( s.count ) );
+                const Coordinates coordinates = random_coordinates( s.n, s.max, s.count, s.count + 3ZU );
+                {
+                    CSMR csmr( s.n );
+                    for( const auto& c : coordinates ) {
+                        csmr.add( c );
+                    }
+                    csmr.save( file_name ); // Seals the structure.
+                }
+                CSMR mapped = CSMR::map( file_name );
+                std::filesystem::remove( file_name ); // The mapping outlives the file name.
+                expect_same_csmr( mapped, coordinates, s.n );
+                CSMR copy( mapped ), assigned( s.n );
+                assigned = mapped;
+                EXPECT_EQ( copy.get_sequence(), coordinates );
+                EXPECT_EQ( assigned.get_sequence(), coordinates );
+                EXPECT_THROW( mapped.add( std::vector<std::uint64_t>( s.n, 0ULL ) ), std::logic_error );
+            }
+        }
+
+        TEST( CSMR, MalformedFilesAreRejected ) {
+            using samg::matutx::streamer::CSMR;
+            const std::string file_name = temp_file( "csmr.bin" );
+            EXPECT_THROW( CSMR::map( file_name ), std::runtime_error ); // Missing.
+            {
+                std::ofstream out( file_name, std::ios::binary );
+                out << "not a CSMR file at all";
+            }
+            EXPECT_THROW( CSMR::map( file_name ), std::runtime_error ); // Bad magic number.
+            std::filesystem::resize_file( file_name, 8ZU );
+            EXPECT_THROW( CSMR::map( file_name ), std::runtime_error ); // Shorter than the header.
+            CSMR csmr( 3ZU, random_coordinates( 3ZU, 100ULL, 2000ZU, 31ULL ) );
+            csmr.save( file_name );
+            const std::size_t size = std::filesystem::file_size( file_name );
+            std::filesystem::resize_file( file_name, size - sizeof( std::uint64_t ) );
+            EXPECT_THROW( CSMR::map( file_name ), std::runtime_error ); // Truncated payload.
+            std::filesystem::resize_file( file_name, 5ZU * sizeof( std::uint64_t ) );
+            EXPECT_THROW( CSMR::map( file_name ), std::runtime_error ); // Truncated header.
+
+            // Tampered headers and arrays: header = { magic, n, max, |ind[0..n-1]|, |ptr[0..n-2]| }, then 64-byte aligned arrays.
+            const std::string original = temp_file( "original.bin" );
+            csmr.save( original );
+            std::vector<std::uint64_t> words( std::filesystem::file_size( original ) / sizeof( std::uint64_t ) );
+            std::ifstream( original, std::ios::binary ).read( reinterpret_cast<char*>( words.data() ), words.size() * sizeof( std::uint64_t ) );
+            auto array_offset = [&words]( const std::size_t a ) { // Word offset of the a-th array.
+                std::size_t offset = 8ZU; // ( 2n + 2 ) words, aligned to 64 bytes.
+                for( std::size_t i = 0ZU; i < a; ++i ) {
+                    offset = ( ( offset + words[ 3ZU + i ] ) + 7ZU ) & ~7ZU;
+                }
+                return offset;
+            };
+            auto expect_rejected = [&]( const std::size_t word, const std::uint64_t value, const std::string what ) {
+                std::vector<std::uint64_t> tampered = words;
+                tampered[ word ] = value;
+                std::ofstream( file_name, std::ios::binary | std::ios::trunc ).write( reinterpret_cast<const char*>( tampered.data() ), tampered.size() * sizeof( std::uint64_t ) );
+                EXPECT_THROW( CSMR::map( file_name ), std::runtime_error ) << what;
+            };
+            EXPECT_EQ( CSMR::map( original ).get_sequence(), csmr.get_sequence() );
+            expect_rejected( 1ZU, 1ULL << 62, "n overflowing the header size" );
+            expect_rejected( 3ZU, ( 1ULL << 61 ) + 1ULL, "|ind[0]| overflowing the array size" );
+            expect_rejected( 4ZU, words[ 4 ] - 1ULL, "|ind[1]| below ptr[0].back()" );
+            expect_rejected( 6ZU, words[ 6 ] - 1ULL, "|ptr[0]| != |ind[0]| + 1" );
+            expect_rejected( array_offset( 3ZU ), 1ULL, "ptr[0] not starting at 0" );
+            expect_rejected( array_offset( 3ZU ) + words[ 6 ] - 1ULL, words[ 4 ] + 1ULL, "ptr[0] beyond ind[1]" );
+            expect_rejected( array_offset( 4ZU ) + 1ZU, ~0ULL, "decreasing ptr[1]" );
+            expect_rejected( array_offset( 2ZU ), words[ 2 ] + 1ULL, "coordinate above the maximum" );
+            std::filesystem::remove( original );
+            std::filesystem::remove( file_name );
+        }
+
+        TEST( CSMR, BoxIteratorMatchesFiltering ) {
+            using samg::matutx::streamer::CSMR;
+            std::mt19937_64 gen( 32ULL );
+            for( const Shape s : SHAPES ) {
+                const Coordinates coordinates = random_coordinates( s.n, s.max, s.count, s.count + 4ZU );
+                CSMR csmr( s.n, coordinates );
+                const Coordinates sequence = csmr.get_sequence();
+                const std::uint64_t side = std::min<std::uint64_t>( s.max, 1ULL << 62 );
+                for( std::size_t b = 0ZU; b < 60ZU; ++b ) {
+                    std::vector<std::uint64_t> lo( s.n ), hi( s.n );
+                    for( std::size_t k = 0ZU; k < s.n; ++k ) {
+                        lo[ k ] = gen() % ( side + 2ULL );
+                        hi[ k ] = lo[ k ] + gen() % ( side / 2ULL + 2ULL );
+                        if( b % 7ZU == 0ZU ) { // The whole space.
+                            lo[ k ] = 0ULL;
+                            hi[ k ] = ~0ULL;
+                        } else if( b % 11ZU == 0ZU ) { // A single coordinate.
+                            hi[ k ] = lo[ k ] = sequence.empty() ? 0ULL : sequence[ gen() % sequence.size() ][ k ];
+                        }
+                    }
+                    if( b % 13ZU == 5ZU ) { // An empty box.
+                        lo[ s.n - 1ZU ] = hi[ s.n - 1ZU ] + 1ULL;
+                    }
+                    Coordinates expected;
+                    for( const auto& c : sequence ) {
+                        bool inside = true;
+                        for( std::size_t k = 0ZU; k < s.n; ++k ) {
+                            inside = inside && lo[ k ] <= c[ k ] && c[ k ] <= hi[ k ];
+                        }
+                        if( inside ) {
+                            expected.push_back( c );
+                        }
+                    }
+                    const std::size_t max_entries = b % 3ZU == 0ZU ? 1ZU : ( b % 3ZU == 1ZU ? 7ZU : 1000ZU );
+                    auto it = csmr.box( lo.data(), hi.data() );
+                    std::vector<std::uint64_t> buffer( max_entries * s.n );
+                    for( std::size_t pass = 0ZU; pass < 2ZU; ++pass ) {
+                        Coordinates got;
+                        std::size_t m;
+                        while( ( m = it.next( buffer.data(), max_entries ) ) > 0ZU ) {
+                            ASSERT_LE( m, max_entries );
+                            for( std::size_t i = 0ZU; i < m; ++i ) {
+                                got.emplace_back( buffer.begin() + i * s.n, buffer.begin() + ( i + 1ZU ) * s.n );
+                            }
+                        }
+                        EXPECT_FALSE( it.has_next() );
+                        EXPECT_EQ( got, expected ) << "n=" << s.n << " count=" << s.count << " box=" << b << " pass=" << pass;
+                        it.restart();
+                    }
+                }
+            }
+        }
+
+        TEST( CSMR, CursorAndForEachMatchNext ) {
+            using samg::matutx::streamer::CSMR;
+            for( const Shape s : SHAPES ) {
+                SCOPED_TRACE( "n=" + std::to_string( s.n ) + " count=" + std::to_string( s.count ) );
+                const Coordinates coordinates = random_coordinates( s.n, s.max, s.count, s.count + 5ZU );
+                CSMR csmr( s.n, coordinates );
+                EXPECT_EQ( csmr.get_sequence(), coordinates );
+                Coordinates cursor, visited;
+                csmr.restart();
+                while( csmr.has_next() ) {
+                    cursor.emplace_back( csmr.current(), csmr.current() + s.n );
+                    csmr.advance();
+                }
+                EXPECT_EQ( cursor, coordinates );
+                EXPECT_THROW( csmr.advance(), std::out_of_range );
+                csmr.restart();
+                csmr.for_each( [&visited, &s]( const std::uint64_t* c ) { visited.emplace_back( c, c + s.n ); } );
+                EXPECT_EQ( visited, coordinates );
+                EXPECT_FALSE( csmr.has_next() );
+                csmr.restart();
+                EXPECT_EQ( read_csmr( csmr ), coordinates ); // Usable again after for_each().
+            }
+        }
+
+        TEST( MXSReader, CursorForEachAndZValuesMatchNext ) {
+            using samg::matutx::reader::MXSReader;
+            const std::string file_name = temp_file( "matrix.mxs" );
+            for( const Shape s : { Shape{ 2ZU, 300ULL, 1ZU }, Shape{ 2ZU, 300ULL, 20000ZU }, Shape{ 3ZU, 300ULL, 20000ZU }, Shape{ 4ZU, 20ULL, 50000ZU } } ) {
+                SCOPED_TRACE( "n=" + std::to_string( s.n ) + " count=" + std::to_string( s.count ) );
+                const Coordinates coordinates = random_coordinates( s.n, s.max, s.count, s.count + 6ZU );
+                {
+                    samg::matutx::writer::MXSWriter writer( file_name, std::vector<std::uint64_t>( s.n, s.max ), coordinates.size(), s.max, 0.1F, 0.1F );
+                    for( const auto& c : coordinates ) {
+                        writer.add_entry( c );
+                    }
+                    writer.close();
+                }
+                MXSReader baseline( file_name );
+                EXPECT_EQ( read_edges( baseline ), coordinates );
+                EXPECT_THROW( baseline.next(), std::runtime_error );
+
+                MXSReader cursor_reader( file_name ), for_each_reader( file_name );
+                Coordinates cursor, visited;
+                while( cursor_reader.has_next() ) {
+                    cursor.emplace_back( cursor_reader.current(), cursor_reader.current() + s.n );
+                    cursor_reader.advance();
+                }
+                EXPECT_EQ( cursor, coordinates );
+                EXPECT_THROW( cursor_reader.advance(), std::runtime_error );
+                for_each_reader.for_each( [&visited, &s]( const std::uint64_t* c ) { visited.emplace_back( c, c + s.n ); } );
+                EXPECT_EQ( visited, coordinates );
+
+                samg::utils::ZValueConverter converter( s.max, s.n, 2ZU );
+                std::vector<std::uint64_t> expected;
+                for( const auto& c : coordinates ) {
+                    expected.push_back( converter.to_zvalue( c ) );
+                }
+                MXSReader single( file_name ), all( file_name ), mixed( file_name );
+                EXPECT_EQ( read_zvalues( single ), expected );
+                EXPECT_EQ( all.get_zvalues(), expected );
+                std::vector<std::uint64_t> zvalues = { mixed.next_zvalue() };
+                if( mixed.has_next() ) {
+                    mixed.advance(); // Skips the second coordinate.
+                    expected.erase( expected.begin() + 1 );
+                }
+                const std::vector<std::uint64_t> rest = mixed.get_zvalues();
+                zvalues.insert( zvalues.end(), rest.begin(), rest.end() );
+                EXPECT_EQ( zvalues, expected );
+            }
+            std::filesystem::remove( file_name );
+        }
+
+        TEST( CSMR, ParallelForEachVisitsEveryCoordinateOnce ) {
+            using samg::matutx::streamer::CSMR;
+            std::vector<Shape> shapes( std::begin( SHAPES ), std::end( SHAPES ) );
+            shapes.push_back( { 3ZU, 2000ULL, 50000ZU } );
+            for( const Shape s : shapes ) {
+                Coordinates coordinates = random_coordinates( s.n, s.max, s.count, s.count + 7ZU );
+                if( s.count == 50000ZU ) {
+                    // Skewed: most coordinates share the same leading component.
+                    for( std::size_t i = 0ZU; i < coordinates.size(); ++i ) {
+                        coordinates[ i ][ 0 ] = i % 10ZU == 0ZU ? coordinates[ i ][ 0 ] : 3ULL;
+                    }
+                    std::sort( coordinates.begin(), coordinates.end() );
+                    coordinates.erase( std::unique( coordinates.begin(), coordinates.end() ), coordinates.end() );
+                }
+                CSMR csmr( s.n, coordinates );
+                for( const std::size_t nthreads : { 1ZU, 2ZU, 7ZU } ) {
+                    std::vector<Coordinates> visited( nthreads );
+                    csmr.parallel_for_each( nthreads, [&visited, &s, nthreads]( const std::size_t t, const std::uint64_t* c ) {
+                        ASSERT_LT( t, nthreads );
+                        visited[ t ].emplace_back( c, c + s.n );
+                    } );
+                    Coordinates all;
+                    for( const auto& v : visited ) {
+                        all.insert( all.end(), v.begin(), v.end() );
+                    }
+                    std::sort( all.begin(), all.end() );
+                    EXPECT_EQ( all, coordinates ) << "n=" << s.n << " count=" << s.count << " nthreads=" << nthreads;
+                }
+            }
+            CSMR unsealed( 2ZU );
+            unsealed.add( { 1ULL, 2ULL } );
+            EXPECT_THROW( unsealed.parallel_for_each( 2ZU, []( const std::size_t, const std::uint64_t* ) {} ), std::logic_error );
+        }
+
+        TEST( CSMR, BuildPermutedMatchesInsertion ) {
+            using samg::matutx::streamer::CSMR;
+            std::mt19937_64 gen( 35ULL );
+            const std::vector<std::uint64_t> cardinality = { 100000ULL, 3ULL, 1000ULL, 7ULL, 50ULL, 2ULL, 9ULL };
+            for( const std::size_t n : { 1ZU, 2ZU, 3ZU, 4ZU, 7ZU } ) {
+                for( const std::size_t m : { 0ZU, 1ZU, 5000ZU } ) {
+                    std::vector<std::uint64_t> flat( n * m );
+                    for( std::size_t i = 0ZU; i < m; ++i ) {
+                        for( std::size_t k = 0ZU; k < n; ++k ) {
+                            flat[ i * n + k ] = gen() % cardinality[ k ];
+                        }
+                    }
+                    std::vector<std::size_t> reversed( n );
+                    std::iota( reversed.rbegin(), reversed.rend(), 0ZU );
+                    const std::vector<std::size_t> estimated = CSMR::estimate_mode_order( n, flat.data(), m, 1024ZU );
+                    std::vector<std::size_t> sorted_modes = estimated;
+                    std::sort( sorted_modes.begin(), sorted_modes.end() );
+                    std::vector<std::size_t> identity( n );
+                    std::iota( identity.begin(), identity.end(), 0ZU );
+                    EXPECT_EQ( sorted_modes, identity ) << "n=" << n << " m=" << m;
+                    for( const auto& perm : { identity, reversed, estimated } ) {
+                        std::set<std::vector<std::uint64_t>> permuted;
+                        for( std::size_t i = 0ZU; i < m; ++i ) {
+                            std::vector<std::uint64_t> c( n );
+                            for( std::size_t k = 0ZU; k < n; ++k ) {
+                                c[ k ] = flat[ i * n + perm[ k ] ];
+                            }
+                            permuted.insert( c );
+                        }
+                        const Coordinates expected( permuted.begin(), permuted.end() );
+                        for( const std::size_t nthreads : { 1ZU, 4ZU } ) {
+                            SCOPED_TRACE( "n=" + std::to_string( n ) + " m=" + std::to_string( m ) + " nthreads=" + std::to_string( nthreads ) );
+                            CSMR csmr = CSMR::build_permuted( n, flat.data(), m, perm, nthreads );
+                            expect_same_csmr( csmr, expected, n );
+                        }
+                    }
+                }
+            }
+            const std::vector<std::uint64_t> flat = { 1ULL, 2ULL };
+            EXPECT_THROW( CSMR::build_permuted( 2ZU, flat.data(), 1ZU, { 0ZU } ), std::invalid_argument );
+            EXPECT_THROW( CSMR::build_permuted( 2ZU, flat.data(), 1ZU, { 1ZU, 1ZU } ), std::invalid_argument );
+            EXPECT_THROW( CSMR::build_permuted( 2ZU, flat.data(), 1ZU, { 0ZU, 2ZU } ), std::invalid_argument );
+        }
+
+        TEST( CSMR, EstimatedModeOrderFavoursFewDistinctValuesFirst ) {
+            using samg::matutx::streamer::CSMR;
+            std::mt19937_64 gen( 36ULL );
+            // Exhaustive search (n=3) and the cardinality heuristic (n=7) must both put the 2-valued mode first.
+            for( const std::size_t n : { 3ZU, 7ZU } ) {
+                const std::size_t m = 20000ZU;
+                std::vector<std::uint64_t> flat( n * m );
+                for( std::size_t i = 0ZU; i < m; ++i ) {
+                    for( std::size_t k = 0ZU; k < n; ++k ) {
+                        flat[ i * n + k ] = gen() % ( k == n - 1ZU ? 2ULL : 1000ULL + k );
+                    }
+                }
+                const std::vector<std::size_t> order = CSMR::estimate_mode_order( n, flat.data(), m );
+                ASSERT_EQ( order.size(), n );
+                EXPECT_EQ( order[ 0 ], n - 1ZU ) << "n=" << n;
+                EXPECT_LE( CSMR::build_permuted( n, flat.data(), m, order ).get_number_of_edges(), m );
+            }
+        }
+
+        TEST( CSMR, TensorKernelsMatchNaiveLoops ) {
+            using samg::matutx::streamer::CSMR;
+            std::mt19937_64 gen( 36ULL );
+            std::uniform_real_distribution<double> real( -1.0, 1.0 );
+            const Shape shapes[] = { { 1ZU, 2000ULL, 1ZU }, { 1ZU, 2000ULL, 500ZU }, { 2ZU, 300ULL, 5000ZU }, { 3ZU, 40ULL, 5000ZU }, { 4ZU, 12ULL, 5000ZU }, { 3ZU, 10ULL, 0ZU } };
+            for( const Shape s : shapes ) {
+                const Coordinates coordinates = random_coordinates( s.n, s.max, s.count, s.count + 8ZU );
+                CSMR csmr( s.n, coordinates );
+                const std::size_t rows = csmr.get_number_of_nodes();
+                std::vector<double> values( coordinates.size() ), v( rows );
+                for( auto& x : values ) {
+                    x = real( gen );
+                }
+                for( auto& x : v ) {
+                    x = real( gen );
+                }
+                for( const std::size_t R : { 1ZU, 7ZU, 8ZU } ) {
+                    std::vector<std::vector<double>> U( s.n, std::vector<double>( rows * R ) );
+                    std::vector<const double*> factors;
+                    for( auto& u : U ) {
+                        for( auto& x : u ) {
+                            x = real( gen );
+                        }
+                        factors.push_back( u.data() );
+                    }
+                    for( const bool weighted : { false, true } ) {
+                        const double* X = weighted ? values.data() : nullptr;
+                        for( const std::size_t nthreads : { 1ZU, 4ZU } ) {
+                            SCOPED_TRACE( "n=" + std::to_string( s.n ) + " count=" + std::to_string( s.count ) + " R=" + std::to_string( R ) + " weighted=" + std::to_string( weighted ) + " nthreads=" + std::to_string( nthreads ) );
+                            // TTV: one value per distinct prefix of the first n-1 components, in lexicographical order.
+                            std::vector<double> expected;
+                            for( std::size_t i = 0ZU; i < coordinates.size(); ++i ) {
+                                if( expected.empty() || !std::equal( coordinates[ i ].begin(), coordinates[ i ].end() - 1, coordinates[ i - 1ZU ].begin() ) ) {
+                                    expected.push_back( 0.0 );
+                                }
+                                expected.back() += ( weighted ? values[ i ] : 1.0 ) * v[ coordinates[ i ].back() ];
+                            }
+                            if( s.n == 1ZU && expected.empty() ) {
+                                expected.push_back( 0.0 );
+                            }
+                            const std::vector<double> y = csmr.ttv( v.data(), X, nthreads );
+                            ASSERT_EQ( y.size(), expected.size() );
+                            for( std::size_t f = 0ZU; f < y.size(); ++f ) {
+                                EXPECT_NEAR( y[ f ], expected[ f ], 1e-9 ) << "f=" << f;
+                            }
+                            // MTTKRP for every mode.
+                            for( std::size_t mode = 0ZU; mode < s.n; ++mode ) {
+                                std::vector<double> M( rows * R, 42.0 ), expected_M( rows * R, 0.0 );
+                                for( std::size_t i = 0ZU; i < coordinates.size(); ++i ) {
+                                    for( std::size_t r = 0ZU; r < R; ++r ) {
+                                        double p = weighted ? values[ i ] : 1.0;
+                                        for( std::size_t k = 0ZU; k < s.n; ++k ) {
+                                            if( k != mode ) {
+                                                p *= U[ k ][ coordinates[ i ][ k ] * R + r ];
+                                            }
+                                        }
+                                        expected_M[ coordinates[ i ][ mode ] * R + r ] += p;
+                                    }
+                                }
+                                csmr.mttkrp( mode, factors, R, M.data(), X, nthreads );
+                                for( std::size_t i = 0ZU; i < M.size(); ++i ) {
+                                    ASSERT_NEAR( M[ i ], expected_M[ i ], 1e-9 ) << "mode=" << mode << " i=" << i;
+                                }
+                            }
+                        }
+                    }
+                }
+                std::vector<double> M( rows );
+                const std::vector<const double*> factors( s.n, v.data() );
+                EXPECT_THROW( csmr.mttkrp( s.n, factors, 1ZU, M.data() ), std::invalid_argument ); // No such mode.
+            }
+            CSMR unsealed( 2ZU );
+            unsealed.add( { 1ULL, 2ULL } );
+            const std::vector<double> v( 3ZU, 1.0 );
+            EXPECT_THROW( unsealed.ttv( v.data() ), std::logic_error );
+        }
+
+    }
+}
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
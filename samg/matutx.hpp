@@ -3,10 +3,27 @@
 #include <cmath>
 #include <regex>
 #include <memory>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <limits>
+#include <span>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include <algorithm>
 #include <samg/matutx-mdx.hpp>
 #include <samg/matutx-mxs.hpp>
 #include <samg/matutx-graph.hpp>
 #include <samg/matutx-csv.hpp>
+#ifdef MATUTX_WITH_SNAP
+#include <samg/matutx-snap.hpp> // NOTE: Requires linking against libmatutx-snap.a and SNAP.
+#endif
 
 
 /**
@@ -59,6 +76,8 @@ namespace samg {
             RRN, // Rice-runs binary format.
             GRAPH, // Graph format from LAW webgraph framework [https://law.di.unimi.it/index.php].
             CSV, // Comma Separated Values.
+            SNAP, // SNAP graph format; either binary (.snap) or plain-text edge list (.txt) [https://snap.stanford.edu].
+            BEL, // Binary edge list of (src,dst) std::uint64_t pairs sorted lexicographically.
             Unknown
         };
 
@@ -68,7 +87,7 @@ namespace samg {
          * @param file_name 
          * @return FileFormat 
          */
-        FileFormat identify_file_format(const std::string file_name) {
+        inline FileFormat identify_file_format(const std::string file_name) {
             std::size_t position = file_name.find(".mdx");
             if (position != std::string::npos) {
                 return FileFormat::MDX;
@@ -114,15 +133,30 @@ namespace samg {
                 return FileFormat::CSV;
             } 
 
+            position = file_name.find(".snap");
+            if (position != std::string::npos) {
+                return FileFormat::SNAP;
+            } 
+
+            position = file_name.find(".bel");
+            if (position != std::string::npos) {
+                return FileFormat::BEL;
+            } 
+
+            position = file_name.find(".txt");
+            if (position != std::string::npos) {
+                return FileFormat::SNAP;
+            } 
+
             return FileFormat::Unknown;
         }
         /***************************************************************/
         namespace reader {
-            const std::size_t roundup_matrix_size( const std::uint64_t size, const std::size_t k ) {
+            inline const std::size_t roundup_matrix_size( const std::uint64_t size, const std::size_t k ) {
                 return (std::size_t) std::pow( k, std::ceil( std::log(size) / std::log(k) ) );
             }
 
-            std::shared_ptr<Reader> create_instance(const std::string& input_file_name) {
+            inline std::shared_ptr<Reader> create_instance(const std::string& input_file_name) {
                 switch (samg::matutx::identify_file_format(input_file_name)) {
                     case samg::matutx::FileFormat::GRAPH:
                         return std::make_shared<GraphReader>(input_file_name);
@@ -132,12 +166,17 @@ namespace samg {
                         return std::make_shared<MXSReader>(input_file_name);
                     case samg::matutx::FileFormat::CSV:
                         return std::make_shared<CSVReader>(input_file_name);
+#ifdef MATUTX_WITH_SNAP
+                    case samg::matutx::FileFormat::SNAP:
+                    case samg::matutx::FileFormat::BEL:
+                        return std::make_shared<SnapReader>(input_file_name);
+#endif
                     default:
                         throw std::runtime_error("Unrecognized file format!");
                 }
             }
 
-            void destroy_instance( Reader& reader ) {
+            inline void destroy_instance( Reader& reader ) {
                 delete &reader;
             }
         }
@@ -179,7 +218,10 @@ namespace samg {
              * @note The space complexity of CSMR class is O(n + m), where n is the number of dimensions and m is the total number of unique coordinates inserted. The traversal methods operate in O(n) time per coordinate retrieval, making it efficient for large datasets.
              * 
              */
+            class CompactCSMR;
+
             class CSMR {
+            friend class CompactCSMR;
             private:
                 std::size_t num_dims;
                 bool is_sealed;
@@ -192,13 +234,16 @@ namespace samg {
                 std::vector<std::vector<std::uint64_t>> ind;
                 // ptr[d] stores the boundary offsets for dimension d to d+1
                 std::vector<std::vector<std::uint64_t>> ptr;
+                // Read-only views used by every query/traversal method; they point either into ind/ptr (bound by seal()) or into a memory-mapped file (see map()).
+                std::vector<std::span<const std::uint64_t>> ind_view;
+                std::vector<std::span<const std::uint64_t>> ptr_view;
+                std::shared_ptr<void> mapping; // Keeps the memory-mapped file alive; null when ind/ptr own the data.
 
                 // Traversal State variables for the iterator (DFS mimicking)
                 std::vector<std::size_t> I;
                 std::vector<std::size_t> J;
                 std::vector<std::uint64_t> current_coord;
                 std::size_t d;
-                std::vector<std::uint64_t> _next_result;
                 bool _has_next;
 
                 /**
@@ -206,36 +251,53 @@ namespace samg {
                  * Required before any traversal can begin.
                  */
                 void seal() {
-                    if (is_sealed || is_first_insertion) {
-                        is_sealed = true;
+                    if (is_sealed) {
                         return;
                     }
-                    // Cap off the boundaries of the ptr arrays with the final sizes
-                    for (std::size_t k = 0; k < num_dims - 1; ++k) {
-                        ptr[k].push_back(ind[k + 1].size());
+                    if (!is_first_insertion) {
+                        // Cap off the boundaries of the ptr arrays with the final sizes
+                        for (std::size_t k = 0; k < num_dims - 1; ++k) {
+                            ptr[k].push_back(ind[k + 1].size());
+                        }
                     }
                     is_sealed = true;
+                    _bind_views_();
                 }
 
                 /**
-                 * @brief Proactively traverses the tree to find the next valid leaf.
+                 * @brief Points the read-only views to the owned ind/ptr arrays, unless they point into a memory-mapped file.
+                 */
+                void _bind_views_() {
+                    if (mapping) return;
+                    ind_view.assign(ind.begin(), ind.end());
+                    ptr_view.assign(ptr.begin(), ptr.end());
+                }
+
+                static constexpr std::uint64_t FILE_MAGIC = 0x31524D5343ULL; // "CSMR1" in little-endian.
+                static constexpr std::size_t FILE_ALIGNMENT = 64ZU; // Alignment (in bytes) of the header and every array within a saved file.
+
+                static inline std::size_t _align_(const std::size_t offset) {
+                    return (offset + FILE_ALIGNMENT - 1) & ~(FILE_ALIGNMENT - 1);
+                }
+
+                /**
+                 * @brief Proactively traverses the tree to find the next valid leaf, which is left in current_coord.
                  * Updates _has_next instantaneously so the sequence wrapper never lies.
                  */
-                void advance() {
+                void _advance_() {
                     while (true) {
                         if (I[d] < J[d]) {
-                            current_coord[d] = ind[d][I[d]];
+                            current_coord[d] = ind_view[d][I[d]];
 
                             if (d == num_dims - 1) {
-                                // LEAF NODE: Cache the result and pause traversal
-                                _next_result = current_coord;
+                                // LEAF NODE: Pause traversal; current_coord holds the result
                                 I[d]++; 
                                 _has_next = true;
                                 return; 
                             } else {
                                 // INTERNAL NODE: Branch down
-                                I[d + 1] = ptr[d][I[d]];
-                                J[d + 1] = (I[d] + 1 < ptr[d].size()) ? ptr[d][I[d] + 1] : ind[d + 1].size();
+                                I[d + 1] = ptr_view[d][I[d]];
+                                J[d + 1] = (I[d] + 1 < ptr_view[d].size()) ? ptr_view[d][I[d] + 1] : ind_view[d + 1].size();
                                 d++;
                             }
                         } else {
@@ -250,12 +312,445 @@ namespace samg {
                     }
                 }
 
+                static constexpr std::size_t BATCH_LANES = 16; // Number of queries processed in lockstep by contains_batch().
+                static constexpr std::size_t LINEAR_SEARCH_THRESHOLD = 16; // Sibling ranges up to this length are scanned linearly.
+
+                /**
+                 * @brief Returns the position of `x` in the sorted range a[first,last), or `last` if it is absent.
+                 */
+                static inline std::size_t _find_(const std::uint64_t* a, const std::size_t first, const std::size_t last, const std::uint64_t x) {
+                    if (last - first <= LINEAR_SEARCH_THRESHOLD) {
+                        std::size_t i = first;
+#if defined(__AVX2__)
+                        const __m256i key = _mm256_set1_epi64x(static_cast<long long>(x));
+                        for (; i + 4 <= last; i += 4) {
+                            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                            const int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, key)));
+                            if (mask != 0) return i + std::countr_zero(static_cast<unsigned int>(mask));
+                        }
+#endif
+                        for (; i < last; ++i) {
+                            if (a[i] >= x) return (a[i] == x) ? i : last;
+                        }
+                        return last;
+                    }
+                    const std::uint64_t* it = std::lower_bound(a + first, a + last, x);
+                    return (it != a + last && *it == x) ? static_cast<std::size_t>(it - a) : last;
+                }
+
+                /**
+                 * @brief Runs f(t, first, last) on `nthreads` threads, where [first,last) is the t-th contiguous chunk of [0,m).
+                 */
+                template<typename F> static void _parallel_chunks_(const std::size_t m, const std::size_t nthreads, F&& f) {
+                    if (nthreads <= 1 || m < nthreads) {
+                        for (std::size_t t = 0; t < nthreads; ++t) {
+                            f(t, (m * t) / nthreads, (m * (t + 1)) / nthreads);
+                        }
+                        return;
+                    }
+                    std::vector<std::thread> workers;
+                    workers.reserve(nthreads);
+                    for (std::size_t t = 0; t < nthreads; ++t) {
+                        workers.emplace_back([&f, t, m, nthreads]() { f(t, (m * t) / nthreads, (m * (t + 1)) / nthreads); });
+                    }
+                    for (auto& w : workers) {
+                        w.join();
+                    }
+                }
+
+                static constexpr std::size_t RADIX_BITS = 8; // Bits per digit of the radix sort.
+
+                /**
+                 * @brief Sorts the m rows of n components in `coords` lexicographically with a parallel LSD radix sort; columns are processed from last to first, each one digit by digit up to the bit width of its maximum value.
+                 * @note Every pass computes per-thread digit histograms over contiguous chunks, turns them into per-thread bucket offsets with prefix sums, and scatters the rows stably in parallel.
+                 */
+                static void _sort_rows_(std::vector<std::uint64_t>& coords, const std::size_t n, const std::size_t m, std::size_t nthreads) {
+                    constexpr std::size_t B = 1ZU << RADIX_BITS;
+                    nthreads = std::max<std::size_t>(1, std::min(nthreads, m));
+                    std::vector<std::uint64_t> maxs(nthreads * n, 0);
+                    _parallel_chunks_(m, nthreads, [&](std::size_t t, std::size_t first, std::size_t last) {
+                        for (std::size_t i = first; i < last; ++i) {
+                            for (std::size_t k = 0; k < n; ++k) maxs[t * n + k] = std::max(maxs[t * n + k], coords[i * n + k]);
+                        }
+                    });
+                    std::vector<std::uint64_t> buffer(coords.size());
+                    std::vector<std::size_t> offsets(nthreads * B);
+                    for (std::size_t k = n; k-- > 0;) {
+                        std::uint64_t mx = 0;
+                        for (std::size_t t = 0; t < nthreads; ++t) mx = std::max(mx, maxs[t * n + k]);
+                        for (std::size_t shift = 0; shift < static_cast<std::size_t>(std::bit_width(mx)); shift += RADIX_BITS) {
+                            const std::uint64_t* src = coords.data();
+                            std::uint64_t* dst = buffer.data();
+                            std::fill(offsets.begin(), offsets.end(), 0);
+                            _parallel_chunks_(m, nthreads, [&](std::size_t t, std::size_t first, std::size_t last) {
+                                std::size_t* h = offsets.data() + t * B;
+                                for (std::size_t i = first; i < last; ++i) h[(src[i * n + k] >> shift) & (B - 1)]++;
+                            });
+                            // Exclusive prefix sums in (bucket, thread) order keep the scatter stable.
+                            std::size_t total = 0;
+                            for (std::size_t r = 0; r < B; ++r) {
+                                for (std::size_t t = 0; t < nthreads; ++t) {
+                                    const std::size_t c = offsets[t * B + r];
+                                    offsets[t * B + r] = total;
+                                    total += c;
+                                }
+                            }
+                            _parallel_chunks_(m, nthreads, [&](std::size_t t, std::size_t first, std::size_t last) {
+                                std::size_t* o = offsets.data() + t * B;
+                                for (std::size_t i = first; i < last; ++i) {
+                                    std::copy_n(src + i * n, n, dst + (o[(src[i * n + k] >> shift) & (B - 1)]++) * n);
+                                }
+                            });
+                            coords.swap(buffer);
+                        }
+                    }
+                }
+
+                /**
+                 * @brief Returns the number of internal nodes (distinct prefixes of length 1..n-1) of the tree built from the sample rows under the mode order `perm`.
+                 */
+                static std::size_t _count_internal_nodes_(const std::vector<std::uint64_t>& sample, const std::size_t n, const std::vector<std::size_t>& perm) {
+                    const std::size_t m = sample.size() / n;
+                    std::vector<std::uint64_t> rows(sample.size());
+                    for (std::size_t i = 0; i < m; ++i) {
+                        for (std::size_t k = 0; k < n; ++k) rows[i * n + k] = sample[i * n + perm[k]];
+                    }
+                    _sort_rows_(rows, n, m, 1);
+                    std::size_t nodes = std::min<std::size_t>(m, 1) * (n - 1);
+                    for (std::size_t i = 1; i < m; ++i) {
+                        std::size_t k = 0;
+                        while (k < n - 1 && rows[i * n + k] == rows[(i - 1) * n + k]) k++;
+                        nodes += (n - 1) - k;
+                    }
+                    return nodes;
+                }
+
+                /**
+                 * @brief Builds every ind[d]/ptr[d] from m lexicographically sorted rows of num_dims components stored contiguously in `coords`.
+                 * @note Rows are split into chunks. Each thread computes the divergence depth of its rows against their predecessors and counts the nodes it adds per dimension; exclusive prefix sums over those counts give every chunk its write offsets, and a second pass fills the arrays.
+                 */
+                void _bulk_load_(const std::uint64_t* coords, const std::size_t m, std::size_t nthreads) {
+                    const std::size_t n = num_dims;
+                    if (m == 0) {
+                        seal();
+                        return;
+                    }
+                    nthreads = std::max<std::size_t>(1, std::min(nthreads, m));
+                    std::vector<std::uint8_t> div(m); // Divergence depth of every row; n flags a duplicate.
+                    std::vector<std::vector<std::size_t>> counts(nthreads, std::vector<std::size_t>(n, 0));
+                    std::vector<std::uint64_t> maxs(nthreads, 0);
+                    std::vector<std::uint8_t> unsorted(nthreads, 0);
+
+                    // Pass 1: divergence depths, node counts and maximum value per chunk.
+                    _parallel_chunks_(m, nthreads, [&](std::size_t t, std::size_t first, std::size_t last) {
+                        std::vector<std::size_t>& cnt = counts[t];
+                        std::uint64_t mx = 0;
+                        for (std::size_t i = first; i < last; ++i) {
+                            const std::uint64_t* c = coords + i * n;
+                            std::size_t k = 0;
+                            if (i > 0) {
+                                const std::uint64_t* p = c - n;
+                                while (k < n && c[k] == p[k]) k++;
+                                if (k < n && c[k] < p[k]) unsorted[t] = 1;
+                            }
+                            div[i] = static_cast<std::uint8_t>(k);
+                            for (std::size_t j = k; j < n; ++j) cnt[j]++;
+                            for (std::size_t j = 0; j < n; ++j) mx = std::max(mx, c[j]);
+                        }
+                        maxs[t] = mx;
+                    });
+                    if (std::any_of(unsorted.begin(), unsorted.end(), [](std::uint8_t u) { return u != 0; })) {
+                        throw std::invalid_argument("Coordinates must be added in lexicographical order.");
+                    }
+                    max_coord_val = *std::max_element(maxs.begin(), maxs.end());
+
+                    // Exclusive prefix sums: counts[t][d] becomes the offset where chunk t starts writing in ind[d].
+                    for (std::size_t j = 0; j < n; ++j) {
+                        std::size_t total = 0;
+                        for (std::size_t t = 0; t < nthreads; ++t) {
+                            const std::size_t c = counts[t][j];
+                            counts[t][j] = total;
+                            total += c;
+                        }
+                        ind[j].resize(total);
+                        if (j < n - 1) ptr[j].resize(total);
+                    }
+
+                    // Pass 2: fill ind[d]/ptr[d] at the computed offsets.
+                    _parallel_chunks_(m, nthreads, [&](std::size_t t, std::size_t first, std::size_t last) {
+                        std::vector<std::size_t>& off = counts[t];
+                        for (std::size_t i = first; i < last; ++i) {
+                            const std::uint64_t* c = coords + i * n;
+                            for (std::size_t j = div[i]; j < n; ++j) {
+                                ind[j][off[j]] = c[j];
+                                if (j < n - 1) {
+                                    // The first child of this node is the entry this row adds to ind[j+1].
+                                    ptr[j][off[j]] = off[j + 1];
+                                }
+                                off[j]++;
+                            }
+                        }
+                    });
+                    last_coord.assign(coords + (m - 1) * n, coords + m * n);
+                    is_first_insertion = false;
+                    seal();
+                }
+
+                /**
+                 * @brief A range [first,last) of sibling nodes at a given level; it spans every leaf below those nodes.
+                 */
+                struct WorkUnit {
+                    std::size_t level;
+                    std::size_t first;
+                    std::size_t last;
+                };
+
+                /**
+                 * @brief Maps position i of ind[level] (possibly its end) to the position of its first leaf within ind.back().
+                 */
+                inline std::size_t _leaf_begin_(std::size_t level, std::size_t i) const {
+                    for (; level + 1 < num_dims; ++level) {
+                        i = ptr_view[level][i];
+                    }
+                    return i;
+                }
+
+                /**
+                 * @brief Splits the tree into work units of about `target` leaves each. Runs of consecutive siblings are grouped, and a single node with more than `target` leaves is split recursively among its children (or into leaf chunks at the last level).
+                 */
+                void _partition_(const std::size_t level, const std::size_t first, const std::size_t last, const std::size_t target, std::vector<WorkUnit>& units) const {
+                    std::size_t i = first;
+                    while (i < last) {
+                        if (level + 1 == num_dims) {
+                            const std::size_t j = std::min(last, i + target);
+                            units.push_back({level, i, j});
+                            i = j;
+                            continue;
+                        }
+                        const std::size_t leaves = _leaf_begin_(level, i + 1) - _leaf_begin_(level, i);
+                        if (leaves > target) {
+                            // Skewed node: descend into its children.
+                            _partition_(level + 1, ptr_view[level][i], ptr_view[level][i + 1], target, units);
+                            i++;
+                            continue;
+                        }
+                        // Group consecutive siblings up to `target` leaves (without swallowing a node that must be split).
+                        const std::size_t base = _leaf_begin_(level, i);
+                        std::size_t j = i + 1;
+                        while (j < last && _leaf_begin_(level, j + 1) - base <= target) {
+                            j++;
+                        }
+                        units.push_back({level, i, j});
+                        i = j;
+                    }
+                }
+
+                /**
+                 * @brief Visits every coordinate below the nodes of `u` as f(coord), using caller-provided traversal arrays I, J and c (of num_dims cells each).
+                 */
+                template<typename F> void _walk_(const WorkUnit& u, std::size_t* I, std::size_t* J, std::uint64_t* c, F&& f) const {
+                    // Rebuild the shared prefix of the unit by locating the ancestors of its first node.
+                    std::size_t child = u.first;
+                    for (std::size_t k = u.level; k-- > 0;) {
+                        const std::uint64_t* p = ptr_view[k].data();
+                        const std::size_t parent = std::upper_bound(p, p + ind_view[k].size(), static_cast<std::uint64_t>(child)) - p - 1;
+                        c[k] = ind_view[k][parent];
+                        child = parent;
+                    }
+                    const std::size_t leaf = num_dims - 1;
+                    std::size_t d = u.level;
+                    I[d] = u.first;
+                    J[d] = u.last;
+                    while (true) {
+                        if (I[d] < J[d]) {
+                            if (d == leaf) {
+                                const std::uint64_t* a = ind_view[d].data();
+                                for (std::size_t i = I[d]; i < J[d]; ++i) {
+                                    c[d] = a[i];
+                                    f(static_cast<const std::uint64_t*>(c));
+                                }
+                                I[d] = J[d];
+                            } else {
+                                c[d] = ind_view[d][I[d]];
+                                I[d + 1] = ptr_view[d][I[d]];
+                                J[d + 1] = ptr_view[d][I[d] + 1];
+                                d++;
+                            }
+                        } else {
+                            if (d == u.level) return;
+                            d--;
+                            I[d]++;
+                        }
+                    }
+                }
+
+                /**
+                 * @brief Maps position i of ind[from] (possibly its end) to the position of its first descendant within ind[to].
+                 */
+                inline std::size_t _descendant_begin_(std::size_t from, std::size_t i, const std::size_t to) const {
+                    for (; from < to; ++from) {
+                        i = ptr_view[from][i];
+                    }
+                    return i;
+                }
+
+                /**
+                 * @brief Groups consecutive root nodes into work units of about `target` leaves each; a root is never split, so every unit owns whole top-level subtrees.
+                 */
+                std::vector<WorkUnit> _root_units_(const std::size_t target) const {
+                    std::vector<WorkUnit> units;
+                    const std::size_t roots = ind_view[0].size();
+                    std::size_t i = 0;
+                    while (i < roots) {
+                        const std::size_t base = _leaf_begin_(0, i);
+                        std::size_t j = i + 1;
+                        while (j < roots && _leaf_begin_(0, j + 1) - base <= target) {
+                            j++;
+                        }
+                        units.push_back({0, i, j});
+                        i = j;
+                    }
+                    return units;
+                }
+
+                /**
+                 * @brief Runs f(t, unit) for every unit on `nthreads` threads that pick units dynamically.
+                 */
+                template<typename F> static void _run_units_(const std::vector<WorkUnit>& units, const std::size_t nthreads, F&& f) {
+                    std::atomic<std::size_t> next_unit(0);
+                    auto worker = [&](const std::size_t t) {
+                        for (std::size_t u = next_unit++; u < units.size(); u = next_unit++) {
+                            f(t, units[u]);
+                        }
+                    };
+                    if (nthreads <= 1) {
+                        worker(0);
+                        return;
+                    }
+                    std::vector<std::thread> workers;
+                    workers.reserve(nthreads);
+                    for (std::size_t t = 0; t < nthreads; ++t) {
+                        workers.emplace_back(worker, t);
+                    }
+                    for (auto& w : workers) {
+                        w.join();
+                    }
+                }
+
+                /**
+                 * @brief Returns sum_j values[j] * v[idx[j]] over a leaf fiber of `length` entries; `values` may be null (all ones).
+                 */
+                static inline double _fiber_dot_(const double* values, const std::uint64_t* idx, const double* v, const std::size_t length) {
+                    std::size_t j = 0;
+                    double sum = 0.0;
+#if defined(__AVX2__)
+                    __m256d acc = _mm256_setzero_pd();
+                    for (; j + 4 <= length; j += 4) {
+                        const __m256d g = _mm256_i64gather_pd(v, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + j)), 8);
+                        acc = _mm256_add_pd(acc, (values != nullptr) ? _mm256_mul_pd(g, _mm256_loadu_pd(values + j)) : g);
+                    }
+                    double lanes[4];
+                    _mm256_storeu_pd(lanes, acc);
+                    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+                    for (; j < length; ++j) {
+                        sum += (values != nullptr) ? values[j] * v[idx[j]] : v[idx[j]];
+                    }
+                    return sum;
+                }
+
+                /**
+                 * @brief y[r] += a[r] * x[r] for r in [0,R); `a` may be null (all ones).
+                 */
+                static inline void _fma_row_(const double* a, const double* x, double* y, const std::size_t R) {
+                    std::size_t r = 0;
+#if defined(__AVX2__)
+                    for (; r + 4 <= R; r += 4) {
+                        const __m256d p = (a != nullptr) ? _mm256_mul_pd(_mm256_loadu_pd(a + r), _mm256_loadu_pd(x + r)) : _mm256_loadu_pd(x + r);
+                        _mm256_storeu_pd(y + r, _mm256_add_pd(_mm256_loadu_pd(y + r), p));
+                    }
+#endif
+                    for (; r < R; ++r) {
+                        y[r] += (a != nullptr) ? a[r] * x[r] : x[r];
+                    }
+                }
+
+                /**
+                 * @brief y[r] += s * x[r] for r in [0,R).
+                 */
+                static inline void _axpy_row_(const double s, const double* x, double* y, const std::size_t R) {
+                    std::size_t r = 0;
+#if defined(__AVX2__)
+                    const __m256d vs = _mm256_set1_pd(s);
+                    for (; r + 4 <= R; r += 4) {
+                        _mm256_storeu_pd(y + r, _mm256_add_pd(_mm256_loadu_pd(y + r), _mm256_mul_pd(vs, _mm256_loadu_pd(x + r))));
+                    }
+#endif
+                    for (; r < R; ++r) {
+                        y[r] += s * x[r];
+                    }
+                }
+
+                /**
+                 * @brief Computes out[r] = sum over the leaves below `node` (at `level`) of value * prod_{k>level} U[k](i_k, r). `scratch` holds num_dims*R doubles.
+                 */
+                void _mttkrp_subtree_(const std::size_t level, const std::size_t node, const double* const* U, const std::size_t R, const double* values, double* out, double* scratch) const {
+                    std::fill(out, out + R, 0.0);
+                    const std::size_t first = ptr_view[level][node], last = ptr_view[level][node + 1];
+                    const std::uint64_t* idx = ind_view[level + 1].data();
+                    if (level + 2 == num_dims) {
+                        // LEAF FIBER: out += value * U[N-1](i, :) for every leaf.
+                        for (std::size_t j = first; j < last; ++j) {
+                            _axpy_row_((values != nullptr) ? values[j] : 1.0, U[level + 1] + idx[j] * R, out, R);
+                        }
+                        return;
+                    }
+                    double* child = scratch + (level + 1) * R;
+                    for (std::size_t j = first; j < last; ++j) {
+                        _mttkrp_subtree_(level + 1, j, U, R, values, child, scratch);
+                        _fma_row_(U[level + 1] + idx[j] * R, child, out, R);
+                    }
+                }
+
+                /**
+                 * @brief Accumulates into M the MTTKRP contributions of the nodes at level `mode` below `node` (at `level`); `top` holds the Hadamard product of the factor rows of the ancestors at levels < level.
+                 */
+                void _mttkrp_descend_(const std::size_t level, const std::size_t node, const std::size_t mode, const double* const* U, const std::size_t R, const double* values, double* M, const double* top, double* tops, double* bottom, double* scratch) const {
+                    const std::uint64_t i = ind_view[level][node];
+                    if (level == mode) {
+                        if (level + 1 == num_dims) {
+                            // Leaf mode: M(i,:) += value * top.
+                            const double s = (values != nullptr) ? values[node] : 1.0;
+                            if (top != nullptr) {
+                                _axpy_row_(s, top, M + i * R, R);
+                            } else {
+                                for (std::size_t r = 0; r < R; ++r) M[i * R + r] += s;
+                            }
+                            return;
+                        }
+                        _mttkrp_subtree_(level, node, U, R, values, bottom, scratch);
+                        _fma_row_(top, bottom, M + i * R, R);
+                        return;
+                    }
+                    // Extend the top-down product with U[level](i,:) and branch down.
+                    double* next_top = tops + level * R;
+                    const double* row = U[level] + i * R;
+                    for (std::size_t r = 0; r < R; ++r) {
+                        next_top[r] = (top != nullptr) ? top[r] * row[r] : row[r];
+                    }
+                    for (std::size_t j = ptr_view[level][node]; j < ptr_view[level][node + 1]; ++j) {
+                        _mttkrp_descend_(level + 1, j, mode, U, R, values, M, next_top, tops, bottom, scratch);
+                    }
+                }
+
             public:
+                static constexpr std::size_t UNITS_PER_THREAD = 8; // Work units created per thread by parallel_for_each(), to balance the load dynamically.
+
                 /**
                  * @brief Constructor for dynamic insertion
                  * @param n Number of dimensions
                  */
-                CSMR(std::size_t n) : num_dims(n), is_sealed(false), is_first_insertion(true), max_coord_val(0) {
+                CSMR(std::size_t n) : num_dims(n), is_sealed(false), is_first_insertion(true), max_coord_val(0), d(0), _has_next(false) {
                     if (n == 0) throw std::invalid_argument("Dimensions must be > 0");
                     ind.resize(n);
                     if (n > 1) ptr.resize(n - 1);
@@ -266,6 +761,28 @@ namespace samg {
                     current_coord.resize(n, 0);
                 }
 
+                CSMR(const CSMR& other) :
+                    num_dims(other.num_dims), is_sealed(other.is_sealed), is_first_insertion(other.is_first_insertion),
+                    last_coord(other.last_coord), max_coord_val(other.max_coord_val), ind(other.ind), ptr(other.ptr),
+                    ind_view(other.ind_view), ptr_view(other.ptr_view), mapping(other.mapping),
+                    I(other.I), J(other.J), current_coord(other.current_coord), d(other.d),
+                    _has_next(other._has_next) {
+                    // Views must refer to this copy's arrays, not to the ones of `other`.
+                    if (is_sealed) _bind_views_();
+                }
+
+                CSMR(CSMR&& other) = default;
+
+                CSMR& operator=(const CSMR& other) {
+                    if (this != &other) {
+                        CSMR tmp(other);
+                        *this = std::move(tmp);
+                    }
+                    return *this;
+                }
+
+                CSMR& operator=(CSMR&& other) = default;
+
                 /**
                  * @brief Constructor for bulk loading
                  * @param n Number of dimensions
@@ -278,6 +795,115 @@ namespace samg {
                     seal();
                 }
 
+                /**
+                 * @brief Parallel constructor for bulk loading.
+                 * @param n Number of dimensions
+                 * @param coords m n-dimensional coordinates stored contiguously, i.e., coords[i*n+j] is the j-th component of the i-th coordinate (must be lexicographically sorted)
+                 * @param m Number of coordinates
+                 * @param nthreads Number of threads used to build the structure
+                 */
+                CSMR(std::size_t n, const std::uint64_t* coords, const std::size_t m, const std::size_t nthreads = std::thread::hardware_concurrency()) : CSMR(n) {
+                    if (n > std::numeric_limits<std::uint8_t>::max()) throw std::invalid_argument("Dimensions must be < 256 for bulk loading.");
+                    _bulk_load_(coords, m, nthreads);
+                }
+
+                /**
+                 * @brief Parallel constructor for bulk loading from a reader. Entries are sorted in parallel if the reader does not deliver them in lexicographical order.
+                 * @param reader Reader to exhaust
+                 * @param nthreads Number of threads used to build the structure
+                 */
+                CSMR(samg::matutx::reader::Reader& reader, std::size_t nthreads = std::thread::hardware_concurrency()) : CSMR(reader.get_number_of_dimensions()) {
+                    const std::size_t n = num_dims;
+                    if (n > std::numeric_limits<std::uint8_t>::max()) throw std::invalid_argument("Dimensions must be < 256 for bulk loading.");
+                    std::vector<std::uint64_t> coords;
+                    coords.reserve(reader.get_number_of_entries() * n);
+                    bool sorted = true;
+                    while (reader.has_next()) {
+                        const std::vector<std::uint64_t> c = reader.next();
+                        if (c.size() != n) throw std::invalid_argument("Coordinate dimension mismatch.");
+                        if (sorted && !coords.empty()) {
+                            sorted = !std::lexicographical_compare(c.begin(), c.end(), coords.end() - n, coords.end());
+                        }
+                        coords.insert(coords.end(), c.begin(), c.end());
+                    }
+                    const std::size_t m = coords.size() / n;
+                    nthreads = std::max<std::size_t>(1, std::min(nthreads, m));
+                    if (!sorted) {
+                        _sort_rows_(coords, n, m, nthreads);
+                    }
+                    _bulk_load_(coords.data(), m, nthreads);
+                }
+
+                static constexpr std::size_t MAX_EXHAUSTIVE_DIMS = 6; // Up to this number of dimensions, estimate_mode_order() tries every permutation.
+
+                /**
+                 * @brief Builds a CSMR over m coordinates (in any order) stored contiguously in `coords`, with their modes reordered by `perm`, i.e., the k-th component of every stored coordinate is the perm[k]-th component of the input one. Queries on the result must be expressed in the permuted order.
+                 * @note Rows are permuted and sorted with a parallel radix sort before bulk loading.
+                 */
+                static CSMR build_permuted(const std::size_t n, const std::uint64_t* coords, const std::size_t m, const std::vector<std::size_t>& perm, std::size_t nthreads = std::thread::hardware_concurrency()) {
+                    if (perm.size() != n) throw std::invalid_argument("Permutation dimension mismatch.");
+                    std::vector<std::uint8_t> seen(n, 0);
+                    for (const auto k : perm) {
+                        if (k >= n || seen[k]) throw std::invalid_argument("Invalid mode permutation.");
+                        seen[k] = 1;
+                    }
+                    nthreads = std::max<std::size_t>(1, std::min(nthreads, m));
+                    std::vector<std::uint64_t> rows(n * m);
+                    _parallel_chunks_(m, nthreads, [&](std::size_t, std::size_t first, std::size_t last) {
+                        for (std::size_t i = first; i < last; ++i) {
+                            for (std::size_t k = 0; k < n; ++k) rows[i * n + k] = coords[i * n + perm[k]];
+                        }
+                    });
+                    _sort_rows_(rows, n, m, nthreads);
+                    return CSMR(n, rows.data(), m, nthreads);
+                }
+
+                /**
+                 * @brief Estimates the mode order that yields the most compact CSMR for the m coordinates stored contiguously in `coords`, by building the prefix tree of a random sample of `sample_size` rows under candidate orders and counting internal nodes.
+                 * @note Every permutation is tried up to `MAX_EXHAUSTIVE_DIMS` dimensions; beyond that, modes are ordered by increasing number of distinct values within the sample.
+                 * 
+                 * @return The permutation to pass to `build_permuted(...)`.
+                 */
+                static std::vector<std::size_t> estimate_mode_order(const std::size_t n, const std::uint64_t* coords, const std::size_t m, const std::size_t sample_size = 1ZU << 16) {
+                    std::vector<std::size_t> perm(n);
+                    for (std::size_t k = 0; k < n; ++k) perm[k] = k;
+                    if (m == 0 || n == 1) return perm;
+                    std::vector<std::uint64_t> sample;
+                    if (m <= sample_size) {
+                        sample.assign(coords, coords + n * m);
+                    } else {
+                        std::mt19937_64 rng(m);
+                        std::uniform_int_distribution<std::size_t> pick(0, m - 1);
+                        sample.reserve(n * sample_size);
+                        for (std::size_t i = 0; i < sample_size; ++i) {
+                            const std::uint64_t* c = coords + pick(rng) * n;
+                            sample.insert(sample.end(), c, c + n);
+                        }
+                    }
+                    if (n <= MAX_EXHAUSTIVE_DIMS) {
+                        std::vector<std::size_t> best = perm;
+                        std::size_t best_nodes = std::numeric_limits<std::size_t>::max();
+                        do {
+                            const std::size_t nodes = _count_internal_nodes_(sample, n, perm);
+                            if (nodes < best_nodes) {
+                                best_nodes = nodes;
+                                best = perm;
+                            }
+                        } while (std::next_permutation(perm.begin(), perm.end()));
+                        return best;
+                    }
+                    const std::size_t s = sample.size() / n;
+                    std::vector<std::size_t> cardinality(n);
+                    std::vector<std::uint64_t> column(s);
+                    for (std::size_t k = 0; k < n; ++k) {
+                        for (std::size_t i = 0; i < s; ++i) column[i] = sample[i * n + k];
+                        std::sort(column.begin(), column.end());
+                        cardinality[k] = std::unique(column.begin(), column.end()) - column.begin();
+                    }
+                    std::stable_sort(perm.begin(), perm.end(), [&cardinality](std::size_t a, std::size_t b) { return cardinality[a] < cardinality[b]; });
+                    return perm;
+                }
+
                 /**
                  * @brief Adds a coordinate dynamically.
                  * Coordinates MUST be added in lexicographical order.
@@ -339,22 +965,22 @@ namespace samg {
 
                     // Iteratively search through the dimensions
                     std::size_t start_idx = 0;
-                    std::size_t end_idx = ind[0].size();
+                    std::size_t end_idx = ind_view[0].size();
 
                     for (std::size_t d = 0; d < num_dims; ++d) {
                         // Binary search for the current dimension's value in the valid range
-                        auto it = std::lower_bound(ind[d].begin() + start_idx, ind[d].begin() + end_idx, coord[d]);
+                        auto it = std::lower_bound(ind_view[d].begin() + start_idx, ind_view[d].begin() + end_idx, coord[d]);
 
-                        if (it == (ind[d].begin() + end_idx) || *it != coord[d]) {
+                        if (it == (ind_view[d].begin() + end_idx) || *it != coord[d]) {
                             // Value not found in this dimension's segment
                             return false;
                         }
 
                         // If found, update the search range for the next dimension
                         if (d < num_dims - 1) {
-                            std::size_t current_idx = std::distance(ind[d].begin(), it);
-                            start_idx = ptr[d][current_idx];
-                            end_idx = (current_idx + 1 < ptr[d].size()) ? ptr[d][current_idx + 1] : ind[d + 1].size();
+                            std::size_t current_idx = std::distance(ind_view[d].begin(), it);
+                            start_idx = ptr_view[d][current_idx];
+                            end_idx = (current_idx + 1 < ptr_view[d].size()) ? ptr_view[d][current_idx + 1] : ind_view[d + 1].size();
                         }
                     }
 
@@ -362,6 +988,100 @@ namespace samg {
                     return true;
                 }
 
+                /**
+                 * @brief Checks the membership of `n` coordinates stored contiguously in `coords` (i.e., coords[i*num_dims+j] is the j-th component of the i-th query) and writes the answers to `out`.
+                 * @note Queries are sorted so that shared prefixes are resolved once, and processed `BATCH_LANES` at a time in lockstep, one dimension per round, prefetching the child range of each query before the next round. Short sibling ranges are scanned linearly (with AVX2 when available) instead of binary searched.
+                 * @note The structure must be sealed before calling this.
+                 */
+                void contains_batch(const std::uint64_t* coords, const std::size_t n, bool* out) {
+                    if (!is_sealed) {
+                        throw std::logic_error("Cannot check if a coordinate exists within an unsealed structure. Call restart() or next() first.");
+                    }
+                    const std::size_t nd = num_dims;
+                    auto row = [coords, nd](const std::size_t q) { return coords + q * nd; };
+
+                    // Group queries by their leading component (LSD radix sort of a permutation) so shared prefixes are adjacent.
+                    // NOTE: Leading components above max_coord_val cannot match and are clamped to max_coord_val+1, which bounds the number of passes.
+                    const std::uint64_t clamp = max_coord_val + 1;
+                    std::vector<std::size_t> perm(n), tmp(n);
+                    std::vector<std::uint64_t> keys(n), tmp_keys(n);
+                    for (std::size_t q = 0; q < n; ++q) {
+                        perm[q] = q;
+                        keys[q] = std::min(row(q)[0], clamp);
+                    }
+                    for (std::size_t shift = 0; shift < static_cast<std::size_t>(std::bit_width(clamp)); shift += 8) {
+                        std::size_t bucket[257] = {0};
+                        for (std::size_t q = 0; q < n; ++q) bucket[((keys[q] >> shift) & 0xFF) + 1]++;
+                        for (std::size_t r = 1; r < 257; ++r) bucket[r] += bucket[r - 1];
+                        for (std::size_t q = 0; q < n; ++q) {
+                            const std::size_t r = bucket[(keys[q] >> shift) & 0xFF]++;
+                            tmp[r] = perm[q];
+                            tmp_keys[r] = keys[q];
+                        }
+                        perm.swap(tmp);
+                        keys.swap(tmp_keys);
+                    }
+
+                    // Per-lane state: current range [lo,hi) within ind[d] and whether the query is still alive.
+                    std::size_t lo[BATCH_LANES], hi[BATCH_LANES], lcp[BATCH_LANES];
+                    bool alive[BATCH_LANES];
+                    // State of the last query of the previous batch after each dimension, so the next batch can share its prefix.
+                    std::vector<std::size_t> carry_lo(nd, 0), carry_hi(nd, 0);
+                    std::vector<std::uint8_t> carry_alive(nd, 0);
+
+                    for (std::size_t b = 0; b < n; b += BATCH_LANES) {
+                        const std::size_t lanes = std::min(BATCH_LANES, n - b);
+                        for (std::size_t j = 0; j < lanes; ++j) {
+                            lo[j] = 0;
+                            hi[j] = ind_view[0].size();
+                            alive[j] = true;
+                            // Longest common prefix with the previous query in sorted order.
+                            std::size_t k = 0;
+                            if (b + j > 0) {
+                                const std::uint64_t* c = row(perm[b + j]);
+                                const std::uint64_t* p = row(perm[b + j - 1]);
+                                while (k < nd && c[k] == p[k]) k++;
+                            }
+                            lcp[j] = k;
+                        }
+                        for (std::size_t d = 0; d < nd; ++d) {
+                            for (std::size_t j = 0; j < lanes; ++j) {
+                                if (!alive[j]) continue;
+                                if (lcp[j] > d) {
+                                    // Same prefix up to d as the previous query: reuse its outcome.
+                                    if (j > 0) {
+                                        alive[j] = alive[j - 1];
+                                        lo[j] = lo[j - 1];
+                                        hi[j] = hi[j - 1];
+                                    } else {
+                                        alive[j] = carry_alive[d];
+                                        lo[j] = carry_lo[d];
+                                        hi[j] = carry_hi[d];
+                                    }
+                                    continue;
+                                }
+                                const std::size_t idx = _find_(ind_view[d].data(), lo[j], hi[j], row(perm[b + j])[d]);
+                                if (idx == hi[j]) {
+                                    alive[j] = false;
+                                } else if (d < nd - 1) {
+                                    lo[j] = ptr_view[d][idx];
+                                    hi[j] = ptr_view[d][idx + 1];
+                                    __builtin_prefetch(ind_view[d + 1].data() + lo[j]);
+                                    if (d + 1 < nd - 1) {
+                                        __builtin_prefetch(ptr_view[d + 1].data() + lo[j]);
+                                    }
+                                }
+                            }
+                            carry_alive[d] = alive[lanes - 1];
+                            carry_lo[d] = lo[lanes - 1];
+                            carry_hi[d] = hi[lanes - 1];
+                        }
+                        for (std::size_t j = 0; j < lanes; ++j) {
+                            out[perm[b + j]] = alive[j];
+                        }
+                    }
+                }
+
                 /**
                  * @brief Returns the number of dimensions of the space.
                  */
@@ -384,7 +1104,7 @@ namespace samg {
                     if (!is_sealed) {
                         throw std::logic_error("CSMR must be sealed before getting edge count. Call restart() or next() first.");
                     }
-                    return ind.empty() ? 0 : ind.back().size();
+                    return ind_view.empty() ? 0 : ind_view.back().size();
                 }
 
                 /**
@@ -393,7 +1113,7 @@ namespace samg {
                 void restart() {
                     if (!is_sealed) seal();
 
-                    if (ind[0].empty()) {
+                    if (ind_view[0].empty()) {
                         _has_next = false;
                         return;
                     }
@@ -403,10 +1123,10 @@ namespace samg {
                     std::fill(current_coord.begin(), current_coord.end(), 0);
 
                     d = 0;
-                    J[0] = ind[0].size();
+                    J[0] = ind_view[0].size();
                     
                     // Prime the pump! Find and cache the very first element immediately.
-                    advance(); 
+                    _advance_(); 
                 }
 
                 /**
@@ -428,15 +1148,732 @@ namespace samg {
                     if (!_has_next) throw std::out_of_range("No more coordinates available.");
                     
                     // 1. Grab the cached result
-                    // Using move semantics to avoid a copy if _next_result is not needed afterward.
-                    std::vector<std::uint64_t> result = std::move(_next_result);
+                    std::vector<std::uint64_t> result = current_coord;
                     
                     // 2. Immediately pre-fetch the next one so _has_next updates instantly
-                    advance(); 
+                    _advance_(); 
                     
                     return result;
                 }
 
+                /**
+                 * @brief Returns the current coordinate of the sequence without copying it. It is valid while `has_next()` is true and until the next call to `advance()`/`next()`/`restart()`.
+                 */
+                const std::uint64_t* current() const {
+                    return current_coord.data();
+                }
+
+                /**
+                 * @brief Moves the cursor to the next coordinate of the sequence.
+                 * 
+                 * @return true if `current()` holds a valid coordinate afterwards.
+                 */
+                bool advance() {
+                    if (!_has_next) throw std::out_of_range("No more coordinates available.");
+                    _advance_();
+                    return _has_next;
+                }
+
+                /**
+                 * @brief Visits every coordinate, in lexicographical order, as f(const std::uint64_t* coord) without allocating memory.
+                 * @note It seals the structure if needed and resets the sequential iterator, which is left exhausted.
+                 */
+                template<typename F> void for_each(F&& f) {
+                    if (!is_sealed) seal();
+                    _has_next = false;
+                    if (ind_view[0].empty()) return;
+                    const std::size_t leaf = num_dims - 1;
+                    std::uint64_t* c = current_coord.data();
+                    d = 0;
+                    I[0] = 0;
+                    J[0] = ind_view[0].size();
+                    while (true) {
+                        if (I[d] < J[d]) {
+                            if (d == leaf) {
+                                // LEAF LEVEL: Visit the whole sibling run in a tight loop.
+                                const std::uint64_t* a = ind_view[d].data();
+                                for (std::size_t i = I[d]; i < J[d]; ++i) {
+                                    c[d] = a[i];
+                                    f(static_cast<const std::uint64_t*>(c));
+                                }
+                                I[d] = J[d];
+                            } else {
+                                c[d] = ind_view[d][I[d]];
+                                I[d + 1] = ptr_view[d][I[d]];
+                                J[d + 1] = ptr_view[d][I[d] + 1];
+                                d++;
+                            }
+                        } else {
+                            if (d == 0) return;
+                            d--;
+                            I[d]++;
+                        }
+                    }
+                }
+
+                /**
+                 * @brief Iterator over the coordinates lying within an n-dimensional box, i.e., per-dimension inclusive bounds [lo[d],hi[d]].
+                 * @note At every level the sibling range is narrowed to [lo[d],hi[d]] with binary search, so subtrees outside the box are never visited. Coordinates are written into a caller buffer; no memory is allocated after construction.
+                 * @note The iterated `CSMR` must be sealed and outlive the iterator.
+                 */
+                class BoxIterator {
+                private:
+                    const CSMR* csmr;
+                    std::vector<std::uint64_t> lo, hi;
+                    std::vector<std::size_t> I; // I[d] is the current node within ind[d].
+                    std::vector<std::size_t> J; // J[d] is the end of the (narrowed) sibling range within ind[d].
+                    std::size_t d;
+                    bool exhausted;
+
+                    /**
+                     * @brief Narrows [I[k],J[k]) to the positions whose values lie within [lo[k],hi[k]].
+                     */
+                    inline void _narrow_(const std::size_t k) {
+                        const std::uint64_t* a = csmr->ind_view[k].data();
+                        I[k] = std::lower_bound(a + I[k], a + J[k], lo[k]) - a;
+                        J[k] = std::upper_bound(a + I[k], a + J[k], hi[k]) - a;
+                    }
+
+                public:
+                    BoxIterator(const CSMR& csmr, const std::uint64_t* lo, const std::uint64_t* hi) :
+                        csmr(&csmr),
+                        lo(lo, lo + csmr.num_dims),
+                        hi(hi, hi + csmr.num_dims),
+                        I(csmr.num_dims, 0),
+                        J(csmr.num_dims, 0),
+                        d(0),
+                        exhausted(false)
+                    {
+                        if (!csmr.is_sealed) throw std::logic_error("Cannot iterate over an unsealed structure. Call restart() or next() first.");
+                        restart();
+                    }
+
+                    /**
+                     * @brief Restarts the iteration from the first coordinate within the box.
+                     */
+                    void restart() {
+                        d = 0;
+                        I[0] = 0;
+                        J[0] = csmr->ind_view[0].size();
+                        exhausted = false;
+                        for (std::size_t k = 0; k < lo.size(); ++k) {
+                            if (lo[k] > hi[k]) exhausted = true;
+                        }
+                        if (!exhausted) _narrow_(0);
+                    }
+
+                    /**
+                     * @brief Writes up to `max_entries` coordinates into `out`, contiguously (i.e., out[i*n+j] is the j-th component of the i-th coordinate); `out` must have room for max_entries*n values.
+                     * 
+                     * @return The number of coordinates written; 0 means the iteration is over.
+                     */
+                    std::size_t next(std::uint64_t* out, const std::size_t max_entries) {
+                        const std::size_t n = lo.size();
+                        const auto& ind_view = csmr->ind_view;
+                        const auto& ptr_view = csmr->ptr_view;
+                        std::size_t count = 0;
+                        while (!exhausted && count < max_entries) {
+                            if (I[d] < J[d]) {
+                                if (d == n - 1) {
+                                    // LEAF LEVEL: Every sibling left in the narrowed range is within the box.
+                                    const std::size_t m = std::min(J[d] - I[d], max_entries - count);
+                                    for (std::size_t i = 0; i < m; ++i, ++count) {
+                                        std::uint64_t* c = out + count * n;
+                                        for (std::size_t k = 0; k < d; ++k) c[k] = ind_view[k][I[k]];
+                                        c[d] = ind_view[d][I[d] + i];
+                                    }
+                                    I[d] += m;
+                                } else {
+                                    // INTERNAL NODE: Branch down into the part of its children within the box.
+                                    I[d + 1] = ptr_view[d][I[d]];
+                                    J[d + 1] = ptr_view[d][I[d] + 1];
+                                    d++;
+                                    _narrow_(d);
+                                }
+                            } else {
+                                // EXHAUSTION: Backtrack
+                                if (d == 0) {
+                                    exhausted = true;
+                                    break;
+                                }
+                                d--;
+                                I[d]++;
+                            }
+                        }
+                        return count;
+                    }
+
+                    bool has_next() const {
+                        return !exhausted;
+                    }
+                };
+
+                /**
+                 * @brief Visits every coordinate as f(t, coord) using `nthreads` threads, where t is the index of the calling thread (useful for per-thread accumulators) and coord points to num_dims components.
+                 * @note The tree is split into work units balanced by leaf count, which threads pick dynamically; every coordinate is visited exactly once, but in no particular global order. `f` must be safe to call concurrently from different threads.
+                 * @note The structure must be sealed before calling this.
+                 */
+                template<typename F> void parallel_for_each(std::size_t nthreads, F&& f) const {
+                    if (!is_sealed) {
+                        throw std::logic_error("Cannot iterate over an unsealed structure. Call restart() or next() first.");
+                    }
+                    if (ind_view[0].empty()) return;
+                    nthreads = std::max<std::size_t>(1, nthreads);
+                    const std::size_t leaves = ind_view.back().size();
+                    const std::size_t target = std::max<std::size_t>(1, (leaves + nthreads * UNITS_PER_THREAD - 1) / (nthreads * UNITS_PER_THREAD));
+                    std::vector<WorkUnit> units;
+                    _partition_(0, 0, ind_view[0].size(), target, units);
+
+                    std::atomic<std::size_t> next_unit(0);
+                    auto worker = [&](const std::size_t t) {
+                        std::vector<std::size_t> I(num_dims), J(num_dims);
+                        std::vector<std::uint64_t> c(num_dims);
+                        auto visit = [&f, t](const std::uint64_t* coord) { f(t, coord); };
+                        for (std::size_t u = next_unit++; u < units.size(); u = next_unit++) {
+                            _walk_(units[u], I.data(), J.data(), c.data(), visit);
+                        }
+                    };
+                    if (nthreads == 1) {
+                        worker(0);
+                        return;
+                    }
+                    std::vector<std::thread> workers;
+                    workers.reserve(nthreads);
+                    for (std::size_t t = 0; t < nthreads; ++t) {
+                        workers.emplace_back(worker, t);
+                    }
+                    for (auto& w : workers) {
+                        w.join();
+                    }
+                }
+
+                /**
+                 * @brief Tensor-times-vector along the last mode: y(i_0,...,i_{N-2}) = sum_{i_{N-1}} X(i_0,...,i_{N-1}) * v[i_{N-1}].
+                 * @note The result has one value per fiber, i.e., it is parallel to ind[N-2] (a single value for N = 1). Fibers are processed by threads over top-level subtrees balanced by leaf count, with SIMD gathers on each leaf fiber.
+                 * @note The structure must be sealed before calling this.
+                 * 
+                 * @param v Dense vector indexed by the last mode (at least get_number_of_nodes() cells).
+                 * @param values Nonzero values parallel to ind.back(), or null for a pattern tensor (all ones).
+                 * @param nthreads Number of threads.
+                 * @return std::vector<double> 
+                 */
+                std::vector<double> ttv(const double* v, const double* values = nullptr, std::size_t nthreads = std::thread::hardware_concurrency()) const {
+                    if (!is_sealed) {
+                        throw std::logic_error("Cannot compute on an unsealed structure. Call restart() or next() first.");
+                    }
+                    const std::uint64_t* idx = ind_view.back().data();
+                    if (num_dims == 1) {
+                        return { _fiber_dot_(values, idx, v, ind_view[0].size()) };
+                    }
+                    const std::size_t fiber_level = num_dims - 2;
+                    const std::uint64_t* fp = ptr_view[fiber_level].data();
+                    std::vector<double> y(ind_view[fiber_level].size(), 0.0);
+                    if (y.empty()) return y;
+                    nthreads = std::max<std::size_t>(1, nthreads);
+                    const std::size_t target = std::max<std::size_t>(1, ind_view.back().size() / (nthreads * UNITS_PER_THREAD));
+                    _run_units_(_root_units_(target), nthreads, [&](std::size_t, const WorkUnit& u) {
+                        const std::size_t first = _descendant_begin_(0, u.first, fiber_level), last = _descendant_begin_(0, u.last, fiber_level);
+                        for (std::size_t f = first; f < last; ++f) {
+                            y[f] = _fiber_dot_((values != nullptr) ? values + fp[f] : nullptr, idx + fp[f], v, fp[f + 1] - fp[f]);
+                        }
+                    });
+                    return y;
+                }
+
+                /**
+                 * @brief Matricized tensor times Khatri-Rao product for mode `mode`: M(i_mode, r) = sum over nonzeros X(i) * prod_{k != mode} U[k](i_k, r).
+                 * @note Threads process top-level subtrees balanced by leaf count. For mode 0 every subtree owns its output row; for other modes each thread accumulates into a private copy of M that is reduced at the end. Leaf fibers use SIMD row updates.
+                 * @note The structure must be sealed before calling this.
+                 * 
+                 * @param mode Output mode (in the CSMR's mode order).
+                 * @param U Row-major factor matrices, one per mode, each with at least get_number_of_nodes() rows of R columns (U[mode] is ignored).
+                 * @param R Rank.
+                 * @param M Row-major output of get_number_of_nodes() rows of R columns; it is overwritten.
+                 * @param values Nonzero values parallel to ind.back(), or null for a pattern tensor (all ones).
+                 * @param nthreads Number of threads.
+                 */
+                void mttkrp(const std::size_t mode, const std::vector<const double*>& U, const std::size_t R, double* M, const double* values = nullptr, std::size_t nthreads = std::thread::hardware_concurrency()) const {
+                    if (!is_sealed) {
+                        throw std::logic_error("Cannot compute on an unsealed structure. Call restart() or next() first.");
+                    }
+                    if (mode >= num_dims || U.size() != num_dims) throw std::invalid_argument("Mode or factor matrices mismatch.");
+                    const std::size_t rows = get_number_of_nodes();
+                    std::fill(M, M + rows * R, 0.0);
+                    if (ind_view[0].empty() || R == 0) return;
+                    nthreads = std::max<std::size_t>(1, nthreads);
+                    const std::size_t target = std::max<std::size_t>(1, ind_view.back().size() / (nthreads * UNITS_PER_THREAD));
+                    const std::vector<WorkUnit> units = _root_units_(target);
+                    nthreads = std::min(nthreads, units.size());
+                    // Mode 0 writes disjoint rows per top-level subtree; other modes need per-thread outputs.
+                    std::vector<std::vector<double>> privates((mode == 0 || nthreads == 1) ? 0 : nthreads);
+                    std::vector<std::vector<double>> buffers(nthreads, std::vector<double>(3 * num_dims * R));
+                    _run_units_(units, nthreads, [&](std::size_t t, const WorkUnit& u) {
+                        double* out = M;
+                        if (!privates.empty()) {
+                            if (privates[t].empty()) privates[t].assign(rows * R, 0.0);
+                            out = privates[t].data();
+                        }
+                        double* tops = buffers[t].data();
+                        double* bottom = tops + num_dims * R;
+                        double* scratch = bottom + num_dims * R;
+                        for (std::size_t i = u.first; i < u.last; ++i) {
+                            _mttkrp_descend_(0, i, mode, U.data(), R, values, out, nullptr, tops, bottom, scratch);
+                        }
+                    });
+                    for (const auto& p : privates) {
+                        if (p.empty()) continue;
+                        _axpy_row_(1.0, p.data(), M, rows * R);
+                    }
+                }
+
+                /**
+                 * @brief Returns an iterator over the coordinates c such that lo[d] <= c[d] <= hi[d] for every dimension d.
+                 * @note The structure must be sealed before calling this.
+                 */
+                BoxIterator box(const std::uint64_t* lo, const std::uint64_t* hi) const {
+                    return BoxIterator(*this, lo, hi);
+                }
+
+                /**
+                 * @brief Saves the structure to a file that can be memory-mapped with `CSMR::map(...)`. It seals the structure if needed.
+                 * @note Layout (native endianness, all values std::uint64_t): a header with magic number, number of dimensions and maximum coordinate value, followed by |ind[0..n-1]| and |ptr[0..n-2]|; then every ind[d] and ptr[d] array, each starting at a `FILE_ALIGNMENT`-byte aligned offset.
+                 */
+                void save(const std::string& path) {
+                    seal();
+                    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                    if (!file) throw std::runtime_error("CSMR/save> Unable to open \"" + path + "\"!");
+                    std::vector<std::uint64_t> header = { FILE_MAGIC, num_dims, max_coord_val };
+                    for (const auto& v : ind_view) header.push_back(v.size());
+                    for (const auto& v : ptr_view) header.push_back(v.size());
+                    std::size_t offset = 0;
+                    auto write = [&file, &offset](const void* data, const std::size_t bytes) {
+                        file.write(static_cast<const char*>(data), bytes);
+                        offset += bytes;
+                    };
+                    auto pad = [&write, &offset]() {
+                        static const char zeros[FILE_ALIGNMENT] = {0};
+                        write(zeros, _align_(offset) - offset);
+                    };
+                    write(header.data(), header.size() * sizeof(std::uint64_t));
+                    for (const auto& v : ind_view) {
+                        pad();
+                        write(v.data(), v.size_bytes());
+                    }
+                    for (const auto& v : ptr_view) {
+                        pad();
+                        write(v.data(), v.size_bytes());
+                    }
+                    if (!file) throw std::runtime_error("CSMR/save> Unable to write \"" + path + "\"!");
+                }
+
+                /**
+                 * @brief Memory-maps a file written by `save(...)`. The returned structure is sealed and read-only, and its arrays are not copied: they are served directly from the page cache, which is shared by every process mapping the same file.
+                 * @note The file is validated before use: array sizes and offsets must fit the file, every ptr[k] must be non-decreasing, start at 0 and end at |ind[k+1]| (with |ptr[k]| = |ind[k]|+1), and no coordinate may exceed the stored maximum. Otherwise it throws `std::runtime_error`.
+                 */
+                static CSMR map(const std::string& path) {
+                    const int fd = ::open(path.c_str(), O_RDONLY);
+                    if (fd < 0) throw std::runtime_error("CSMR/map> Unable to open \"" + path + "\"!");
+                    struct stat st;
+                    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < 3 * sizeof(std::uint64_t)) {
+                        ::close(fd);
+                        throw std::runtime_error("CSMR/map> Malformed file \"" + path + "\"!");
+                    }
+                    const std::size_t length = static_cast<std::size_t>(st.st_size);
+                    void* addr = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+                    ::close(fd);
+                    if (addr == MAP_FAILED) throw std::runtime_error("CSMR/map> Unable to map \"" + path + "\"!");
+                    std::shared_ptr<void> mapping(addr, [length](void* p) { ::munmap(p, length); });
+
+                    const std::uint64_t* header = static_cast<const std::uint64_t*>(addr);
+                    const std::size_t n = header[1];
+                    // NOTE: Bounds are compared by division so that huge sizes cannot overflow past the checks.
+                    const std::size_t words = length / sizeof(std::uint64_t);
+                    if (header[0] != FILE_MAGIC || n == 0 || n > (words - 2) / 2) {
+                        throw std::runtime_error("CSMR/map> Malformed file \"" + path + "\"!");
+                    }
+                    CSMR csmr(n);
+                    csmr.mapping = mapping;
+                    csmr.max_coord_val = header[2];
+                    const std::uint64_t* sizes = header + 3;
+                    std::size_t offset = (2 * n + 2) * sizeof(std::uint64_t);
+                    auto view = [&](const std::size_t size) {
+                        offset = _align_(offset);
+                        if (offset > length || size > (length - offset) / sizeof(std::uint64_t)) {
+                            throw std::runtime_error("CSMR/map> Truncated file \"" + path + "\"!");
+                        }
+                        std::span<const std::uint64_t> v(reinterpret_cast<const std::uint64_t*>(static_cast<const char*>(addr) + offset), size);
+                        offset += size * sizeof(std::uint64_t);
+                        return v;
+                    };
+                    for (std::size_t k = 0; k < n; ++k) csmr.ind_view.push_back(view(sizes[k]));
+                    for (std::size_t k = 0; k + 1 < n; ++k) csmr.ptr_view.push_back(view(sizes[n + k]));
+
+                    // Check the invariants seal() guarantees, since every traversal relies on them to stay within bounds.
+                    auto malformed = [&path]() { return std::runtime_error("CSMR/map> Malformed file \"" + path + "\"!"); };
+                    const bool empty = csmr.ind_view[0].empty();
+                    for (std::size_t k = 0; k + 1 < n; ++k) {
+                        const auto& p = csmr.ptr_view[k];
+                        if (empty) {
+                            if (!p.empty() || !csmr.ind_view[k + 1].empty()) throw malformed();
+                            continue;
+                        }
+                        if (p.size() != csmr.ind_view[k].size() + 1 || p.front() != 0 || p.back() != csmr.ind_view[k + 1].size()) throw malformed();
+                        for (std::size_t i = 1; i < p.size(); ++i) {
+                            if (p[i] < p[i - 1]) throw malformed();
+                        }
+                    }
+                    for (const auto& v : csmr.ind_view) {
+                        for (const auto x : v) {
+                            if (x > csmr.max_coord_val) throw malformed();
+                        }
+                    }
+                    csmr.is_first_insertion = empty;
+                    csmr.is_sealed = true;
+                    return csmr;
+                }
+
+                /**
+                 * @brief Exhausts the structure to retrieve all coordinates.
+                 */
+                std::vector<std::vector<std::uint64_t>> get_sequence() {
+                    std::vector<std::vector<std::uint64_t>> full_sequence;
+                    restart();
+                    while (has_next()) {
+                        full_sequence.push_back(next());
+                    }
+                    return full_sequence;
+                }
+            };
+
+            /**
+             * @brief A fixed-width bit-packed array of unsigned integers. Values are stored LSB-first across 64-bit words.
+             */
+            class PackedArray {
+            private:
+                std::vector<std::uint64_t> words;
+                std::size_t length;
+                std::uint8_t width;
+                std::uint64_t mask;
+
+            public:
+                PackedArray() : length(0), width(0), mask(0) {}
+
+                /**
+                 * @brief Packs `values` using `width` bits per value.
+                 * @note Every value must fit in `width` bits.
+                 */
+                PackedArray(std::span<const std::uint64_t> values, const std::uint8_t width) :
+                    length(values.size()),
+                    width(width),
+                    mask(width >= 64 ? ~0ULL : ((1ULL << width) - 1ULL))
+                {
+                    if (width > 64) throw std::invalid_argument("PackedArray> Width must be <= 64.");
+                    // NOTE: One extra word avoids bounds checks when a value straddles the last word.
+                    this->words.assign(((this->length * width + 63ZU) >> 6) + 1ZU, 0ULL);
+                    for (std::size_t i = 0; i < this->length; ++i) {
+                        const std::size_t p = i * width, w = p >> 6, o = p & 63ZU;
+                        this->words[w] |= (values[i] & this->mask) << o;
+                        if (o + width > 64ZU) {
+                            this->words[w + 1] |= (values[i] & this->mask) >> (64ZU - o);
+                        }
+                    }
+                }
+
+                inline std::uint64_t operator[](const std::size_t i) const {
+                    const std::size_t p = i * this->width, w = p >> 6, o = p & 63ZU;
+                    std::uint64_t v = this->words[w] >> o;
+                    if (o + this->width > 64ZU) {
+                        v |= this->words[w + 1] << (64ZU - o);
+                    }
+                    return v & this->mask;
+                }
+
+                /**
+                 * @brief Returns the first position in [first,last) whose value is not less than `value`, or `last` if there is none. Values in the range must be sorted.
+                 */
+                std::size_t lower_bound(std::size_t first, std::size_t last, const std::uint64_t value) const {
+                    std::size_t count = last - first;
+                    while (count > 0) {
+                        const std::size_t step = count >> 1;
+                        if ((*this)[first + step] < value) {
+                            first += step + 1;
+                            count -= step + 1;
+                        } else {
+                            count = step;
+                        }
+                    }
+                    return first;
+                }
+
+                std::size_t size() const {
+                    return this->length;
+                }
+
+                std::uint8_t get_width() const {
+                    return this->width;
+                }
+
+                std::size_t size_in_bytes() const {
+                    return this->words.size() * sizeof(std::uint64_t);
+                }
+            };
+
+            /**
+             * @brief Elias-Fano representation of a non-decreasing sequence of unsigned integers.
+             * @note Each value is split into `l` low bits, stored in a `PackedArray`, and a high part, stored in unary within the `high` bitmap. Positions of every `SAMPLE_RATE`-th one in `high` are sampled to speed up select.
+             */
+            class EliasFano {
+            private:
+                static constexpr std::size_t SAMPLE_RATE = 64ZU;
+
+                std::vector<std::uint64_t> high;
+                PackedArray low;
+                std::vector<std::uint64_t> samples;
+                std::size_t length;
+                std::uint8_t l;
+
+                /**
+                 * @brief Returns the position of the i-th one (0-based) in the `high` bitmap.
+                 */
+                inline std::size_t _select_(std::size_t i) const {
+                    std::size_t p = this->samples[i / SAMPLE_RATE];
+                    std::size_t r = i % SAMPLE_RATE;
+                    std::size_t w = p >> 6;
+                    std::uint64_t x = this->high[w] & (~0ULL << (p & 63ZU));
+                    std::size_t c = std::popcount(x);
+                    while (c <= r) {
+                        r -= c;
+                        x = this->high[++w];
+                        c = std::popcount(x);
+                    }
+                    for (; r > 0; --r) {
+                        x &= x - 1ULL;
+                    }
+                    return (w << 6) + std::countr_zero(x);
+                }
+
+                /**
+                 * @brief Returns the position of the first one after position p in the `high` bitmap.
+                 */
+                inline std::size_t _next_one_(const std::size_t p) const {
+                    std::size_t w = (p + 1ZU) >> 6;
+                    std::uint64_t x = ((p + 1ZU) & 63ZU) ? (this->high[w] & (~0ULL << ((p + 1ZU) & 63ZU))) : this->high[w];
+                    while (x == 0ULL) {
+                        x = this->high[++w];
+                    }
+                    return (w << 6) + std::countr_zero(x);
+                }
+
+            public:
+                EliasFano() : length(0), l(0) {}
+
+                EliasFano(std::span<const std::uint64_t> values) : length(values.size()), l(0) {
+                    const std::uint64_t U = values.empty() ? 0ULL : values.back() + 1ULL;
+                    if (this->length > 0 && U > this->length) {
+                        this->l = static_cast<std::uint8_t>(std::bit_width(U / this->length) - 1);
+                    }
+                    std::vector<std::uint64_t> lows(this->length);
+                    this->high.assign(((this->length + (U >> this->l) + 1ZU + 63ZU) >> 6) + 1ZU, 0ULL);
+                    for (std::size_t i = 0; i < this->length; ++i) {
+                        if (i > 0 && values[i] < values[i - 1]) throw std::invalid_argument("EliasFano> Values must be non-decreasing.");
+                        const std::size_t p = (values[i] >> this->l) + i;
+                        this->high[p >> 6] |= 1ULL << (p & 63ZU);
+                        if (i % SAMPLE_RATE == 0) {
+                            this->samples.push_back(p);
+                        }
+                        lows[i] = values[i];
+                    }
+                    this->low = PackedArray(lows, this->l);
+                }
+
+                inline std::uint64_t operator[](const std::size_t i) const {
+                    return (static_cast<std::uint64_t>(this->_select_(i) - i) << this->l) | this->low[i];
+                }
+
+                /**
+                 * @brief Retrieves the i-th and (i+1)-th values with a single select.
+                 */
+                inline void get_pair(const std::size_t i, std::uint64_t& a, std::uint64_t& b) const {
+                    const std::size_t p = this->_select_(i);
+                    const std::size_t q = this->_next_one_(p);
+                    a = (static_cast<std::uint64_t>(p - i) << this->l) | this->low[i];
+                    b = (static_cast<std::uint64_t>(q - i - 1ZU) << this->l) | this->low[i + 1ZU];
+                }
+
+                std::size_t size() const {
+                    return this->length;
+                }
+
+                std::size_t size_in_bytes() const {
+                    return this->high.size() * sizeof(std::uint64_t) + this->low.size_in_bytes() + this->samples.size() * sizeof(std::uint64_t);
+                }
+            };
+
+            /**
+             * @brief A read-only compact version of `CSMR`. It bit-packs every `ind[d]` to the bit width implied by the maximum coordinate value and encodes every `ptr[d]` with Elias-Fano.
+             * @note It keeps the `contains()` and DFS iterator interface of `CSMR`.
+             */
+            class CompactCSMR {
+            private:
+                std::size_t num_dims;
+                std::uint64_t max_coord_val;
+                std::vector<PackedArray> ind;
+                std::vector<EliasFano> ptr;
+
+                // Traversal State variables for the iterator (DFS mimicking)
+                std::vector<std::size_t> I;
+                std::vector<std::size_t> J;
+                std::vector<std::uint64_t> current_coord;
+                std::size_t d;
+                std::vector<std::uint64_t> _next_result;
+                bool _has_next;
+
+                /**
+                 * @brief Proactively traverses the tree to find the next valid leaf.
+                 */
+                void advance() {
+                    while (true) {
+                        if (I[d] < J[d]) {
+                            current_coord[d] = ind[d][I[d]];
+
+                            if (d == num_dims - 1) {
+                                // LEAF NODE: Cache the result and pause traversal
+                                _next_result = current_coord;
+                                I[d]++; 
+                                _has_next = true;
+                                return; 
+                            } else {
+                                // INTERNAL NODE: Branch down
+                                std::uint64_t a, b;
+                                ptr[d].get_pair(I[d], a, b);
+                                I[d + 1] = a;
+                                J[d + 1] = b;
+                                d++;
+                            }
+                        } else {
+                            // EXHAUSTION: Backtrack
+                            if (d == 0) {
+                                _has_next = false;
+                                return; 
+                            }
+                            d--;
+                            I[d]++;
+                        }
+                    }
+                }
+
+            public:
+                /**
+                 * @brief Builds a compact copy of `csmr`, sealing it if needed.
+                 */
+                CompactCSMR(CSMR& csmr) : 
+                    num_dims(csmr.num_dims), 
+                    max_coord_val(csmr.max_coord_val),
+                    I(csmr.num_dims, 0),
+                    J(csmr.num_dims, 0),
+                    current_coord(csmr.num_dims, 0),
+                    d(0),
+                    _has_next(false)
+                {
+                    csmr.seal();
+                    const std::uint8_t width = static_cast<std::uint8_t>(std::bit_width(this->max_coord_val));
+                    for (std::size_t k = 0; k < num_dims; ++k) {
+                        ind.emplace_back(csmr.ind_view[k], width);
+                    }
+                    for (std::size_t k = 0; k + 1 < num_dims; ++k) {
+                        ptr.emplace_back(csmr.ptr_view[k]);
+                    }
+                }
+
+                /**
+                 * @brief Constructor for bulk loading
+                 * @param n Number of dimensions
+                 * @param coords Vector of n-dimensional coordinates (must be lexicographically sorted)
+                 */
+                CompactCSMR(std::size_t n, const std::vector<std::vector<std::uint64_t>>& coords) : CompactCSMR(*std::make_unique<CSMR>(n, coords)) {}
+
+                /**
+                 * @brief Checks if a specific coordinate exists in the structure.
+                 */
+                bool contains(const std::vector<std::uint64_t>& coord) const {
+                    if (coord.size() != num_dims) return false;
+
+                    std::size_t start_idx = 0;
+                    std::size_t end_idx = ind[0].size();
+
+                    for (std::size_t d = 0; d < num_dims; ++d) {
+                        const std::size_t current_idx = ind[d].lower_bound(start_idx, end_idx, coord[d]);
+                        if (current_idx == end_idx || ind[d][current_idx] != coord[d]) {
+                            return false;
+                        }
+                        if (d < num_dims - 1) {
+                            std::uint64_t a, b;
+                            ptr[d].get_pair(current_idx, a, b);
+                            start_idx = a;
+                            end_idx = b;
+                        }
+                    }
+                    return true;
+                }
+
+                /**
+                 * @brief Returns the number of dimensions of the space.
+                 */
+                const std::size_t get_number_of_dimensions() const {
+                    return num_dims;
+                }
+
+                /**
+                 * @brief Returns the number of nodes, calculated as the max coordinate value + 1.
+                 */
+                const std::uint64_t get_number_of_nodes() const {
+                    return max_coord_val + 1;
+                }
+
+                /**
+                 * @brief Returns the total number of edges (unique coordinates) stored.
+                 */
+                const std::uint64_t get_number_of_edges() const {
+                    return ind.back().size();
+                }
+
+                /**
+                 * @brief Returns the number of bytes used by `ind` and `ptr` arrays.
+                 */
+                const std::size_t size_in_bytes() const {
+                    std::size_t bytes = 0;
+                    for (const auto& a : ind) bytes += a.size_in_bytes();
+                    for (const auto& a : ptr) bytes += a.size_in_bytes();
+                    return bytes;
+                }
+
+                /**
+                 * @brief Prepares the CompactCSMR for a sequential iterator traversal.
+                 */
+                void restart() {
+                    if (ind[0].size() == 0) {
+                        _has_next = false;
+                        return;
+                    }
+                    std::fill(I.begin(), I.end(), 0);
+                    std::fill(J.begin(), J.end(), 0);
+                    std::fill(current_coord.begin(), current_coord.end(), 0);
+                    d = 0;
+                    J[0] = ind[0].size();
+                    advance(); 
+                }
+
+                bool has_next() const {
+                    return _has_next;
+                }
+
+                std::vector<std::uint64_t> next() {
+                    if (!_has_next) throw std::out_of_range("No more coordinates available.");
+                    std::vector<std::uint64_t> result = std::move(_next_result);
+                    advance(); 
+                    return result;
+                }
+
                 /**
                  * @brief Exhausts the structure to retrieve all coordinates.
                  */
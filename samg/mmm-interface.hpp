@@ -59,6 +59,7 @@ namespace samg {
                     Reader(const std::string input_file_name):
                         input_file_name(input_file_name)
                     {}
+                    virtual ~Reader() = default;
                     std::string get_input_file_name(){
                         return this->input_file_name;
                     }
@@ -114,6 +115,7 @@ namespace samg {
                         c(c),
                         cderr(cderr)
                     {}
+                    virtual ~Writer() = default;
                     const std::string get_output_file_name() const {
                         return this->output_file_name;
                     }